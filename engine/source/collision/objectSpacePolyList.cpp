@@ -0,0 +1,183 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#include "math/mMath.h"
+#include "console/console.h"
+#include "collision/objectSpacePolyList.h"
+
+
+//----------------------------------------------------------------------------
+
+ObjectSpacePolyList::ObjectSpacePolyList()
+{
+    VECTOR_SET_ASSOCIATION(mPointList);
+    VECTOR_SET_ASSOCIATION(mPlaneList);
+    VECTOR_SET_ASSOCIATION(mPolyList);
+    VECTOR_SET_ASSOCIATION(mIndexList);
+    VECTOR_SET_ASSOCIATION(mGroupList);
+    VECTOR_SET_ASSOCIATION(mReplayMap);
+}
+
+ObjectSpacePolyList::~ObjectSpacePolyList()
+{
+
+}
+
+
+//----------------------------------------------------------------------------
+
+void ObjectSpacePolyList::clear()
+{
+    mPointList.clear();
+    mPlaneList.clear();
+    mPolyList.clear();
+    mIndexList.clear();
+    mGroupList.clear();
+}
+
+bool ObjectSpacePolyList::isEmpty() const
+{
+    return mPolyList.empty();
+}
+
+
+//----------------------------------------------------------------------------
+
+void ObjectSpacePolyList::beginGroup(U32 key)
+{
+    mGroupList.increment();
+    mGroupList.last().key = key;
+    mGroupList.last().polyStart = mPolyList.size();
+}
+
+U32 ObjectSpacePolyList::addPoint(const Point3F& p)
+{
+    mPointList.push_back(p);
+    return mPointList.size() - 1;
+}
+
+U32 ObjectSpacePolyList::addPlane(const PlaneF& plane)
+{
+    mPlaneList.push_back(plane);
+    return mPlaneList.size() - 1;
+}
+
+void ObjectSpacePolyList::begin(U32 material, U32 surfaceKey)
+{
+    mPolyList.increment();
+    Poly& poly = mPolyList.last();
+    poly.material = material;
+    poly.surfaceKey = surfaceKey;
+    poly.vertexStart = mIndexList.size();
+    poly.vertexCount = 0;
+    poly.planeType = PlaneFromPlane;
+    poly.plane.set(0, 0, 0);
+    poly.plane.d = 0;
+}
+
+void ObjectSpacePolyList::plane(U32 v1, U32 v2, U32 v3)
+{
+    Poly& poly = mPolyList.last();
+    poly.planeType = PlaneFromVerts;
+    poly.planeVerts[0] = v1;
+    poly.planeVerts[1] = v2;
+    poly.planeVerts[2] = v3;
+}
+
+void ObjectSpacePolyList::plane(const PlaneF& p)
+{
+    Poly& poly = mPolyList.last();
+    poly.planeType = PlaneFromPlane;
+    poly.plane = p;
+}
+
+void ObjectSpacePolyList::plane(const U32 index)
+{
+    AssertFatal(index < mPlaneList.size(), "Out of bounds index!");
+    Poly& poly = mPolyList.last();
+    poly.planeType = PlaneFromIndex;
+    poly.plane = mPlaneList[index];
+}
+
+const PlaneF& ObjectSpacePolyList::getIndexedPlane(const U32 index)
+{
+    AssertFatal(index < mPlaneList.size(), "Out of bounds index!");
+    return mPlaneList[index];
+}
+
+void ObjectSpacePolyList::vertex(U32 vi)
+{
+    mIndexList.push_back(vi);
+}
+
+void ObjectSpacePolyList::end()
+{
+    Poly& poly = mPolyList.last();
+    poly.vertexCount = mIndexList.size() - poly.vertexStart;
+}
+
+
+//----------------------------------------------------------------------------
+
+void ObjectSpacePolyList::replayGroup(AbstractPolyList* list, U32 group)
+{
+    AssertFatal(group < mGroupList.size(), "Out of bounds group!");
+    U32 start = mGroupList[group].polyStart;
+    U32 end = group + 1 < mGroupList.size() ? mGroupList[group + 1].polyStart : mPolyList.size();
+
+    if (mReplayMap.size() != mPointList.size())
+    {
+        mReplayMap.setSize(mPointList.size());
+        for (U32 i = 0; i < mReplayMap.size(); i++)
+            mReplayMap[i] = U32_MAX;
+    }
+
+    for (U32 i = start; i < end; i++)
+    {
+        const Poly& poly = mPolyList[i];
+
+        list->begin(poly.material, poly.surfaceKey);
+        for (U32 j = 0; j < poly.vertexCount; j++)
+        {
+            U32 vi = mIndexList[poly.vertexStart + j];
+            if (mReplayMap[vi] == U32_MAX)
+                mReplayMap[vi] = list->addPoint(mPointList[vi]);
+            list->vertex(mReplayMap[vi]);
+        }
+
+        switch (poly.planeType)
+        {
+        case PlaneFromVerts:
+            for (U32 j = 0; j < 3; j++)
+            {
+                U32 vi = poly.planeVerts[j];
+                if (mReplayMap[vi] == U32_MAX)
+                    mReplayMap[vi] = list->addPoint(mPointList[vi]);
+            }
+            list->plane(mReplayMap[poly.planeVerts[0]], mReplayMap[poly.planeVerts[1]], mReplayMap[poly.planeVerts[2]]);
+            break;
+        case PlaneFromIndex:
+            list->plane(list->addPlane(poly.plane));
+            break;
+        default:
+            list->plane(poly.plane);
+            break;
+        }
+        list->end();
+    }
+
+    // Put the mapping back the way it was, touching only what we used.
+    for (U32 i = start; i < end; i++)
+    {
+        const Poly& poly = mPolyList[i];
+        for (U32 j = 0; j < poly.vertexCount; j++)
+            mReplayMap[mIndexList[poly.vertexStart + j]] = U32_MAX;
+        if (poly.planeType == PlaneFromVerts)
+        {
+            for (U32 j = 0; j < 3; j++)
+                mReplayMap[poly.planeVerts[j]] = U32_MAX;
+        }
+    }
+}
@@ -0,0 +1,99 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#ifndef _OBJECTSPACEPOLYLIST_H_
+#define _OBJECTSPACEPOLYLIST_H_
+
+#ifndef _ABSTRACTPOLYLIST_H_
+#include "collision/abstractPolyList.h"
+#endif
+
+/// Records polys in the object space of whatever emits them.
+///
+/// The transform and scale an object sets on the list are ignored while
+/// recording.  This lets rigid geometry (interiors, moving platforms) be
+/// extracted once over a large region and re-transformed on later queries
+/// instead of walking the BSP again.
+///
+/// A query over a smaller box would have emitted fewer polys, so the polys
+/// are recorded in groups (an interior's convex hulls, say).  The caller
+/// redoes the object's own selection and replays just the groups a direct
+/// query would have emitted with replayGroup(), which makes the same calls
+/// on the destination list, in the same order, the object made while
+/// recording.
+///
+/// @see AbstractPolyList
+class ObjectSpacePolyList : public AbstractPolyList
+{
+public:
+    enum PlaneType
+    {
+        PlaneFromVerts,
+        PlaneFromPlane,
+        PlaneFromIndex,
+    };
+
+    struct Poly
+    {
+        U32 material;
+        U32 surfaceKey;
+        U32 vertexStart;
+        U32 vertexCount;
+        U32 planeType;
+        U32 planeVerts[3];
+        PlaneF plane;
+    };
+
+    struct Group
+    {
+        U32 key;
+        U32 polyStart;
+    };
+
+    typedef Vector<Point3F> PointList;
+    typedef Vector<PlaneF>  PlaneList;
+    typedef Vector<Poly>    PolyList;
+    typedef Vector<U32>     IndexList;
+    typedef Vector<Group>   GroupList;
+
+    PointList mPointList;
+    PlaneList mPlaneList;
+    PolyList  mPolyList;
+    IndexList mIndexList;
+    GroupList mGroupList;
+
+private:
+    /// Scratch mapping from recorded point index to destination index.
+    /// Entries are U32_MAX between replays.
+    Vector<U32> mReplayMap;
+
+public:
+    ObjectSpacePolyList();
+    ~ObjectSpacePolyList();
+    void clear();
+
+    /// Polys recorded after this call belong to a new group with the key.
+    void beginGroup(U32 key);
+
+    /// Emits every poly of the group into list.  The caller is expected to
+    /// have set up list's transform and object already.
+    void replayGroup(AbstractPolyList* list, U32 group);
+
+    // Virtual methods
+    bool isEmpty() const;
+    U32  addPoint(const Point3F& p);
+    U32  addPlane(const PlaneF& plane);
+    void begin(U32 material, U32 surfaceKey);
+    void plane(U32 v1, U32 v2, U32 v3);
+    void plane(const PlaneF& p);
+    void plane(const U32 index);
+    void vertex(U32 vi);
+    void end();
+
+protected:
+    const PlaneF& getIndexedPlane(const U32 index);
+};
+
+#endif // _OBJECTSPACEPOLYLIST_H_
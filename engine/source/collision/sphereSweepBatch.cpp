@@ -0,0 +1,350 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#include "math/mMath.h"
+#include "platform/profiler.h"
+#include "collision/sphereSweepBatch.h"
+
+#ifdef TORQUE_SWEEP_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef TORQUE_SWEEP_AVX
+#include <immintrin.h>
+#endif
+
+const F64 SphereSweepBatch::csMinApproach = -0.001;
+bool SphereSweepBatch::smUseSIMD = true;
+
+//----------------------------------------------------------------------------
+
+SphereSweepBatch::SphereSweepBatch()
+{
+    VECTOR_SET_ASSOCIATION(mNormalX);
+    VECTOR_SET_ASSOCIATION(mNormalY);
+    VECTOR_SET_ASSOCIATION(mNormalZ);
+    VECTOR_SET_ASSOCIATION(mDist);
+    VECTOR_SET_ASSOCIATION(mEdgeStart);
+    VECTOR_SET_ASSOCIATION(mEdgeCount);
+    VECTOR_SET_ASSOCIATION(mEdgeX);
+    VECTOR_SET_ASSOCIATION(mEdgeY);
+    VECTOR_SET_ASSOCIATION(mEdgeZ);
+    VECTOR_SET_ASSOCIATION(mEdgeD);
+    VECTOR_SET_ASSOCIATION(mCollisionTime);
+    VECTOR_SET_ASSOCIATION(mApproaching);
+    VECTOR_SET_ASSOCIATION(mCandidate);
+
+    mNumPolys = 0;
+    mRadius = 0;
+}
+
+void SphereSweepBatch::build(const ConcretePolyList& list)
+{
+    PROFILE_START(SphereSweepBatch_build);
+
+    mNumPolys = list.mPolyList.size();
+    U32 padded = (mNumPolys + 3) & ~3;
+
+    mNormalX.setSize(padded);
+    mNormalY.setSize(padded);
+    mNormalZ.setSize(padded);
+    mDist.setSize(padded);
+    mEdgeStart.setSize(mNumPolys);
+    mEdgeCount.setSize(mNumPolys);
+    mCollisionTime.setSize(padded);
+    mApproaching.setSize(padded);
+    mCandidate.setSize(padded);
+
+    mEdgeX.clear();
+    mEdgeY.clear();
+    mEdgeZ.clear();
+    mEdgeD.clear();
+
+    for (U32 i = 0; i < mNumPolys; i++)
+    {
+        const ConcretePolyList::Poly& poly = list.mPolyList[i];
+        PlaneD polyPlane = poly.plane;
+
+        mNormalX[i] = polyPlane.x;
+        mNormalY[i] = polyPlane.y;
+        mNormalZ[i] = polyPlane.z;
+        mDist[i] = polyPlane.d;
+
+        mEdgeStart[i] = mEdgeX.size();
+
+        if (poly.vertexCount)
+        {
+            // Consecutive duplicate verts don't make an edge.
+            Point3F lastVert = list.mVertexList[list.mIndexList[poly.vertexStart + poly.vertexCount - 1]];
+            for (U32 j = 0; j < poly.vertexCount; j++)
+            {
+                Point3F thisVert = list.mVertexList[list.mIndexList[poly.vertexStart + j]];
+                if (thisVert != lastVert)
+                {
+                    PlaneD edgePlane(thisVert + polyPlane, thisVert, lastVert);
+                    lastVert = thisVert;
+
+                    mEdgeX.push_back(edgePlane.x);
+                    mEdgeY.push_back(edgePlane.y);
+                    mEdgeZ.push_back(edgePlane.z);
+                    mEdgeD.push_back(edgePlane.d);
+                }
+            }
+        }
+
+        mEdgeCount[i] = mEdgeX.size() - mEdgeStart[i];
+    }
+
+    for (U32 i = mNumPolys; i < padded; i++)
+    {
+        mNormalX[i] = 0;
+        mNormalY[i] = 0;
+        mNormalZ[i] = 0;
+        mDist[i] = 0;
+        mCollisionTime[i] = 0;
+        mApproaching[i] = 0;
+        mCandidate[i] = 0;
+    }
+
+    PROFILE_END();
+}
+
+//----------------------------------------------------------------------------
+
+void SphereSweepBatch::setSweep(const Point3D& velocityDir, const Point3D& velocity, const Point3D& position, F64 radius)
+{
+    mVelocityDir = velocityDir;
+    mVelocity = velocity;
+    mPosition = position;
+    mRadius = radius;
+
+    U32 end = (mNumPolys + 3) & ~3;
+
+#ifdef TORQUE_SWEEP_AVX
+    if (smUseSIMD)
+    {
+        setSweepAVX(0, end);
+        return;
+    }
+#endif
+#ifdef TORQUE_SWEEP_SSE2
+    if (smUseSIMD)
+    {
+        setSweepSSE2(0, end);
+        return;
+    }
+#endif
+    setSweepC(0, end);
+}
+
+void SphereSweepBatch::cullPlanes(U32 start, const Point3D& finalPosition)
+{
+    // Keep the SIMD loops on four poly boundaries.  Redoing a few polys before
+    // start is harmless; the caller is already past them.
+    start &= ~3;
+    U32 end = (mNumPolys + 3) & ~3;
+
+#ifdef TORQUE_SWEEP_AVX
+    if (smUseSIMD)
+    {
+        cullPlanesAVX(start, end, finalPosition);
+        return;
+    }
+#endif
+#ifdef TORQUE_SWEEP_SSE2
+    if (smUseSIMD)
+    {
+        cullPlanesSSE2(start, end, finalPosition);
+        return;
+    }
+#endif
+    cullPlanesC(start, end, finalPosition);
+}
+
+bool SphereSweepBatch::isOutsideEdges(U32 poly, const Point3D& point) const
+{
+    U32 i = mEdgeStart[poly];
+    U32 end = i + mEdgeCount[poly];
+
+#ifdef TORQUE_SWEEP_SSE2
+    if (smUseSIMD)
+    {
+        __m128d px = _mm_set1_pd(point.x);
+        __m128d py = _mm_set1_pd(point.y);
+        __m128d pz = _mm_set1_pd(point.z);
+        __m128d zero = _mm_setzero_pd();
+
+        for (; i + 2 <= end; i += 2)
+        {
+            __m128d dist = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(&mEdgeX[i]), px), _mm_mul_pd(_mm_loadu_pd(&mEdgeY[i]), py));
+            dist = _mm_add_pd(dist, _mm_mul_pd(_mm_loadu_pd(&mEdgeZ[i]), pz));
+            dist = _mm_add_pd(dist, _mm_loadu_pd(&mEdgeD[i]));
+            if (_mm_movemask_pd(_mm_cmplt_pd(dist, zero)))
+                return true;
+        }
+    }
+#endif
+
+    for (; i < end; i++)
+    {
+        if (mEdgeX[i] * point.x + mEdgeY[i] * point.y + mEdgeZ[i] * point.z + mEdgeD[i] < 0.0)
+            return true;
+    }
+    return false;
+}
+
+//----------------------------------------------------------------------------
+// Scalar kernels.  These are the reference the SIMD kernels have to match.
+
+void SphereSweepBatch::setSweepC(U32 start, U32 end)
+{
+    for (U32 i = start; i < end; i++)
+    {
+        F64 approach = mNormalX[i] * mVelocityDir.x + mNormalY[i] * mVelocityDir.y + mNormalZ[i] * mVelocityDir.z;
+        mApproaching[i] = !(approach > csMinApproach);
+        if (!mApproaching[i])
+            continue;
+
+        F64 dist = mNormalX[i] * mPosition.x + mNormalY[i] * mPosition.y + mNormalZ[i] * mPosition.z + mDist[i];
+        F64 speed = mNormalX[i] * mVelocity.x + mNormalY[i] * mVelocity.y + mNormalZ[i] * mVelocity.z;
+        mCollisionTime[i] = (mRadius - dist) / speed;
+    }
+}
+
+void SphereSweepBatch::cullPlanesC(U32 start, U32 end, const Point3D& finalPosition)
+{
+    for (U32 i = start; i < end; i++)
+    {
+        F64 dist = mNormalX[i] * finalPosition.x + mNormalY[i] * finalPosition.y + mNormalZ[i] * finalPosition.z + mDist[i];
+        mCandidate[i] = mApproaching[i] && !(dist > mRadius);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+#ifdef TORQUE_SWEEP_SSE2
+
+void SphereSweepBatch::setSweepSSE2(U32 start, U32 end)
+{
+    __m128d vdx = _mm_set1_pd(mVelocityDir.x);
+    __m128d vdy = _mm_set1_pd(mVelocityDir.y);
+    __m128d vdz = _mm_set1_pd(mVelocityDir.z);
+    __m128d vx = _mm_set1_pd(mVelocity.x);
+    __m128d vy = _mm_set1_pd(mVelocity.y);
+    __m128d vz = _mm_set1_pd(mVelocity.z);
+    __m128d px = _mm_set1_pd(mPosition.x);
+    __m128d py = _mm_set1_pd(mPosition.y);
+    __m128d pz = _mm_set1_pd(mPosition.z);
+    __m128d radius = _mm_set1_pd(mRadius);
+    __m128d minApproach = _mm_set1_pd(csMinApproach);
+    __m128d one = _mm_set1_pd(1.0);
+
+    for (U32 i = start; i < end; i += 2)
+    {
+        __m128d nx = _mm_loadu_pd(&mNormalX[i]);
+        __m128d ny = _mm_loadu_pd(&mNormalY[i]);
+        __m128d nz = _mm_loadu_pd(&mNormalZ[i]);
+
+        __m128d approach = _mm_add_pd(_mm_add_pd(_mm_mul_pd(nx, vdx), _mm_mul_pd(ny, vdy)), _mm_mul_pd(nz, vdz));
+        __m128d approaching = _mm_cmpngt_pd(approach, minApproach);
+        S32 mask = _mm_movemask_pd(approaching);
+        mApproaching[i] = mask & 1;
+        mApproaching[i + 1] = (mask >> 1) & 1;
+        if (!mask)
+            continue;
+
+        __m128d dist = _mm_add_pd(_mm_add_pd(_mm_mul_pd(nx, px), _mm_mul_pd(ny, py)), _mm_mul_pd(nz, pz));
+        dist = _mm_add_pd(dist, _mm_loadu_pd(&mDist[i]));
+        __m128d speed = _mm_add_pd(_mm_add_pd(_mm_mul_pd(nx, vx), _mm_mul_pd(ny, vy)), _mm_mul_pd(nz, vz));
+
+        // Lanes that aren't approaching divide by one, so they can't raise
+        // divide-by-zero; their time is never read.
+        speed = _mm_or_pd(_mm_and_pd(approaching, speed), _mm_andnot_pd(approaching, one));
+        _mm_storeu_pd(&mCollisionTime[i], _mm_div_pd(_mm_sub_pd(radius, dist), speed));
+    }
+}
+
+void SphereSweepBatch::cullPlanesSSE2(U32 start, U32 end, const Point3D& finalPosition)
+{
+    __m128d fx = _mm_set1_pd(finalPosition.x);
+    __m128d fy = _mm_set1_pd(finalPosition.y);
+    __m128d fz = _mm_set1_pd(finalPosition.z);
+    __m128d radius = _mm_set1_pd(mRadius);
+
+    for (U32 i = start; i < end; i += 2)
+    {
+        __m128d dist = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(&mNormalX[i]), fx), _mm_mul_pd(_mm_loadu_pd(&mNormalY[i]), fy));
+        dist = _mm_add_pd(dist, _mm_mul_pd(_mm_loadu_pd(&mNormalZ[i]), fz));
+        dist = _mm_add_pd(dist, _mm_loadu_pd(&mDist[i]));
+
+        S32 mask = _mm_movemask_pd(_mm_cmpngt_pd(dist, radius));
+        mCandidate[i] = mApproaching[i] & mask;
+        mCandidate[i + 1] = mApproaching[i + 1] & (mask >> 1);
+    }
+}
+
+#endif // TORQUE_SWEEP_SSE2
+
+//----------------------------------------------------------------------------
+
+#ifdef TORQUE_SWEEP_AVX
+
+void SphereSweepBatch::setSweepAVX(U32 start, U32 end)
+{
+    __m256d vdx = _mm256_set1_pd(mVelocityDir.x);
+    __m256d vdy = _mm256_set1_pd(mVelocityDir.y);
+    __m256d vdz = _mm256_set1_pd(mVelocityDir.z);
+    __m256d vx = _mm256_set1_pd(mVelocity.x);
+    __m256d vy = _mm256_set1_pd(mVelocity.y);
+    __m256d vz = _mm256_set1_pd(mVelocity.z);
+    __m256d px = _mm256_set1_pd(mPosition.x);
+    __m256d py = _mm256_set1_pd(mPosition.y);
+    __m256d pz = _mm256_set1_pd(mPosition.z);
+    __m256d radius = _mm256_set1_pd(mRadius);
+    __m256d minApproach = _mm256_set1_pd(csMinApproach);
+    __m256d one = _mm256_set1_pd(1.0);
+
+    for (U32 i = start; i < end; i += 4)
+    {
+        __m256d nx = _mm256_loadu_pd(&mNormalX[i]);
+        __m256d ny = _mm256_loadu_pd(&mNormalY[i]);
+        __m256d nz = _mm256_loadu_pd(&mNormalZ[i]);
+
+        __m256d approach = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(nx, vdx), _mm256_mul_pd(ny, vdy)), _mm256_mul_pd(nz, vdz));
+        __m256d approaching = _mm256_cmp_pd(approach, minApproach, _CMP_NGT_UQ);
+        S32 mask = _mm256_movemask_pd(approaching);
+        for (U32 j = 0; j < 4; j++)
+            mApproaching[i + j] = (mask >> j) & 1;
+        if (!mask)
+            continue;
+
+        __m256d dist = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(nx, px), _mm256_mul_pd(ny, py)), _mm256_mul_pd(nz, pz));
+        dist = _mm256_add_pd(dist, _mm256_loadu_pd(&mDist[i]));
+        __m256d speed = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(nx, vx), _mm256_mul_pd(ny, vy)), _mm256_mul_pd(nz, vz));
+
+        speed = _mm256_blendv_pd(one, speed, approaching);
+        _mm256_storeu_pd(&mCollisionTime[i], _mm256_div_pd(_mm256_sub_pd(radius, dist), speed));
+    }
+}
+
+void SphereSweepBatch::cullPlanesAVX(U32 start, U32 end, const Point3D& finalPosition)
+{
+    __m256d fx = _mm256_set1_pd(finalPosition.x);
+    __m256d fy = _mm256_set1_pd(finalPosition.y);
+    __m256d fz = _mm256_set1_pd(finalPosition.z);
+    __m256d radius = _mm256_set1_pd(mRadius);
+
+    for (U32 i = start; i < end; i += 4)
+    {
+        __m256d dist = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(&mNormalX[i]), fx), _mm256_mul_pd(_mm256_loadu_pd(&mNormalY[i]), fy));
+        dist = _mm256_add_pd(dist, _mm256_mul_pd(_mm256_loadu_pd(&mNormalZ[i]), fz));
+        dist = _mm256_add_pd(dist, _mm256_loadu_pd(&mDist[i]));
+
+        S32 mask = _mm256_movemask_pd(_mm256_cmp_pd(dist, radius, _CMP_NGT_UQ));
+        for (U32 j = 0; j < 4; j++)
+            mCandidate[i + j] = mApproaching[i + j] & (mask >> j);
+    }
+}
+
+#endif // TORQUE_SWEEP_AVX
@@ -0,0 +1,117 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#ifndef _SPHERESWEEPBATCH_H_
+#define _SPHERESWEEPBATCH_H_
+
+#ifndef _CONCRETEPOLYLIST_H_
+#include "collision/concretePolyList.h"
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TORQUE_SWEEP_SSE2
+#endif
+#if defined(__AVX__)
+#define TORQUE_SWEEP_AVX
+#endif
+
+/// Structure-of-arrays copy of a ConcretePolyList for sweeping a sphere
+/// against every poly in it.
+///
+/// build() converts the poly planes to F64 and precomputes the inward facing
+/// edge planes once per gather.  setSweep() and cullPlanes() then run the
+/// per-poly plane distance and time of impact tests several polys at a time
+/// (SSE2 two, AVX four) instead of one poly at a time.
+///
+/// Every lane does exactly the F64 multiplies, adds and compares the scalar
+/// path does, in the same order, so the SIMD and scalar paths produce
+/// bit-identical results.  That holds as long as the compiler isn't allowed
+/// to contract the scalar code into fused multiply-adds.
+///
+/// @see Marble::testMove
+class SphereSweepBatch
+{
+    /// @name Poly planes
+    /// Padded with zero planes to a multiple of four, which are never
+    /// approaching and so never become candidates.
+    /// @{
+    Vector<F64> mNormalX;
+    Vector<F64> mNormalY;
+    Vector<F64> mNormalZ;
+    Vector<F64> mDist;
+    /// @}
+
+    /// @name Edge planes
+    /// Each poly's edges are stored contiguously, starting at mEdgeStart.
+    /// @{
+    Vector<U32> mEdgeStart;
+    Vector<U32> mEdgeCount;
+    Vector<F64> mEdgeX;
+    Vector<F64> mEdgeY;
+    Vector<F64> mEdgeZ;
+    Vector<F64> mEdgeD;
+    /// @}
+
+    /// @name Sweep results
+    /// @{
+    Vector<F64> mCollisionTime;
+    Vector<U8>  mApproaching;
+    Vector<U8>  mCandidate;
+    /// @}
+
+    U32 mNumPolys;
+
+    Point3D mVelocityDir;
+    Point3D mVelocity;
+    Point3D mPosition;
+    F64 mRadius;
+
+    void setSweepC(U32 start, U32 end);
+    void cullPlanesC(U32 start, U32 end, const Point3D& finalPosition);
+
+#ifdef TORQUE_SWEEP_SSE2
+    void setSweepSSE2(U32 start, U32 end);
+    void cullPlanesSSE2(U32 start, U32 end, const Point3D& finalPosition);
+#endif
+#ifdef TORQUE_SWEEP_AVX
+    void setSweepAVX(U32 start, U32 end);
+    void cullPlanesAVX(U32 start, U32 end, const Point3D& finalPosition);
+#endif
+
+public:
+    /// Polys moving towards the sphere slower than this (along the plane
+    /// normal, per unit of velocity) are never candidates.
+    static const F64 csMinApproach;
+
+    /// Lets the SIMD kernels be switched off at runtime, for comparing
+    /// against the scalar path.
+    static bool smUseSIMD;
+
+    SphereSweepBatch();
+
+    /// Rebuild from list.  Must be called again whenever list changes.
+    void build(const ConcretePolyList& list);
+
+    U32 getNumPolys() const { return mNumPolys; }
+
+    /// Compute, for every poly, whether the sweep approaches its plane and
+    /// the time at which the sphere would touch it.
+    void setSweep(const Point3D& velocityDir, const Point3D& velocity, const Point3D& position, F64 radius);
+
+    /// Mark approaching polys from start onwards as candidates if the sphere
+    /// at finalPosition gets within mRadius of their plane.  Call this again
+    /// whenever the final position moves.
+    void cullPlanes(U32 start, const Point3D& finalPosition);
+
+    bool isCandidate(U32 poly) const { return mCandidate[poly] != 0; }
+
+    /// Time at which the sphere touches the plane of a candidate poly.
+    F64 getCollisionTime(U32 poly) const { return mCollisionTime[poly]; }
+
+    /// True if point is on the far side of any of the poly's edges.
+    bool isOutsideEdges(U32 poly, const Point3D& point) const;
+};
+
+#endif // _SPHERESWEEPBATCH_H_
@@ -8,6 +8,7 @@
 #include "console/telnetDebugger.h"
 #include "core/resManager.h"
 #include "core/unicode.h"
+#include "core/dataChunker.h"
 
 using namespace Compiler;
 
@@ -33,6 +34,7 @@ CodeBlock::CodeBlock()
     code = NULL;
     name = NULL;
     mRoot = StringTable->insert("");
+    mInlineCacheAllocator = NULL;
 }
 
 CodeBlock::~CodeBlock()
@@ -48,6 +50,7 @@ CodeBlock::~CodeBlock()
     delete[] functionFloats;
     delete[] code;
     delete[] breakList;
+    delete mInlineCacheAllocator;
 }
 
 //-------------------------------------------------------------------------
@@ -141,6 +144,44 @@ bool CodeBlock::setBreakpoint(U32 lineNumber)
     return false;
 }
 
+void* CodeBlock::allocInlineCache(U32 size)
+{
+    if (!mInlineCacheAllocator)
+        mInlineCacheAllocator = new DataChunker(1024);
+
+    void* ret = mInlineCacheAllocator->alloc(size);
+    dMemset(ret, 0, size);
+    return ret;
+}
+
+void CodeBlock::patchInstruction(U32 ip, U32 instruction)
+{
+    // Breakpoints remember the instruction they replaced in lineBreakPairs,
+    // and put it back when cleared, so that has to be patched as well.
+    if (lineBreakPairs && lineBreakPairCount)
+    {
+        U32 min = 0;
+        U32 max = lineBreakPairCount;
+        while (min < max)
+        {
+            U32 mid = (min + max) >> 1;
+            dsize_t* p = lineBreakPairs + mid * 2;
+            if (p[1] < ip)
+                min = mid + 1;
+            else if (p[1] > ip)
+                max = mid;
+            else
+            {
+                p[0] = (p[0] & ~dsize_t(0xFF)) | instruction;
+                break;
+            }
+        }
+    }
+
+    if (code[ip] != OP_BREAK)
+        code[ip] = instruction;
+}
+
 U32 CodeBlock::findFirstBreakLine(U32 lineNumber)
 {
     if (!lineBreakPairs)
@@ -368,28 +409,46 @@ bool CodeBlock::read(StringTableEntry fileName, Stream& st)
 
     lineBreakPairs = code + codeSize;
 
-    // StringTable-ize our identifiers.
+    // StringTable-ize our identifiers.  They all go into the table in one
+    // batch, and the code is patched afterwards.
     U32 identCount;
     st.read(&identCount);
-    while (identCount--)
+
+    Vector<const char*> identStrings;
+    Vector<U32> identRefs;   // Each ident's use count, followed by its ips.
+    identStrings.setSize(identCount);
+    for (i = 0; i < identCount; i++)
     {
         U32 offset;
         st.read(&offset);
-        StringTableEntry ste;
         if (offset < globalSize)
-            ste = StringTable->insert(globalStrings + offset);
+            identStrings[i] = globalStrings + offset;
         else
-            ste = StringTable->insert("");
+            identStrings[i] = "";
         U32 count;
         st.read(&count);
+        identRefs.push_back(count);
         while (count--)
         {
             U32 ip;
             st.read(&ip);
-            code[ip] = *((dsize_t*)&ste);
+            identRefs.push_back(ip);
         }
     }
 
+    Vector<StringTableEntry> identEntries;
+    identEntries.setSize(identCount);
+    StringTable->insertBatch(identStrings.address(), identCount, identEntries.address());
+
+    U32 ref = 0;
+    for (i = 0; i < identCount; i++)
+    {
+        StringTableEntry ste = identEntries[i];
+        U32 count = identRefs[ref++];
+        while (count--)
+            code[identRefs[ref++]] = *((dsize_t*)&ste);
+    }
+
     if (lineBreakPairCount)
         calcBreakList();
 
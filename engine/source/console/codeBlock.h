@@ -10,6 +10,7 @@
 #include "console/consoleParser.h"
 
 class Stream;
+class DataChunker;
 
 /// Core TorqueScript code management class.
 ///
@@ -60,6 +61,15 @@ public:
     CodeBlock* nextFile;
     StringTableEntry mRoot;
 
+    /// Holds the inline caches exec() patches into the code.
+    DataChunker* mInlineCacheAllocator;
+
+    /// Zeroed memory that lives as long as this block, for an inline cache.
+    void* allocInlineCache(U32 size);
+
+    /// Replace the opcode at ip, keeping any breakpoint set on it.
+    void patchInstruction(U32 ip, U32 instruction);
+
 
     void addToCodeList();
     void removeFromCodeList();
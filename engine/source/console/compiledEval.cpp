@@ -27,6 +27,23 @@ enum EvalConstants {
     MaxStackSize = 1024
 };
 
+// Where the compiler supports taking the address of a label, each opcode
+// handler in CodeBlock::exec() jumps straight to the next one through a
+// table instead of going back around the loop to the switch.  Every
+// handler then has its own indirect branch, which the CPU predicts far
+// better than the single one the switch compiles to.
+#if defined(__GNUC__) && !defined(TORQUE_DISABLE_COMPUTED_GOTO)
+#define TORQUE_COMPUTED_GOTO
+#endif
+
+#ifdef TORQUE_COMPUTED_GOTO
+#define EVAL_CASE(op) case op: eval_##op
+#define EVAL_NEXT() goto *sEvalDispatch[instruction = code[ip++]]
+#else
+#define EVAL_CASE(op) case op
+#define EVAL_NEXT() break
+#endif
+
 namespace Con
 {
     // Current script file name and root, these are registered as
@@ -145,6 +162,18 @@ inline void ExprEvalState::setCurVarNameCreate(StringTableEntry name)
     }
 }
 
+inline void ExprEvalState::setCurGlobalVarName(Dictionary::LookupCache& cache)
+{
+    currentVariable = globalVars.lookup(cache);
+    if (!currentVariable && gWarnUndefinedScriptVariables)
+        Con::warnf(ConsoleLogEntry::Script, "Variable referenced before assignment: %s", cache.name);
+}
+
+inline void ExprEvalState::setCurGlobalVarNameCreate(Dictionary::LookupCache& cache)
+{
+    currentVariable = globalVars.add(cache);
+}
+
 //------------------------------------------------------------
 
 inline S32 ExprEvalState::getIntVariable()
@@ -300,12 +329,105 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
     SimObject* saveObject = NULL;
     Namespace::Entry* nsEntry;
     Namespace* ns;
+    Namespace::LookupCache* methodCache;
+    Dictionary::LookupCache* globalVarCache;
+    bool profiled;
 
     U32 callArgc;
     const char** callArgv;
 
     static char curFieldArray[256];
 
+#ifdef TORQUE_COMPUTED_GOTO
+    // Must list every opcode, in the order they are declared in.
+    static const void* const sEvalDispatch[] = {
+        &&eval_OP_FUNC_DECL,
+        &&eval_OP_CREATE_OBJECT,
+        &&eval_OP_ADD_OBJECT,
+        &&eval_OP_END_OBJECT,
+        &&eval_OP_JMPIFFNOT,
+        &&eval_OP_JMPIFNOT,
+        &&eval_OP_JMPIFF,
+        &&eval_OP_JMPIF,
+        &&eval_OP_JMPIFNOT_NP,
+        &&eval_OP_JMPIF_NP,
+        &&eval_OP_JMP,
+        &&eval_OP_RETURN,
+        &&eval_OP_CMPEQ,
+        &&eval_OP_CMPGR,
+        &&eval_OP_CMPGE,
+        &&eval_OP_CMPLT,
+        &&eval_OP_CMPLE,
+        &&eval_OP_CMPNE,
+        &&eval_OP_XOR,
+        &&eval_OP_MOD,
+        &&eval_OP_BITAND,
+        &&eval_OP_BITOR,
+        &&eval_OP_NOT,
+        &&eval_OP_NOTF,
+        &&eval_OP_ONESCOMPLEMENT,
+        &&eval_OP_SHR,
+        &&eval_OP_SHL,
+        &&eval_OP_AND,
+        &&eval_OP_OR,
+        &&eval_OP_ADD,
+        &&eval_OP_SUB,
+        &&eval_OP_MUL,
+        &&eval_OP_DIV,
+        &&eval_OP_NEG,
+        &&eval_OP_SETCURVAR,
+        &&eval_OP_SETCURVAR_CREATE,
+        &&eval_OP_SETCURVAR_ARRAY,
+        &&eval_OP_SETCURVAR_ARRAY_CREATE,
+        &&eval_OP_LOADVAR_UINT,
+        &&eval_OP_LOADVAR_FLT,
+        &&eval_OP_LOADVAR_STR,
+        &&eval_OP_SAVEVAR_UINT,
+        &&eval_OP_SAVEVAR_FLT,
+        &&eval_OP_SAVEVAR_STR,
+        &&eval_OP_SETCUROBJECT,
+        &&eval_OP_SETCUROBJECT_NEW,
+        &&eval_OP_SETCURFIELD,
+        &&eval_OP_SETCURFIELD_ARRAY,
+        &&eval_OP_LOADFIELD_UINT,
+        &&eval_OP_LOADFIELD_FLT,
+        &&eval_OP_LOADFIELD_STR,
+        &&eval_OP_SAVEFIELD_UINT,
+        &&eval_OP_SAVEFIELD_FLT,
+        &&eval_OP_SAVEFIELD_STR,
+        &&eval_OP_STR_TO_UINT,
+        &&eval_OP_STR_TO_FLT,
+        &&eval_OP_STR_TO_NONE,
+        &&eval_OP_FLT_TO_UINT,
+        &&eval_OP_FLT_TO_STR,
+        &&eval_OP_FLT_TO_NONE,
+        &&eval_OP_UINT_TO_FLT,
+        &&eval_OP_UINT_TO_STR,
+        &&eval_OP_UINT_TO_NONE,
+        &&eval_OP_LOADIMMED_UINT,
+        &&eval_OP_LOADIMMED_FLT,
+        &&eval_OP_TAG_TO_STR,
+        &&eval_OP_LOADIMMED_STR,
+        &&eval_OP_LOADIMMED_IDENT,
+        &&eval_OP_CALLFUNC_RESOLVE,
+        &&eval_OP_CALLFUNC,
+        &&eval_OP_ADVANCE_STR,
+        &&eval_OP_ADVANCE_STR_APPENDCHAR,
+        &&eval_OP_ADVANCE_STR_COMMA,
+        &&eval_OP_ADVANCE_STR_NUL,
+        &&eval_OP_REWIND_STR,
+        &&eval_OP_TERMINATE_REWIND_STR,
+        &&eval_OP_COMPARE_STR,
+        &&eval_OP_PUSH,
+        &&eval_OP_PUSH_FRAME,
+        &&eval_OP_BREAK,
+        &&eval_OP_SETCURVAR_GLOBAL,
+        &&eval_OP_SETCURVAR_GLOBAL_CREATE,
+        &&eval_OP_INVALID
+    };
+    static_assert(sizeof(sEvalDispatch) / sizeof(sEvalDispatch[0]) == OP_INVALID + 1, "sEvalDispatch is missing opcodes");
+#endif
+
     CodeBlock* saveCodeBlock = smCurrentCodeBlock;
     smCurrentCodeBlock = this;
     if (this->name)
@@ -320,7 +442,7 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
     breakContinue:
         switch (instruction)
         {
-        case OP_FUNC_DECL:
+        EVAL_CASE(OP_FUNC_DECL):
             if (!noCalls)
             {
                 fnName = U32toSTE(code[ip]);
@@ -336,15 +458,15 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
                 //Con::printf("Adding function %s::%s (%d)", fnNamespace, fnName, ip);
             }
             ip = code[ip + 4];
-            break;
+            EVAL_NEXT();
 
-        case OP_CREATE_OBJECT:
+        EVAL_CASE(OP_CREATE_OBJECT):
         {
             // If we don't allow calls, we certainly don't allow creating objects!
             if (noCalls)
             {
                 ip = failJump;
-                break;
+                EVAL_NEXT();
             }
 
             // Read some useful info.
@@ -374,7 +496,7 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
                 {
                     Con::errorf(ConsoleLogEntry::General, "Cannot re-declare data block %s with a different class.", callArgv[2]);
                     ip = failJump;
-                    break;
+                    EVAL_NEXT();
                 }
 
                 // If there was one, set the currentNewObject and move on.
@@ -408,7 +530,7 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
                 {
                     Con::errorf(ConsoleLogEntry::General, "%s: Unable to instantiate non-conobject class %s.", getFileLine(ip - 1), callArgv[1]);
                     ip = failJump;
-                    break;
+                    EVAL_NEXT();
                 }
 
                 // Do special datablock init if appropros
@@ -427,7 +549,7 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
                         // Clean up...
                         delete object;
                         ip = failJump;
-                        break;
+                        EVAL_NEXT();
                     }
                 }
 
@@ -440,7 +562,7 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
                     Con::errorf(ConsoleLogEntry::General, "%s: Unable to instantiate non-SimObject class %s.", getFileLine(ip - 1), callArgv[1]);
                     delete object;
                     ip = failJump;
-                    break;
+                    EVAL_NEXT();
                 }
 
                 // Does it have a parent object? (ie, the copy constructor : syntax, not inheriance)
@@ -471,7 +593,7 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
                     delete currentNewObject;
                     currentNewObject = NULL;
                     ip = failJump;
-                    break;
+                    EVAL_NEXT();
                 }
 
                 // If it's not a datablock, allow people to modify bits of it.
@@ -484,10 +606,10 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
 
             // Advance the IP past the create info...
             ip += 3;
-            break;
+            EVAL_NEXT();
         }
 
-        case OP_ADD_OBJECT:
+        EVAL_CASE(OP_ADD_OBJECT):
         {
             // Do we place this object at the root?
             bool placeAtRoot = code[ip++];
@@ -501,7 +623,7 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
                 Con::warnf(ConsoleLogEntry::General, "%s: Register object failed for object %s of class %s.", getFileLine(ip - 2), currentNewObject->getName(), currentNewObject->getClassName());
                 delete currentNewObject;
                 ip = failJump;
-                break;
+                EVAL_NEXT();
             }
 
             // Are we dealing with a datablock?
@@ -515,7 +637,7 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
                     currentNewObject->getName(), errorBuffer);
                 dataBlock->deleteObject();
                 ip = failJump;
-                break;
+                EVAL_NEXT();
             }
 
             // What group will we be added to, if any?
@@ -559,350 +681,378 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
             else
                 intStack[++UINT] = currentNewObject->getId();
 
-            break;
+            EVAL_NEXT();
         }
 
-        case OP_END_OBJECT:
+        EVAL_CASE(OP_END_OBJECT):
         {
             // If we're not to be placed at the root, make sure we clean up
             // our group reference.
             bool placeAtRoot = code[ip++];
             if (!placeAtRoot)
                 UINT--;
-            break;
+            EVAL_NEXT();
         }
 
-        case OP_JMPIFFNOT:
+        EVAL_CASE(OP_JMPIFFNOT):
             if (floatStack[FLT--])
             {
                 ip++;
-                break;
+                EVAL_NEXT();
             }
             ip = code[ip];
-            break;
-        case OP_JMPIFNOT:
+            EVAL_NEXT();
+        EVAL_CASE(OP_JMPIFNOT):
             if (intStack[UINT--])
             {
                 ip++;
-                break;
+                EVAL_NEXT();
             }
             ip = code[ip];
-            break;
-        case OP_JMPIFF:
+            EVAL_NEXT();
+        EVAL_CASE(OP_JMPIFF):
             if (!floatStack[FLT--])
             {
                 ip++;
-                break;
+                EVAL_NEXT();
             }
             ip = code[ip];
-            break;
-        case OP_JMPIF:
+            EVAL_NEXT();
+        EVAL_CASE(OP_JMPIF):
             if (!intStack[UINT--])
             {
                 ip++;
-                break;
+                EVAL_NEXT();
             }
             ip = code[ip];
-            break;
-        case OP_JMPIFNOT_NP:
+            EVAL_NEXT();
+        EVAL_CASE(OP_JMPIFNOT_NP):
             if (intStack[UINT])
             {
                 UINT--;
                 ip++;
-                break;
+                EVAL_NEXT();
             }
             ip = code[ip];
-            break;
-        case OP_JMPIF_NP:
+            EVAL_NEXT();
+        EVAL_CASE(OP_JMPIF_NP):
             if (!intStack[UINT])
             {
                 UINT--;
                 ip++;
-                break;
+                EVAL_NEXT();
             }
             ip = code[ip];
-            break;
-        case OP_JMP:
+            EVAL_NEXT();
+        EVAL_CASE(OP_JMP):
             ip = code[ip];
-            break;
-        case OP_RETURN:
+            EVAL_NEXT();
+        EVAL_CASE(OP_RETURN):
             goto execFinished;
-        case OP_CMPEQ:
+        EVAL_CASE(OP_CMPEQ):
             intStack[UINT + 1] = bool(floatStack[FLT] == floatStack[FLT - 1]);
             UINT++;
             FLT -= 2;
-            break;
+            EVAL_NEXT();
 
-        case OP_CMPGR:
+        EVAL_CASE(OP_CMPGR):
             intStack[UINT + 1] = bool(floatStack[FLT] > floatStack[FLT - 1]);
             UINT++;
             FLT -= 2;
-            break;
+            EVAL_NEXT();
 
-        case OP_CMPGE:
+        EVAL_CASE(OP_CMPGE):
             intStack[UINT + 1] = bool(floatStack[FLT] >= floatStack[FLT - 1]);
             UINT++;
             FLT -= 2;
-            break;
+            EVAL_NEXT();
 
-        case OP_CMPLT:
+        EVAL_CASE(OP_CMPLT):
             intStack[UINT + 1] = bool(floatStack[FLT] < floatStack[FLT - 1]);
             UINT++;
             FLT -= 2;
-            break;
+            EVAL_NEXT();
 
-        case OP_CMPLE:
+        EVAL_CASE(OP_CMPLE):
             intStack[UINT + 1] = bool(floatStack[FLT] <= floatStack[FLT - 1]);
             UINT++;
             FLT -= 2;
-            break;
+            EVAL_NEXT();
 
-        case OP_CMPNE:
+        EVAL_CASE(OP_CMPNE):
             intStack[UINT + 1] = bool(floatStack[FLT] != floatStack[FLT - 1]);
             UINT++;
             FLT -= 2;
-            break;
+            EVAL_NEXT();
 
-        case OP_XOR:
+        EVAL_CASE(OP_XOR):
             intStack[UINT - 1] = intStack[UINT] ^ intStack[UINT - 1];
             UINT--;
-            break;
+            EVAL_NEXT();
 
-        case OP_MOD:
+        EVAL_CASE(OP_MOD):
             intStack[UINT - 1] = intStack[UINT] % intStack[UINT - 1];
             UINT--;
-            break;
+            EVAL_NEXT();
 
-        case OP_BITAND:
+        EVAL_CASE(OP_BITAND):
             intStack[UINT - 1] = intStack[UINT] & intStack[UINT - 1];
             UINT--;
-            break;
+            EVAL_NEXT();
 
-        case OP_BITOR:
+        EVAL_CASE(OP_BITOR):
             intStack[UINT - 1] = intStack[UINT] | intStack[UINT - 1];
             UINT--;
-            break;
+            EVAL_NEXT();
 
-        case OP_NOT:
+        EVAL_CASE(OP_NOT):
             intStack[UINT] = !intStack[UINT];
-            break;
+            EVAL_NEXT();
 
-        case OP_NOTF:
+        EVAL_CASE(OP_NOTF):
             intStack[UINT + 1] = !floatStack[FLT];
             FLT--;
             UINT++;
-            break;
+            EVAL_NEXT();
 
-        case OP_ONESCOMPLEMENT:
+        EVAL_CASE(OP_ONESCOMPLEMENT):
             intStack[UINT] = ~intStack[UINT];
-            break;
+            EVAL_NEXT();
 
-        case OP_SHR:
+        EVAL_CASE(OP_SHR):
             intStack[UINT - 1] = intStack[UINT] >> intStack[UINT - 1];
             UINT--;
-            break;
+            EVAL_NEXT();
 
-        case OP_SHL:
+        EVAL_CASE(OP_SHL):
             intStack[UINT - 1] = intStack[UINT] << intStack[UINT - 1];
             UINT--;
-            break;
+            EVAL_NEXT();
 
-        case OP_AND:
+        EVAL_CASE(OP_AND):
             intStack[UINT - 1] = intStack[UINT] && intStack[UINT - 1];
             UINT--;
-            break;
+            EVAL_NEXT();
 
-        case OP_OR:
+        EVAL_CASE(OP_OR):
             intStack[UINT - 1] = intStack[UINT] || intStack[UINT - 1];
             UINT--;
-            break;
+            EVAL_NEXT();
 
-        case OP_ADD:
+        EVAL_CASE(OP_ADD):
             floatStack[FLT - 1] = floatStack[FLT] + floatStack[FLT - 1];
             FLT--;
-            break;
+            EVAL_NEXT();
 
-        case OP_SUB:
+        EVAL_CASE(OP_SUB):
             floatStack[FLT - 1] = floatStack[FLT] - floatStack[FLT - 1];
             FLT--;
-            break;
+            EVAL_NEXT();
 
-        case OP_MUL:
+        EVAL_CASE(OP_MUL):
             floatStack[FLT - 1] = floatStack[FLT] * floatStack[FLT - 1];
             FLT--;
-            break;
-        case OP_DIV:
+            EVAL_NEXT();
+        EVAL_CASE(OP_DIV):
             floatStack[FLT - 1] = floatStack[FLT] / floatStack[FLT - 1];
             FLT--;
-            break;
-        case OP_NEG:
+            EVAL_NEXT();
+        EVAL_CASE(OP_NEG):
             floatStack[FLT] = -floatStack[FLT];
-            break;
+            EVAL_NEXT();
 
-        case OP_SETCURVAR:
+        EVAL_CASE(OP_SETCURVAR):
             var = U32toSTE(code[ip]);
+            if (var[0] == '$')
+            {
+                // Globals live as long as the dictionary lets them, so
+                // swap the name for a cache of the lookup.
+                globalVarCache = (Dictionary::LookupCache*)allocInlineCache(sizeof(Dictionary::LookupCache));
+                globalVarCache->name = var;
+                code[ip] = *((dsize_t*)&globalVarCache);
+                patchInstruction(ip - 1, OP_SETCURVAR_GLOBAL);
+            }
             ip++;
             gEvalState.setCurVarName(var);
-            break;
+            EVAL_NEXT();
 
-        case OP_SETCURVAR_CREATE:
+        EVAL_CASE(OP_SETCURVAR_CREATE):
             var = U32toSTE(code[ip]);
+            if (var[0] == '$')
+            {
+                globalVarCache = (Dictionary::LookupCache*)allocInlineCache(sizeof(Dictionary::LookupCache));
+                globalVarCache->name = var;
+                code[ip] = *((dsize_t*)&globalVarCache);
+                patchInstruction(ip - 1, OP_SETCURVAR_GLOBAL_CREATE);
+            }
             ip++;
             gEvalState.setCurVarNameCreate(var);
-            break;
+            EVAL_NEXT();
+
+        EVAL_CASE(OP_SETCURVAR_GLOBAL):
+            globalVarCache = *((Dictionary::LookupCache**)&code[ip]);
+            ip++;
+            gEvalState.setCurGlobalVarName(*globalVarCache);
+            EVAL_NEXT();
+
+        EVAL_CASE(OP_SETCURVAR_GLOBAL_CREATE):
+            globalVarCache = *((Dictionary::LookupCache**)&code[ip]);
+            ip++;
+            gEvalState.setCurGlobalVarNameCreate(*globalVarCache);
+            EVAL_NEXT();
 
-        case OP_SETCURVAR_ARRAY:
+        EVAL_CASE(OP_SETCURVAR_ARRAY):
             var = STR.getSTValue();
             gEvalState.setCurVarName(var);
-            break;
+            EVAL_NEXT();
 
-        case OP_SETCURVAR_ARRAY_CREATE:
+        EVAL_CASE(OP_SETCURVAR_ARRAY_CREATE):
             var = STR.getSTValue();
             gEvalState.setCurVarNameCreate(var);
-            break;
+            EVAL_NEXT();
 
-        case OP_LOADVAR_UINT:
+        EVAL_CASE(OP_LOADVAR_UINT):
             intStack[UINT + 1] = gEvalState.getIntVariable();
             UINT++;
-            break;
+            EVAL_NEXT();
 
-        case OP_LOADVAR_FLT:
+        EVAL_CASE(OP_LOADVAR_FLT):
             floatStack[FLT + 1] = gEvalState.getFloatVariable();
             FLT++;
-            break;
+            EVAL_NEXT();
 
-        case OP_LOADVAR_STR:
+        EVAL_CASE(OP_LOADVAR_STR):
             val = gEvalState.getStringVariable();
             STR.setStringValue(val);
-            break;
+            EVAL_NEXT();
 
-        case OP_SAVEVAR_UINT:
+        EVAL_CASE(OP_SAVEVAR_UINT):
             gEvalState.setIntVariable(intStack[UINT]);
-            break;
+            EVAL_NEXT();
 
-        case OP_SAVEVAR_FLT:
+        EVAL_CASE(OP_SAVEVAR_FLT):
             gEvalState.setFloatVariable(floatStack[FLT]);
-            break;
+            EVAL_NEXT();
 
-        case OP_SAVEVAR_STR:
+        EVAL_CASE(OP_SAVEVAR_STR):
             gEvalState.setStringVariable(STR.getStringValue());
-            break;
+            EVAL_NEXT();
 
-        case OP_SETCUROBJECT:
+        EVAL_CASE(OP_SETCUROBJECT):
             curObject = Sim::findObject(STR.getStringValue());
-            break;
+            EVAL_NEXT();
 
-        case OP_SETCUROBJECT_NEW:
+        EVAL_CASE(OP_SETCUROBJECT_NEW):
             curObject = currentNewObject;
-            break;
+            EVAL_NEXT();
 
-        case OP_SETCURFIELD:
+        EVAL_CASE(OP_SETCURFIELD):
             curField = U32toSTE(code[ip]);
             curFieldArray[0] = 0;
             ip++;
-            break;
+            EVAL_NEXT();
 
-        case OP_SETCURFIELD_ARRAY:
+        EVAL_CASE(OP_SETCURFIELD_ARRAY):
             dStrcpy(curFieldArray, STR.getStringValue());
-            break;
+            EVAL_NEXT();
 
-        case OP_LOADFIELD_UINT:
+        EVAL_CASE(OP_LOADFIELD_UINT):
             if (curObject)
                 intStack[UINT + 1] = U32(dAtoi(curObject->getDataField(curField, curFieldArray)));
             else
                 intStack[UINT + 1] = 0;
             UINT++;
-            break;
+            EVAL_NEXT();
 
-        case OP_LOADFIELD_FLT:
+        EVAL_CASE(OP_LOADFIELD_FLT):
             if (curObject)
                 floatStack[FLT + 1] = dAtof(curObject->getDataField(curField, curFieldArray));
             else
                 floatStack[FLT + 1] = 0;
             FLT++;
-            break;
+            EVAL_NEXT();
 
-        case OP_LOADFIELD_STR:
+        EVAL_CASE(OP_LOADFIELD_STR):
             if (curObject)
                 val = curObject->getDataField(curField, curFieldArray);
             else
                 val = "";
             STR.setStringValue(val);
-            break;
+            EVAL_NEXT();
 
-        case OP_SAVEFIELD_UINT:
+        EVAL_CASE(OP_SAVEFIELD_UINT):
             STR.setIntValue(intStack[UINT]);
             if (curObject)
                 curObject->setDataField(curField, curFieldArray, STR.getStringValue());
-            break;
+            EVAL_NEXT();
 
-        case OP_SAVEFIELD_FLT:
+        EVAL_CASE(OP_SAVEFIELD_FLT):
             STR.setFloatValue(floatStack[FLT]);
             if (curObject)
                 curObject->setDataField(curField, curFieldArray, STR.getStringValue());
-            break;
+            EVAL_NEXT();
 
-        case OP_SAVEFIELD_STR:
+        EVAL_CASE(OP_SAVEFIELD_STR):
             if (curObject)
                 curObject->setDataField(curField, curFieldArray, STR.getStringValue());
-            break;
+            EVAL_NEXT();
 
-        case OP_STR_TO_UINT:
+        EVAL_CASE(OP_STR_TO_UINT):
             intStack[UINT + 1] = STR.getIntValue();
             UINT++;
-            break;
+            EVAL_NEXT();
 
-        case OP_STR_TO_FLT:
+        EVAL_CASE(OP_STR_TO_FLT):
             floatStack[FLT + 1] = STR.getFloatValue();
             FLT++;
-            break;
+            EVAL_NEXT();
 
-        case OP_STR_TO_NONE:
+        EVAL_CASE(OP_STR_TO_NONE):
             // This exists simply to deal with certain typecast situations.
-            break;
+            EVAL_NEXT();
 
-        case OP_FLT_TO_UINT:
+        EVAL_CASE(OP_FLT_TO_UINT):
             intStack[UINT + 1] = (unsigned int)floatStack[FLT];
             FLT--;
             UINT++;
-            break;
+            EVAL_NEXT();
 
-        case OP_FLT_TO_STR:
+        EVAL_CASE(OP_FLT_TO_STR):
             STR.setFloatValue(floatStack[FLT]);
             FLT--;
-            break;
+            EVAL_NEXT();
 
-        case OP_FLT_TO_NONE:
+        EVAL_CASE(OP_FLT_TO_NONE):
             FLT--;
-            break;
+            EVAL_NEXT();
 
-        case OP_UINT_TO_FLT:
+        EVAL_CASE(OP_UINT_TO_FLT):
             floatStack[FLT + 1] = intStack[UINT];
             UINT--;
             FLT++;
-            break;
+            EVAL_NEXT();
 
-        case OP_UINT_TO_STR:
+        EVAL_CASE(OP_UINT_TO_STR):
             STR.setIntValue(intStack[UINT]);
             UINT--;
-            break;
+            EVAL_NEXT();
 
-        case OP_UINT_TO_NONE:
+        EVAL_CASE(OP_UINT_TO_NONE):
             UINT--;
-            break;
+            EVAL_NEXT();
 
-        case OP_LOADIMMED_UINT:
+        EVAL_CASE(OP_LOADIMMED_UINT):
             intStack[UINT + 1] = code[ip++];
             UINT++;
-            break;
+            EVAL_NEXT();
 
-        case OP_LOADIMMED_FLT:
+        EVAL_CASE(OP_LOADIMMED_FLT):
             floatStack[FLT + 1] = curFloatTable[code[ip]];
             ip++;
             FLT++;
-            break;
-        case OP_TAG_TO_STR:
-            code[ip - 1] = OP_LOADIMMED_STR;
+            EVAL_NEXT();
+        EVAL_CASE(OP_TAG_TO_STR):
+            patchInstruction(ip - 1, OP_LOADIMMED_STR);
             // it's possible the string has already been converted
             if (U8(curStringTable[code[ip]]) != StringTagPrefixByte)
             {
@@ -910,15 +1060,15 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
                 dSprintf(curStringTable + code[ip] + 1, 7, "%d", id);
                 *(curStringTable + code[ip]) = StringTagPrefixByte;
             }
-        case OP_LOADIMMED_STR:
+        EVAL_CASE(OP_LOADIMMED_STR):
             STR.setStringValue(curStringTable + code[ip++]);
-            break;
+            EVAL_NEXT();
 
-        case OP_LOADIMMED_IDENT:
+        EVAL_CASE(OP_LOADIMMED_IDENT):
             STR.setStringValue(U32toSTE(code[ip++]));
-            break;
+            EVAL_NEXT();
 
-        case OP_CALLFUNC_RESOLVE:
+        EVAL_CASE(OP_CALLFUNC_RESOLVE):
             // This deals with a function that is potentially living in a namespace.
             fnNamespace = U32toSTE(code[ip + 1]);
             fnName = U32toSTE(code[ip]);
@@ -934,14 +1084,14 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
                     getFileLine(ip - 4), fnNamespace ? fnNamespace : "",
                     fnNamespace ? "::" : "", fnName);
                 STR.getArgcArgv(fnName, &callArgc, &callArgv);
-                break;
+                EVAL_NEXT();
             }
             // Now, rewrite our code a bit (ie, avoid future lookups) and fall
             // through to OP_CALLFUNC
             code[ip + 1] = *((dsize_t*)&nsEntry);
-            code[ip - 1] = OP_CALLFUNC;
+            patchInstruction(ip - 1, OP_CALLFUNC);
 
-        case OP_CALLFUNC:
+        EVAL_CASE(OP_CALLFUNC):
         {
             fnName = U32toSTE(code[ip]);
 
@@ -969,11 +1119,21 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
                 {
                     gEvalState.thisObject = 0;
                     Con::warnf(ConsoleLogEntry::General, "%s: Unable to find object: '%s' attempting to call function '%s'", getFileLine(ip - 4), callArgv[1], fnName);
-                    break;
+                    EVAL_NEXT();
                 }
                 ns = gEvalState.thisObject->getNamespace();
                 if (ns)
-                    nsEntry = ns->lookup(fnName);
+                {
+                    // Method calls have no namespace operand, so the slot
+                    // holds this call site's cache instead.
+                    methodCache = *((Namespace::LookupCache**)&code[ip - 2]);
+                    if (!methodCache)
+                    {
+                        methodCache = (Namespace::LookupCache*)allocInlineCache(sizeof(Namespace::LookupCache));
+                        code[ip - 2] = *((dsize_t*)&methodCache);
+                    }
+                    nsEntry = ns->lookup(fnName, *methodCache);
+                }
                 else
                     nsEntry = NULL;
             }
@@ -1007,8 +1167,12 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
                     }
                 }
                 STR.setStringValue("");
-                break;
+                EVAL_NEXT();
             }
+            profiled = Namespace::smProfilerEnabled;
+            if (profiled)
+                Namespace::profileEnter(nsEntry);
+
             if (nsEntry->mType == Namespace::Entry::ScriptFunctionType)
             {
                 if (nsEntry->mFunctionOffset)
@@ -1112,44 +1276,47 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
                 }
             }
 
+            if (profiled)
+                Namespace::profileExit(nsEntry);
+
             if (callType == FuncCallExprNode::MethodCall)
                 gEvalState.thisObject = saveObject;
-            break;
+            EVAL_NEXT();
         }
-        case OP_ADVANCE_STR:
+        EVAL_CASE(OP_ADVANCE_STR):
             STR.advance();
-            break;
-        case OP_ADVANCE_STR_APPENDCHAR:
+            EVAL_NEXT();
+        EVAL_CASE(OP_ADVANCE_STR_APPENDCHAR):
             STR.advanceChar(code[ip++]);
-            break;
+            EVAL_NEXT();
 
-        case OP_ADVANCE_STR_COMMA:
+        EVAL_CASE(OP_ADVANCE_STR_COMMA):
             STR.advanceChar('_');
-            break;
+            EVAL_NEXT();
 
-        case OP_ADVANCE_STR_NUL:
+        EVAL_CASE(OP_ADVANCE_STR_NUL):
             STR.advanceChar(0);
-            break;
+            EVAL_NEXT();
 
-        case OP_REWIND_STR:
+        EVAL_CASE(OP_REWIND_STR):
             STR.rewind();
-            break;
+            EVAL_NEXT();
 
-        case OP_TERMINATE_REWIND_STR:
+        EVAL_CASE(OP_TERMINATE_REWIND_STR):
             STR.rewindTerminate();
-            break;
+            EVAL_NEXT();
 
-        case OP_COMPARE_STR:
+        EVAL_CASE(OP_COMPARE_STR):
             intStack[++UINT] = STR.compare();
-            break;
-        case OP_PUSH:
+            EVAL_NEXT();
+        EVAL_CASE(OP_PUSH):
             STR.push();
-            break;
+            EVAL_NEXT();
 
-        case OP_PUSH_FRAME:
+        EVAL_CASE(OP_PUSH_FRAME):
             STR.pushFrame();
-            break;
-        case OP_BREAK:
+            EVAL_NEXT();
+        EVAL_CASE(OP_BREAK):
         {
             //append the ip and codeptr before managing the breakpoint!
             AssertFatal(!gEvalState.stack.empty(), "Empty eval stack on break!");
@@ -1163,7 +1330,7 @@ const char* CodeBlock::exec(U32 ip, const char* functionName, Namespace* thisNam
             TelDebugger->executionStopped(this, breakLine);
             goto breakContinue;
         }
-        case OP_INVALID:
+        EVAL_CASE(OP_INVALID):
 
         default:
             // error!
@@ -122,6 +122,11 @@ namespace Compiler
 
         OP_BREAK,
 
+        // Only ever written by the interpreter, when it patches code it has
+        // already run, so these never appear in a DSO.
+        OP_SETCURVAR_GLOBAL,
+        OP_SETCURVAR_GLOBAL_CREATE,
+
         OP_INVALID
     };
 
@@ -1250,6 +1250,102 @@ ConsoleFunction(trace, void, 2, 2, "trace(bool)")
 
 //----------------------------------------------------------------
 
+ConsoleFunction(scriptProfilerEnable, void, 2, 2, "(bool enable) Time every console function and method call.")
+{
+    argc;
+    Namespace::smProfilerEnabled = dAtob(argv[1]);
+}
+
+ConsoleFunction(scriptProfilerReset, void, 1, 1, "Clear the call counts and times gathered by the script profiler.")
+{
+    argc; argv;
+    Namespace::resetProfile();
+}
+
+ConsoleFunction(scriptProfilerDump, void, 1, 2, "([int maxEntries=50]) Print the functions the script profiler saw the most time spent in.")
+{
+    Namespace::dumpProfile(argc > 1 ? dAtoi(argv[1]) : 50);
+}
+
+ConsoleFunction(benchScripts, const char*, 2, 4, "(string pattern, int ops=100000, int runs=3) "
+                "Execute every script matching pattern and time the ScriptBench:: function named after it. "
+                "Each function is passed the number of operations to perform; the best of runs is reported. "
+                "Returns a tab separated list of \"name opsPerSecond\" records.")
+{
+    S32 ops = argc > 2 ? dAtoi(argv[2]) : 100000;
+    S32 runs = argc > 3 ? dAtoi(argv[3]) : 3;
+    if (ops < 1)
+        ops = 1;
+    if (runs < 1)
+        runs = 1;
+
+    Vector<StringTableEntry> files;
+    if (Con::expandScriptFilename(scriptFilenameBuffer, sizeof(scriptFilenameBuffer), argv[1]))
+    {
+        const char* fn;
+        for (ResourceObject* match = ResourceManager->findMatch(scriptFilenameBuffer, &fn, NULL); match;
+            match = ResourceManager->findMatch(scriptFilenameBuffer, &fn, match))
+            files.push_back(StringTable->insert(fn));
+    }
+
+    Namespace* benchNamespace = Namespace::find(StringTable->insert("ScriptBench"));
+    F64 frequency = F64(Platform::getPerformanceFrequency());
+
+    char opsArg[32];
+    dSprintf(opsArg, sizeof(opsArg), "%d", ops);
+
+    U32 retSize = files.size() * 64 + 1;
+    char* ret = Con::getReturnBuffer(retSize);
+    ret[0] = 0;
+
+    for (U32 i = 0; i < files.size(); i++)
+    {
+        Con::executef(2, "exec", files[i]);
+
+        // common/bench/stringConcat.cs runs ScriptBench::stringConcat()
+        char name[256];
+        const char* base = dStrrchr(files[i], '/');
+        dStrncpy(name, base ? base + 1 : files[i], sizeof(name) - 1);
+        name[sizeof(name) - 1] = 0;
+        char* ext = dStrrchr(name, '.');
+        if (ext)
+            *ext = 0;
+
+        Namespace::Entry* ent = benchNamespace->lookup(StringTable->insert(name));
+        if (!ent)
+        {
+            Con::errorf("benchScripts: %s does not define ScriptBench::%s()", files[i], name);
+            continue;
+        }
+
+        const char* callArgv[2] = { name, opsArg };
+
+        // Once untimed, so every inline cache is filled in.
+        ent->execute(2, callArgv, &gEvalState);
+
+        U64 best = U64(-1);
+        for (S32 run = 0; run < runs; run++)
+        {
+            U64 start = Platform::getPerformanceCounter();
+            ent->execute(2, callArgv, &gEvalState);
+            U64 elapsed = Platform::getPerformanceCounter() - start;
+            if (elapsed < best)
+                best = elapsed;
+        }
+
+        F64 seconds = F64(best) / frequency;
+        F64 opsPerSecond = seconds > 0 ? ops / seconds : 0;
+        Con::printf("%-24s %14.0f ops/sec", name, opsPerSecond);
+
+        U32 len = dStrlen(ret);
+        dSprintf(ret + len, retSize - len, "%s%.40s %.0f", len ? "\t" : "", name, opsPerSecond);
+    }
+
+    return ret;
+}
+
+//----------------------------------------------------------------
+
 #if defined(TORQUE_DEBUG) || defined(INTERNAL_RELEASE)
 ConsoleFunction(debug, void, 1, 1, "debug()")
 {
@@ -323,6 +323,7 @@ void Dictionary::remove(Dictionary::Entry* ent)
     *walk = (ent->nextEntry);
     delete ent;
     hashTable->count--;
+    hashTable->removeSequence++;
 }
 
 Dictionary::Dictionary()
@@ -358,6 +359,7 @@ void Dictionary::setState(ExprEvalState* state, Dictionary* ref)
         hashTable->owner = this;
         hashTable->count = 0;
         hashTable->size = ST_INIT_SIZE;
+        hashTable->removeSequence = 0;
         hashTable->data = new Entry * [hashTable->size];
 
         for (S32 i = 0; i < hashTable->size; i++)
@@ -393,6 +395,7 @@ void Dictionary::reset()
     }
     hashTable->size = ST_INIT_SIZE;
     hashTable->count = 0;
+    hashTable->removeSequence++;
 }
 
 
@@ -606,6 +609,10 @@ Namespace::Entry::Entry()
 {
     mCode = NULL;
     mType = InvalidFunctionType;
+    mProfileCalls = 0;
+    mProfileDepth = 0;
+    mProfileTotalTime = 0;
+    mProfileSelfTime = 0;
 }
 
 void Namespace::Entry::clear()
@@ -945,6 +952,18 @@ void Namespace::markGroup(const char* name, const char* usage)
 extern S32 executeBlock(StmtNode* block, ExprEvalState* state);
 
 const char* Namespace::Entry::execute(S32 argc, const char** argv, ExprEvalState* state)
+{
+    if (Namespace::smProfilerEnabled)
+    {
+        Namespace::profileEnter(this);
+        const char* ret = executeUnprofiled(argc, argv, state);
+        Namespace::profileExit(this);
+        return ret;
+    }
+    return executeUnprofiled(argc, argv, state);
+}
+
+const char* Namespace::Entry::executeUnprofiled(S32 argc, const char** argv, ExprEvalState* state)
 {
     if (mType == ScriptFunctionType)
     {
@@ -986,6 +1005,98 @@ const char* Namespace::Entry::execute(S32 argc, const char** argv, ExprEvalState
     return "";
 }
 
+//-----------------------------------------------------------------------------
+
+bool Namespace::smProfilerEnabled = false;
+
+struct ScriptProfileFrame
+{
+    U64 start;
+    U64 childTime;
+};
+
+static Vector<ScriptProfileFrame> sScriptProfileStack(__FILE__, __LINE__);
+
+void Namespace::profileEnter(Entry* ent)
+{
+    ent->mProfileCalls++;
+    ent->mProfileDepth++;
+
+    sScriptProfileStack.increment();
+    ScriptProfileFrame& frame = sScriptProfileStack.last();
+    frame.childTime = 0;
+    frame.start = Platform::getPerformanceCounter();
+}
+
+void Namespace::profileExit(Entry* ent)
+{
+    U64 elapsed = Platform::getPerformanceCounter() - sScriptProfileStack.last().start;
+    U64 childTime = sScriptProfileStack.last().childTime;
+    sScriptProfileStack.pop_back();
+
+    ent->mProfileSelfTime += elapsed - childTime;
+    if (--ent->mProfileDepth == 0)
+        ent->mProfileTotalTime += elapsed;
+
+    if (sScriptProfileStack.size())
+        sScriptProfileStack.last().childTime += elapsed;
+}
+
+void Namespace::resetProfile()
+{
+    // Leave mProfileDepth alone; calls that are running now still exit.
+    for (Namespace* walk = mNamespaceList; walk; walk = walk->mNext)
+    {
+        for (Entry* ent = walk->mEntryList; ent; ent = ent->mNext)
+        {
+            ent->mProfileCalls = 0;
+            ent->mProfileTotalTime = 0;
+            ent->mProfileSelfTime = 0;
+        }
+    }
+}
+
+static S32 QSORT_CALLBACK compareProfileSelfTime(const void* a, const void* b)
+{
+    const Namespace::Entry* ea = *((Namespace::Entry**)a);
+    const Namespace::Entry* eb = *((Namespace::Entry**)b);
+    if (ea->mProfileSelfTime == eb->mProfileSelfTime)
+        return 0;
+    return ea->mProfileSelfTime < eb->mProfileSelfTime ? 1 : -1;
+}
+
+void Namespace::dumpProfile(U32 maxEntries)
+{
+    Vector<Entry*> entries;
+    for (Namespace* walk = mNamespaceList; walk; walk = walk->mNext)
+        for (Entry* ent = walk->mEntryList; ent; ent = ent->mNext)
+            if (ent->mProfileCalls)
+                entries.push_back(ent);
+
+    if (entries.size())
+        dQsort(entries.address(), entries.size(), sizeof(Entry*), compareProfileSelfTime);
+
+    F64 toMs = 1000.0 / F64(Platform::getPerformanceFrequency());
+
+    Con::printf("Script Profile Dump:");
+    Con::printf("Ordered by self time -");
+    Con::printf("     Calls   Total ms    Self ms  Self us/call  Function");
+    for (U32 i = 0; i < entries.size() && i < maxEntries; i++)
+    {
+        Entry* ent = entries[i];
+        F64 selfMs = F64(ent->mProfileSelfTime) * toMs;
+        Con::printf("%10d %10.3f %10.3f %13.3f  %s%s%s%s%s%s",
+            ent->mProfileCalls,
+            F64(ent->mProfileTotalTime) * toMs,
+            selfMs,
+            selfMs * 1000.0 / ent->mProfileCalls,
+            ent->mPackage ? "[" : "", ent->mPackage ? ent->mPackage : "", ent->mPackage ? "] " : "",
+            ent->mNamespace->mName ? ent->mNamespace->mName : "",
+            ent->mNamespace->mName ? "::" : "",
+            ent->mFunctionName);
+    }
+}
+
 StringTableEntry Namespace::mActivePackages[Namespace::MaxActivePackages];
 U32 Namespace::mNumActivePackages = 0;
 U32 Namespace::mOldNumActivePackages = 0;
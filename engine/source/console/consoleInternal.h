@@ -72,10 +72,21 @@ public:
             BoolCallback mBoolCallbackFunc;
             const char* mGroupName;
         } cb;
+
+        /// @name Script profiler
+        /// Gathered while Namespace::smProfilerEnabled is set.
+        /// @{
+        U32 mProfileCalls;
+        U32 mProfileDepth;      ///< Calls currently running, so recursion isn't counted twice.
+        U64 mProfileTotalTime;  ///< Inclusive time, in Platform::getPerformanceCounter() ticks.
+        U64 mProfileSelfTime;   ///< Time not spent in calls to other entries.
+        /// @}
+
         Entry();
         void clear();
 
         const char* execute(S32 argc, const char** argv, ExprEvalState* state);
+        const char* executeUnprofiled(S32 argc, const char** argv, ExprEvalState* state);
 
     };
     Entry* mEntryList;
@@ -102,6 +113,29 @@ public:
 
     Entry* lookup(StringTableEntry name);
     Entry* lookupRecursive(StringTableEntry name);
+
+    /// The result of a lookup remembered by a call site, so that calling
+    /// the same method on objects in the same namespace again can skip the
+    /// hash table.  Zero it before first use.
+    struct LookupCache
+    {
+        Namespace* ns;
+        Entry* entry;
+        U32 sequence;
+    };
+
+    /// Same as lookup(name), but reuses cache if nothing has changed since
+    /// it was filled in.
+    Entry* lookup(StringTableEntry name, LookupCache& cache)
+    {
+        if (cache.ns != this || cache.sequence != mCacheSequence)
+        {
+            cache.entry = lookup(name);
+            cache.ns = this;
+            cache.sequence = mCacheSequence;
+        }
+        return cache.entry;
+    }
     Entry* createLocalEntry(StringTableEntry name);
     void buildHashTable();
     void clearEntries();
@@ -130,6 +164,19 @@ public:
     static void unlinkPackages();
     static void relinkPackages();
     static bool isPackage(StringTableEntry name);
+
+    /// @name Script profiler
+    /// Times every call made through an Entry, script or C++, while enabled.
+    /// @{
+    static bool smProfilerEnabled;
+    /// Start timing a call to ent.  Every profileEnter() must be matched by
+    /// a profileExit(), even if the profiler is disabled in between.
+    static void profileEnter(Entry* ent);
+    static void profileExit(Entry* ent);
+    static void resetProfile();
+    /// Print the maxEntries entries with the most self time.
+    static void dumpProfile(U32 maxEntries);
+    /// @}
 };
 
 extern char* typeValueEmpty;
@@ -233,6 +280,7 @@ private:
         S32 size;
         S32 count;
         Entry** data;
+        U32 removeSequence; ///< Bumped whenever entries are deleted.
     };
 
     HashTableData* hashTable;
@@ -248,6 +296,39 @@ public:
     ~Dictionary();
     Entry* lookup(StringTableEntry name);
     Entry* add(StringTableEntry name);
+
+    /// The result of a lookup remembered by the code that made it, which
+    /// stays valid until an entry is removed from the dictionary.  Set name
+    /// and zero the rest before first use.
+    struct LookupCache
+    {
+        StringTableEntry name;
+        Entry* entry;
+        U32 sequence;
+    };
+
+    /// Same as lookup(cache.name), but reuses cache if it is still valid.
+    Entry* lookup(LookupCache& cache)
+    {
+        if (!cache.entry || cache.sequence != hashTable->removeSequence)
+        {
+            cache.entry = lookup(cache.name);
+            cache.sequence = hashTable->removeSequence;
+        }
+        return cache.entry;
+    }
+
+    /// Same as add(cache.name), but reuses cache if it is still valid.
+    Entry* add(LookupCache& cache)
+    {
+        if (!cache.entry || cache.sequence != hashTable->removeSequence)
+        {
+            cache.entry = add(cache.name);
+            cache.sequence = hashTable->removeSequence;
+        }
+        return cache.entry;
+    }
+
     void setState(ExprEvalState* state, Dictionary* ref = NULL);
     void remove(Entry*);
     void reset();
@@ -291,6 +372,8 @@ public:
     Vector<Dictionary*> stack;
     void setCurVarName(StringTableEntry name);
     void setCurVarNameCreate(StringTableEntry name);
+    void setCurGlobalVarName(Dictionary::LookupCache& cache);
+    void setCurGlobalVarNameCreate(Dictionary::LookupCache& cache);
     S32 getIntVariable();
     F64 getFloatVariable();
     const char* getStringVariable();
@@ -110,7 +110,8 @@ public:
 class SimEvent
 {
 public:
-    SimEvent* nextEvent;     ///< Linked list details - pointer to next item in the list.
+    SimEvent* nextEvent;     ///< Next event in the same bucket of the pending event table.
+    U32 queueIndex;          ///< Position in the pending event heap.
     SimTime startTime;       ///< When the event was posted.
     SimTime time;            ///< When the event is scheduled to occur.
     U32 sequenceCount;       ///< Unique ID. These are assigned sequentially based on order
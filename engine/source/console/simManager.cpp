@@ -29,14 +29,139 @@ namespace Sim
 
     //---------------------------------------------------------------------------
     // event queue variables:
+    //
+    // Pending events are kept in a binary min-heap ordered on time and then
+    // sequence number, so events due at the same time are still dispatched in
+    // the order they were posted.  Every pending event is also linked into a
+    // hash table keyed on its sequence number, which keeps cancelEvent() and
+    // the other by-id lookups from having to search the queue.
 
     SimTime gCurrentTime;
     SimTime gTargetTime;
 
     void* gEventQueueMutex;
-    SimEvent* gEventQueue;
+    Vector<SimEvent*> gEventQueue;
+    Vector<SimEvent*> gEventTable;
     U32 gEventSequence;
 
+    enum
+    {
+        EventTableInitialSize = 256,   ///< Must be a power of two.
+    };
+
+    //---------------------------------------------------------------------------
+    // event heap
+
+    static inline bool eventBefore(const SimEvent* a, const SimEvent* b)
+    {
+        if (a->time != b->time)
+            return a->time < b->time;
+
+        // compare sequence numbers so they keep working once they wrap
+        return S32(a->sequenceCount - b->sequenceCount) < 0;
+    }
+
+    static void heapSiftUp(U32 index)
+    {
+        SimEvent* event = gEventQueue[index];
+        while (index > 0)
+        {
+            U32 parent = (index - 1) >> 1;
+            if (!eventBefore(event, gEventQueue[parent]))
+                break;
+            gEventQueue[index] = gEventQueue[parent];
+            gEventQueue[index]->queueIndex = index;
+            index = parent;
+        }
+        gEventQueue[index] = event;
+        event->queueIndex = index;
+    }
+
+    static void heapSiftDown(U32 index)
+    {
+        SimEvent* event = gEventQueue[index];
+        U32 count = gEventQueue.size();
+        for (;;)
+        {
+            U32 child = index * 2 + 1;
+            if (child >= count)
+                break;
+            if (child + 1 < count && eventBefore(gEventQueue[child + 1], gEventQueue[child]))
+                child++;
+            if (!eventBefore(gEventQueue[child], event))
+                break;
+            gEventQueue[index] = gEventQueue[child];
+            gEventQueue[index]->queueIndex = index;
+            index = child;
+        }
+        gEventQueue[index] = event;
+        event->queueIndex = index;
+    }
+
+    static void heapRemove(SimEvent* event)
+    {
+        U32 index = event->queueIndex;
+        SimEvent* last = gEventQueue.last();
+        gEventQueue.pop_back();
+        if (last == event)
+            return;
+
+        gEventQueue[index] = last;
+        last->queueIndex = index;
+        if (index > 0 && eventBefore(last, gEventQueue[(index - 1) >> 1]))
+            heapSiftUp(index);
+        else
+            heapSiftDown(index);
+    }
+
+    //---------------------------------------------------------------------------
+    // event id table
+
+    static inline SimEvent** tableBucket(U32 eventSequence)
+    {
+        return &gEventTable[eventSequence & (gEventTable.size() - 1)];
+    }
+
+    static void tableInsert(SimEvent* event)
+    {
+        // grow once the table is as full as it is big
+        if (gEventQueue.size() > gEventTable.size())
+        {
+            gEventTable.setSize(gEventTable.size() * 2);
+            for (U32 i = 0; i < gEventTable.size(); i++)
+                gEventTable[i] = NULL;
+            for (U32 i = 0; i < gEventQueue.size(); i++)
+            {
+                SimEvent* walk = gEventQueue[i];
+                if (walk == event)
+                    continue;
+                SimEvent** bucket = tableBucket(walk->sequenceCount);
+                walk->nextEvent = *bucket;
+                *bucket = walk;
+            }
+        }
+
+        SimEvent** bucket = tableBucket(event->sequenceCount);
+        event->nextEvent = *bucket;
+        *bucket = event;
+    }
+
+    static void tableRemove(SimEvent* event)
+    {
+        SimEvent** walk = tableBucket(event->sequenceCount);
+        while (*walk != event)
+            walk = &((*walk)->nextEvent);
+        *walk = event->nextEvent;
+    }
+
+    static SimEvent* findEvent(U32 eventSequence)
+    {
+        for (SimEvent* walk = *tableBucket(eventSequence); walk; walk = walk->nextEvent)
+            if (walk->sequenceCount == eventSequence)
+                return walk;
+        return NULL;
+    }
+
     //---------------------------------------------------------------------------
     // event queue init/shutdown
 
@@ -45,7 +170,10 @@ namespace Sim
         gCurrentTime = 0;
         gTargetTime = 0;
         gEventSequence = 1;
-        gEventQueue = NULL;
+        gEventQueue.clear();
+        gEventTable.setSize(EventTableInitialSize);
+        for (U32 i = 0; i < gEventTable.size(); i++)
+            gEventTable[i] = NULL;
         gEventQueueMutex = Mutex::createMutex();
     }
 
@@ -53,13 +181,10 @@ namespace Sim
     {
         // Delete all pending events
         Mutex::lockMutex(gEventQueueMutex);
-        SimEvent* walk = gEventQueue;
-        while (walk)
-        {
-            SimEvent* temp = walk->nextEvent;
-            delete walk;
-            walk = temp;
-        }
+        for (U32 i = 0; i < gEventQueue.size(); i++)
+            delete gEventQueue[i];
+        gEventQueue.clear();
+        gEventTable.clear();
         Mutex::unlockMutex(gEventQueueMutex);
         Mutex::destroyMutex(gEventQueueMutex);
     }
@@ -87,19 +212,13 @@ namespace Sim
             return InvalidEventId;
         }
         event->sequenceCount = gEventSequence++;
-        SimEvent** walk = &gEventQueue;
-        SimEvent* current;
 
-        while ((current = *walk) != NULL && (current->time < event->time))
-            walk = &(current->nextEvent);
-
-        // [tom, 6/24/2005] This ensures that SimEvents are dispatched in the same order that they are posted.
+        // [tom, 6/24/2005] SimEvents must be dispatched in the same order that they are posted.
         // This is needed to ensure Con::threadSafeExecute() executes script code in the correct order.
-        while ((current = *walk) != NULL && (current->time == event->time))
-            walk = &(current->nextEvent);
-
-        event->nextEvent = current;
-        *walk = event;
+        // The heap breaks ties on time with the sequence count to keep that guarantee.
+        gEventQueue.push_back(event);
+        heapSiftUp(gEventQueue.size() - 1);
+        tableInsert(event);
 
         U32 seqCount = event->sequenceCount;
 
@@ -115,20 +234,12 @@ namespace Sim
     {
         Mutex::lockMutex(gEventQueueMutex);
 
-        SimEvent** walk = &gEventQueue;
-        SimEvent* current;
-
-        while ((current = *walk) != NULL)
+        SimEvent* event = findEvent(eventSequence);
+        if (event)
         {
-            if (current->sequenceCount == eventSequence)
-            {
-                *walk = current->nextEvent;
-                delete current;
-                Mutex::unlockMutex(gEventQueueMutex);
-                return;
-            }
-            else
-                walk = &(current->nextEvent);
+            tableRemove(event);
+            heapRemove(event);
+            delete event;
         }
 
         Mutex::unlockMutex(gEventQueueMutex);
@@ -138,19 +249,30 @@ namespace Sim
     {
         Mutex::lockMutex(gEventQueueMutex);
 
-        SimEvent** walk = &gEventQueue;
-        SimEvent* current;
-
-        while ((current = *walk) != NULL)
+        // compact the survivors and rebuild the heap, rather than removing
+        // the object's events one at a time
+        U32 count = 0;
+        for (U32 i = 0; i < gEventQueue.size(); i++)
         {
-            if (current->destObject == obj)
+            SimEvent* event = gEventQueue[i];
+            if (event->destObject == obj)
             {
-                *walk = current->nextEvent;
-                delete current;
+                tableRemove(event);
+                delete event;
             }
             else
-                walk = &(current->nextEvent);
+                gEventQueue[count++] = event;
+        }
+
+        if (count != gEventQueue.size())
+        {
+            gEventQueue.setSize(count);
+            for (U32 i = 0; i < count; i++)
+                gEventQueue[i]->queueIndex = i;
+            for (U32 i = count / 2; i-- > 0; )
+                heapSiftDown(i);
         }
+
         Mutex::unlockMutex(gEventQueueMutex);
     }
 
@@ -160,47 +282,36 @@ namespace Sim
     bool isEventPending(U32 eventSequence)
     {
         Mutex::lockMutex(gEventQueueMutex);
-
-        for (SimEvent* walk = gEventQueue; walk; walk = walk->nextEvent)
-            if (walk->sequenceCount == eventSequence)
-            {
-                Mutex::unlockMutex(gEventQueueMutex);
-                return true;
-            }
+        bool pending = findEvent(eventSequence) != NULL;
         Mutex::unlockMutex(gEventQueueMutex);
-        return false;
+        return pending;
     }
 
     U32 getEventTimeLeft(U32 eventSequence)
     {
         Mutex::lockMutex(gEventQueueMutex);
 
-        for (SimEvent* walk = gEventQueue; walk; walk = walk->nextEvent)
-            if (walk->sequenceCount == eventSequence)
-            {
-                SimTime t = walk->time - getCurrentTime();
-                Mutex::unlockMutex(gEventQueueMutex);
-                return t;
-            }
+        SimEvent* event = findEvent(eventSequence);
+        SimTime t = event ? event->time - getCurrentTime() : 0;
 
         Mutex::unlockMutex(gEventQueueMutex);
 
-        return 0;
+        return t;
     }
 
     U32 getScheduleDuration(U32 eventSequence)
     {
-        for (SimEvent* walk = gEventQueue; walk; walk = walk->nextEvent)
-            if (walk->sequenceCount == eventSequence)
-                return (walk->time - walk->startTime);
+        SimEvent* event = findEvent(eventSequence);
+        if (event)
+            return (event->time - event->startTime);
         return 0;
     }
 
     U32 getTimeSinceStart(U32 eventSequence)
     {
-        for (SimEvent* walk = gEventQueue; walk; walk = walk->nextEvent)
-            if (walk->sequenceCount == eventSequence)
-                return (getCurrentTime() - walk->startTime);
+        SimEvent* event = findEvent(eventSequence);
+        if (event)
+            return (getCurrentTime() - event->startTime);
         return 0;
     }
 
@@ -213,10 +324,11 @@ namespace Sim
 
         Mutex::lockMutex(gEventQueueMutex);
         gTargetTime = targetTime;
-        while (gEventQueue && gEventQueue->time <= targetTime)
+        while (gEventQueue.size() && gEventQueue[0]->time <= targetTime)
         {
-            SimEvent* event = gEventQueue;
-            gEventQueue = gEventQueue->nextEvent;
+            SimEvent* event = gEventQueue[0];
+            tableRemove(event);
+            heapRemove(event);
             AssertFatal(event->time >= gCurrentTime,
                 "SimEventQueue::pop: Cannot go back in time (flux capacitor not installed - BJG).");
             gCurrentTime = event->time;
@@ -14,6 +14,7 @@
 #include "core/resizeStream.h"
 #include "core/memstream.h"
 #include "core/frameAllocator.h"
+#include "core/threadPool.h"
 
 #include "core/resManager.h"
 #include "core/findMatch.h"
@@ -21,6 +22,8 @@
 #include "console/console.h"
 #include "console/consoleTypes.h"
 
+#include "platform/platformSemaphore.h"
+#include "platform/profiler.h"
 #include "util/safeDelete.h"
 
 ResManager* ResourceManager = NULL;
@@ -36,6 +39,7 @@ ResourceObject::ResourceObject()
     prev = NULL;
     lockCount = 0;
     mInstance = NULL;
+    mPrefetch = NULL;
 }
 
 void ResourceObject::destruct()
@@ -740,6 +744,221 @@ bool ResManager::getCrc(const char* fileName, U32& crcVal,
     return (false);
 }
 
+//------------------------------------------------------------------------------
+// Prefetching
+//
+// prefetch() hands the disk reads, zip inflation and CRCs of a list of
+// resources to the thread pool.  The resource create functions still run on
+// the main thread in load(), since most of them touch globals, but by then
+// the data is already in memory and loadInstance() reads it from a MemStream.
+
+struct ResPrefetch
+{
+    char path[1024];      ///< The resource file, or the zip it is in.
+    bool inZip;
+    S32  fileOffset;      ///< Zip entry local header offset.
+    S32  fileSize;        ///< Zip entry uncompressed size.
+
+    void* doneSemaphore;  ///< Released by the worker once the results are in.
+
+    /// @name Results
+    /// @{
+    bool ok;
+    const U8* data;       ///< Either buffer or mapped.
+    U32 size;
+    U8* buffer;
+    const U8* mapped;
+    U32 mappedSize;
+    void* mapping;
+    U32 crc;
+    /// @}
+};
+
+static bool prefetchFile(ResPrefetch* prefetch)
+{
+    prefetch->mapped = Platform::mapFile(prefetch->path, &prefetch->mappedSize, &prefetch->mapping);
+    if (prefetch->mapped)
+    {
+        prefetch->data = prefetch->mapped;
+        prefetch->size = prefetch->mappedSize;
+        return true;
+    }
+
+    // Can't be mapped, read it instead.
+    FileStream fileStream;
+    if (!fileStream.open(prefetch->path, FileStream::Read))
+        return false;
+
+    prefetch->size = fileStream.getStreamSize();
+    prefetch->buffer = new U8[prefetch->size];
+    prefetch->data = prefetch->buffer;
+    return prefetch->size != 0 && fileStream.read(prefetch->size, prefetch->buffer);
+}
+
+static bool prefetchZipEntry(ResPrefetch* prefetch)
+{
+    if (prefetch->fileSize <= 0)
+        return false;
+
+    FileStream zipStream;
+    if (!zipStream.open(prefetch->path, FileStream::Read))
+        return false;
+
+    zipStream.setPosition(prefetch->fileOffset);
+
+    ZipLocalFileHeader zlfHeader;
+    if (zlfHeader.readFromStream(zipStream) == false)
+        return false;
+
+    prefetch->size = prefetch->fileSize;
+    prefetch->buffer = new U8[prefetch->size];
+    prefetch->data = prefetch->buffer;
+
+    if (zlfHeader.m_header.compressionMethod == ZipLocalFileHeader::Stored)
+        return zipStream.read(prefetch->size, prefetch->buffer);
+
+    if (zlfHeader.m_header.compressionMethod == ZipLocalFileHeader::Deflated)
+    {
+        ZipSubRStream zipSubStream;
+        zipSubStream.attachStream(&zipStream);
+        zipSubStream.setUncompressedSize(prefetch->size);
+        bool ok = zipSubStream.read(prefetch->size, prefetch->buffer);
+        zipSubStream.detachStream();
+        return ok;
+    }
+
+    return false;
+}
+
+static void prefetchResource(void* data)
+{
+    ResPrefetch* prefetch = (ResPrefetch*)data;
+
+    PROFILE_START(ResManager_prefetchResource);
+
+    prefetch->ok = prefetch->inZip ? prefetchZipEntry(prefetch) : prefetchFile(prefetch);
+    if (prefetch->ok)
+        prefetch->crc = calculateCRC(prefetch->data, prefetch->size, InvalidCRC);
+
+    PROFILE_END();
+
+    Semaphore::releaseSemaphore(prefetch->doneSemaphore);
+}
+
+U32 ResManager::prefetch(const Vector<const char*>& fileNames)
+{
+    ThreadPool* pool = ThreadPool::getGlobal();
+    if (!pool)
+        return 0;
+
+    // Build the CRC table here rather than racing to do it on the workers.
+    calculateCRC(NULL, 0);
+
+    U32 queued = 0;
+    for (U32 i = 0; i < fileNames.size(); i++)
+    {
+        ResourceObject* obj = find(fileNames[i]);
+        if (!obj || obj->mInstance || obj->mPrefetch)
+            continue;
+
+        ResPrefetch* prefetch;
+        if (obj->flags & ResourceObject::File)
+        {
+            prefetch = new ResPrefetch;
+            dStrncpy(prefetch->path, buildPath(obj->path, obj->name), sizeof(prefetch->path) - 1);
+            prefetch->inZip = false;
+        }
+        else if (obj->flags & ResourceObject::VolumeBlock)
+        {
+            prefetch = new ResPrefetch;
+            dStrncpy(prefetch->path, buildPath(obj->zipPath, obj->zipName), sizeof(prefetch->path) - 1);
+            prefetch->inZip = true;
+        }
+        else
+            continue;
+
+        prefetch->path[sizeof(prefetch->path) - 1] = 0;
+        prefetch->fileOffset = obj->fileOffset;
+        prefetch->fileSize = obj->fileSize;
+        prefetch->doneSemaphore = Semaphore::createSemaphore(0);
+        prefetch->ok = false;
+        prefetch->data = NULL;
+        prefetch->size = 0;
+        prefetch->buffer = NULL;
+        prefetch->mapped = NULL;
+        prefetch->mappedSize = 0;
+        prefetch->mapping = NULL;
+        prefetch->crc = InvalidCRC;
+
+        obj->mPrefetch = prefetch;
+        pool->queueJob(prefetchResource, prefetch);
+        queued++;
+    }
+
+    return queued;
+}
+
+ResPrefetch* ResManager::takePrefetch(ResourceObject* obj)
+{
+    ResPrefetch* prefetch = obj->mPrefetch;
+    if (!prefetch)
+        return NULL;
+
+    obj->mPrefetch = NULL;
+
+    PROFILE_START(ResManager_waitPrefetch);
+    Semaphore::acquireSemaphore(prefetch->doneSemaphore);
+    PROFILE_END();
+
+    if (!prefetch->ok)
+    {
+        freePrefetch(prefetch);
+        return NULL;
+    }
+    return prefetch;
+}
+
+void ResManager::freePrefetch(ResPrefetch* prefetch)
+{
+    if (prefetch->mapped)
+        Platform::unmapFile(prefetch->mapped, prefetch->mappedSize, prefetch->mapping);
+    delete[] prefetch->buffer;
+    Semaphore::destroySemaphore(prefetch->doneSemaphore);
+    delete prefetch;
+}
+
+void ResManager::cancelPrefetch(ResourceObject* obj)
+{
+    ResPrefetch* prefetch = takePrefetch(obj);
+    if (prefetch)
+        freePrefetch(prefetch);
+}
+
+ConsoleFunction(prefetchResources, S32, 2, 0, "(string file, ...)"
+    "Start reading the given resources into memory on worker threads, so that loading them later "
+    "only has to construct them. Accepts wildcards. Returns the number of resources queued.")
+{
+    Vector<const char*> fileNames;
+    char fileName[1024];
+
+    for (S32 i = 1; i < argc; i++)
+    {
+        Con::expandScriptFilename(fileName, sizeof(fileName), argv[i]);
+
+        if (dStrchr(fileName, '*') || dStrchr(fileName, '?'))
+        {
+            const char* match;
+            for (ResourceObject* obj = ResourceManager->findMatch(fileName, &match); obj;
+                obj = ResourceManager->findMatch(fileName, &match, obj))
+                fileNames.push_back(StringTable->insert(match));
+        }
+        else
+            fileNames.push_back(StringTable->insert(fileName));
+    }
+
+    return ResourceManager->prefetch(fileNames);
+}
+
 //------------------------------------------------------------------------------
 
 ResourceObject* ResManager::load(const char* fileName, bool computeCRC)
@@ -788,7 +1007,19 @@ ResourceObject* curResourceObj = NULL;
 
 ResourceInstance* ResManager::loadInstance(ResourceObject* obj, bool computeCRC)
 {
-    Stream* stream = openStream(obj);
+    ResPrefetch* prefetch = takePrefetch(obj);
+
+    Stream* stream;
+    if (prefetch)
+    {
+        if (echoFileNames)
+            Con::printf("FILE ACCESS: %s/%s", obj->path, obj->name);
+        if (obj->flags & ResourceObject::File)
+            obj->fileSize = prefetch->size;
+        stream = new MemStream(prefetch->size, (void*)prefetch->data, true, false);
+    }
+    else
+        stream = openStream(obj);
     if (!stream)
         return NULL;
 
@@ -800,7 +1031,7 @@ ResourceInstance* ResManager::loadInstance(ResourceObject* obj, bool computeCRC)
     }
 
     if (computeCRC)
-        obj->crc = calculateCRCStream(stream, InvalidCRC);
+        obj->crc = prefetch ? prefetch->crc : calculateCRCStream(stream, InvalidCRC);
     else
         obj->crc = InvalidCRC;
 
@@ -811,6 +1042,9 @@ ResourceInstance* ResManager::loadInstance(ResourceObject* obj, bool computeCRC)
     {
         AssertWarn(false, "ResourceObject::construct: NULL resource create function.");
         Con::errorf("ResourceObject::construct: NULL resource create function for '%s'.", obj->name);
+        closeStream(stream);
+        if (prefetch)
+            freePrefetch(prefetch);
         return NULL;
     }
 
@@ -818,6 +1052,8 @@ ResourceInstance* ResManager::loadInstance(ResourceObject* obj, bool computeCRC)
     if (ret)
         ret->mSourceResource = obj;
     closeStream(stream);
+    if (prefetch)
+        freePrefetch(prefetch);
     return ret;
 }
 
@@ -1216,6 +1452,7 @@ ResourceObject* ResManager::createZipResource(StringTableEntry path, StringTable
 
 void ResManager::freeResource(ResourceObject* ro)
 {
+    cancelPrefetch(ro);
     ro->destruct();
     ro->unlink();
 
@@ -33,6 +33,7 @@ class Stream;
 class ZipSubRStream;
 class ResManager;
 class FindMatch;
+struct ResPrefetch;
 
 extern ResManager* ResourceManager;
 
@@ -161,6 +162,7 @@ public:
                                   ///  this may be NULL or garbage.
     S32 lockCount;                ///< Lock count; used to control load/unload of resource from memory.
     U32 crc;                      ///< CRC of resource.
+    ResPrefetch* mPrefetch;       ///< Data being read ahead by ResManager::prefetch(), if any.
 
     ResourceObject();
     ~ResourceObject() { unlink(); }
@@ -382,6 +384,15 @@ private:
 
     RegisteredExtension* registeredList;
 
+    /// @name Prefetching
+    /// @{
+
+    /// Wait for obj's prefetch to finish and detach it.  Returns NULL if it
+    /// has none or the read failed.
+    ResPrefetch* takePrefetch(ResourceObject* obj);
+    void freePrefetch(ResPrefetch* prefetch);
+    /// @}
+
     static char* smExcludedDirectories;
     ResManager();
 public:
@@ -424,6 +435,15 @@ public:
     Stream* openStream(ResourceObject* object);       ///< Opens a stream for an object
     void     closeStream(Stream* stream);              ///< Closes the stream
 
+    /// Read the given resources into memory on the thread pool, so that a
+    /// later load() of any of them only has to construct the instance.
+    ///
+    /// Zip entries are inflated and CRCs computed on the workers as well.
+    /// Unknown, memory and already loaded resources are skipped.  Returns
+    /// the number of resources queued.
+    U32 prefetch(const Vector<const char*>& fileNames);
+    void cancelPrefetch(ResourceObject* obj);          ///< Drops obj's prefetched data, if any.
+
     /// Decrements the lock count of an object.  If the lock count is zero post-decrement,
     /// the object is added to the timeoutList for deletion upon call of flush.
     void unlock(ResourceObject*);
@@ -4,7 +4,9 @@
 //-----------------------------------------------------------------------------
 
 #include "platform/platform.h"
+#include "platform/platformMutex.h"
 #include "core/stringTable.h"
+#include "console/console.h"
 
 _StringTable* StringTable = NULL;
 const U32 _StringTable::csm_stInitSize = 29;
@@ -64,19 +66,32 @@ U32 _StringTable::hashStringn(const char* str, S32 len)
 //--------------------------------------
 _StringTable::_StringTable()
 {
-    buckets = (Node**)dMalloc(csm_stInitSize * sizeof(Node*));
-    for (U32 i = 0; i < csm_stInitSize; i++) {
-        buckets[i] = 0;
-    }
+    // Fill in the hash table up front rather than racing to do it later.
+    if (sgInitTable)
+        initTolowerTable();
 
-    numBuckets = csm_stInitSize;
-    itemCount = 0;
+    for (U32 i = 0; i < NumShards; i++)
+    {
+        Shard& shard = mShards[i];
+        shard.mutex = Mutex::createMutex();
+        shard.buckets = (Node**)dMalloc(csm_stInitSize * sizeof(Node*));
+        for (U32 j = 0; j < csm_stInitSize; j++)
+            shard.buckets[j] = 0;
+
+        shard.numBuckets = csm_stInitSize;
+        shard.itemCount = 0;
+        shard.stringBytes = 0;
+    }
 }
 
 //--------------------------------------
 _StringTable::~_StringTable()
 {
-    dFree(buckets);
+    for (U32 i = 0; i < NumShards; i++)
+    {
+        dFree(mShards[i].buckets);
+        Mutex::destroyMutex(mShards[i].mutex);
+    }
 }
 
 
@@ -98,11 +113,10 @@ void _StringTable::destroy()
 
 
 //--------------------------------------
-StringTableEntry _StringTable::insert(const char* val, const bool  caseSens)
+StringTableEntry _StringTable::insertLocked(Shard& shard, const char* val, U32 key, bool caseSens)
 {
     Node** walk, * temp;
-    U32 key = hashString(val);
-    walk = &buckets[key % numBuckets];
+    walk = &shard.buckets[key % shard.numBuckets];
     while ((temp = *walk) != NULL) {
         if (caseSens && !dStrcmp(temp->val, val))
             return temp->val;
@@ -110,19 +124,33 @@ StringTableEntry _StringTable::insert(const char* val, const bool  caseSens)
             return temp->val;
         walk = &(temp->next);
     }
-    char* ret = 0;
-    if (!*walk) {
-        *walk = (Node*)mempool.alloc(sizeof(Node));
-        (*walk)->next = 0;
-        (*walk)->val = (char*)mempool.alloc(dStrlen(val) + 1);
-        dStrcpy((*walk)->val, val);
-        ret = (*walk)->val;
-        itemCount++;
-    }
-    if (itemCount > 2 * numBuckets) {
-        resize(4 * numBuckets - 1);
-    }
-    return ret;
+
+    // New strings go on the end of the bucket list, so that case sens
+    // strings are always after their corresponding case insens strings.
+    U32 len = dStrlen(val) + 1;
+    temp = (Node*)shard.mempool.alloc(sizeof(Node));
+    temp->next = 0;
+    temp->val = (char*)shard.mempool.alloc(len);
+    dStrcpy(temp->val, val);
+    *walk = temp;
+
+    shard.itemCount++;
+    shard.stringBytes += len;
+
+    if (shard.itemCount > 2 * shard.numBuckets)
+        resizeShard(shard, 4 * shard.numBuckets - 1);
+
+    return temp->val;
+}
+
+StringTableEntry _StringTable::insert(const char* val, const bool  caseSens)
+{
+    U32 key = hashString(val);
+    Shard& shard = mShards[getShard(key)];
+
+    MutexHandle handle;
+    handle.lock(shard.mutex);
+    return insertLocked(shard, val, key, caseSens);
 }
 
 //--------------------------------------
@@ -136,39 +164,105 @@ StringTableEntry _StringTable::insertn(const char* src, S32 len, const bool  cas
 }
 
 //--------------------------------------
-StringTableEntry _StringTable::lookup(const char* val, const bool  caseSens)
+void _StringTable::insertBatch(const char* const* strings, U32 count, StringTableEntry* entries, bool caseSens)
 {
-    Node** walk, * temp;
-    U32 key = hashString(val);
-    walk = &buckets[key % numBuckets];
-    while ((temp = *walk) != NULL) {
-        if (caseSens && !dStrcmp(temp->val, val))
-            return temp->val;
-        else if (!caseSens && !dStricmp(temp->val, val))
-            return temp->val;
-        walk = &(temp->next);
+    if (!count)
+        return;
+
+    // Sort the strings by shard, then take each lock once for all of its strings.
+    U32 shardStart[NumShards + 1];
+    dMemset(shardStart, 0, sizeof(shardStart));
+
+    U32* keys = new U32[count];
+    U32* order = new U32[count];
+
+    for (U32 i = 0; i < count; i++)
+    {
+        keys[i] = hashString(strings[i]);
+        shardStart[getShard(keys[i]) + 1]++;
+    }
+    for (U32 i = 0; i < NumShards; i++)
+        shardStart[i + 1] += shardStart[i];
+
+    U32 shardFill[NumShards];
+    dMemcpy(shardFill, shardStart, sizeof(shardFill));
+    for (U32 i = 0; i < count; i++)
+        order[shardFill[getShard(keys[i])]++] = i;
+
+    for (U32 i = 0; i < NumShards; i++)
+    {
+        if (shardStart[i] == shardStart[i + 1])
+            continue;
+
+        Shard& shard = mShards[i];
+        Mutex::lockMutex(shard.mutex);
+        for (U32 j = shardStart[i]; j < shardStart[i + 1]; j++)
+        {
+            U32 index = order[j];
+            entries[index] = insertLocked(shard, strings[index], keys[index], caseSens);
+        }
+        Mutex::unlockMutex(shard.mutex);
+    }
+
+    delete[] keys;
+    delete[] order;
+}
+
+//--------------------------------------
+StringTableEntry _StringTable::lookupLocked(Shard& shard, const char* val, U32 key, bool caseSens)
+{
+    Node* walk = shard.buckets[key % shard.numBuckets];
+    for (; walk; walk = walk->next) {
+        if (caseSens && !dStrcmp(walk->val, val))
+            return walk->val;
+        else if (!caseSens && !dStricmp(walk->val, val))
+            return walk->val;
     }
     return NULL;
 }
 
+StringTableEntry _StringTable::lookup(const char* val, const bool  caseSens)
+{
+    U32 key = hashString(val);
+    Shard& shard = mShards[getShard(key)];
+
+    MutexHandle handle;
+    handle.lock(shard.mutex);
+    return lookupLocked(shard, val, key, caseSens);
+}
+
 //--------------------------------------
 StringTableEntry _StringTable::lookupn(const char* val, S32 len, const bool  caseSens)
 {
-    Node** walk, * temp;
     U32 key = hashStringn(val, len);
-    walk = &buckets[key % numBuckets];
-    while ((temp = *walk) != NULL) {
-        if (caseSens && !dStrncmp(temp->val, val, len) && temp->val[len] == 0)
-            return temp->val;
-        else if (!caseSens && !dStrnicmp(temp->val, val, len) && temp->val[len] == 0)
-            return temp->val;
-        walk = &(temp->next);
+    Shard& shard = mShards[getShard(key)];
+
+    MutexHandle handle;
+    handle.lock(shard.mutex);
+
+    Node* walk = shard.buckets[key % shard.numBuckets];
+    for (; walk; walk = walk->next) {
+        if (caseSens && !dStrncmp(walk->val, val, len) && walk->val[len] == 0)
+            return walk->val;
+        else if (!caseSens && !dStrnicmp(walk->val, val, len) && walk->val[len] == 0)
+            return walk->val;
     }
     return NULL;
 }
 
 //--------------------------------------
 void _StringTable::resize(const U32 newSize)
+{
+    U32 shardSize = getMax(newSize / NumShards, csm_stInitSize);
+    for (U32 i = 0; i < NumShards; i++)
+    {
+        MutexHandle handle;
+        handle.lock(mShards[i].mutex);
+        resizeShard(mShards[i], shardSize);
+    }
+}
+
+void _StringTable::resizeShard(Shard& shard, const U32 newSize)
 {
     Node* head = NULL, * walk, * temp;
     U32 i;
@@ -177,8 +271,8 @@ void _StringTable::resize(const U32 newSize)
     // lists so that case sens strings are always after their
     // corresponding case insens strings
 
-    for (i = 0; i < numBuckets; i++) {
-        walk = buckets[i];
+    for (i = 0; i < shard.numBuckets; i++) {
+        walk = shard.buckets[i];
         while (walk)
         {
             temp = walk->next;
@@ -187,11 +281,11 @@ void _StringTable::resize(const U32 newSize)
             walk = temp;
         }
     }
-    buckets = (Node**)dRealloc(buckets, newSize * sizeof(Node));
+    shard.buckets = (Node**)dRealloc(shard.buckets, newSize * sizeof(Node*));
     for (i = 0; i < newSize; i++) {
-        buckets[i] = 0;
+        shard.buckets[i] = 0;
     }
-    numBuckets = newSize;
+    shard.numBuckets = newSize;
     walk = head;
     while (walk) {
         U32 key;
@@ -199,7 +293,63 @@ void _StringTable::resize(const U32 newSize)
 
         walk = walk->next;
         key = hashString(temp->val);
-        temp->next = buckets[key % newSize];
-        buckets[key % newSize] = temp;
+        temp->next = shard.buckets[key % newSize];
+        shard.buckets[key % newSize] = temp;
     }
-}
\ No newline at end of file
+}
+
+//--------------------------------------
+void _StringTable::dumpStats()
+{
+    U32 totalItems = 0, totalBuckets = 0, usedBuckets = 0, maxChain = 0;
+    U32 stringBytes = 0, nodeBytes = 0, bucketBytes = 0;
+    U32 chainCounts[8];
+    dMemset(chainCounts, 0, sizeof(chainCounts));
+
+    Con::printf("StringTable:");
+    Con::printf("  Shard  Entries  Buckets  Max chain");
+
+    for (U32 i = 0; i < NumShards; i++)
+    {
+        Shard& shard = mShards[i];
+
+        MutexHandle handle;
+        handle.lock(shard.mutex);
+
+        U32 shardMax = 0;
+        for (U32 j = 0; j < shard.numBuckets; j++)
+        {
+            U32 length = 0;
+            for (Node* walk = shard.buckets[j]; walk; walk = walk->next)
+                length++;
+
+            if (length)
+                usedBuckets++;
+            chainCounts[getMin(length, U32(7))]++;
+            shardMax = getMax(shardMax, length);
+        }
+
+        Con::printf("  %5d  %7d  %7d  %9d", i, shard.itemCount, shard.numBuckets, shardMax);
+
+        totalItems += shard.itemCount;
+        totalBuckets += shard.numBuckets;
+        maxChain = getMax(maxChain, shardMax);
+        stringBytes += shard.stringBytes;
+        nodeBytes += shard.itemCount * sizeof(Node);
+        bucketBytes += shard.numBuckets * sizeof(Node*);
+    }
+
+    Con::printf("  %d entries in %d buckets, %d used", totalItems, totalBuckets, usedBuckets);
+    Con::printf("  Average chain %.2f, longest %d", usedBuckets ? F32(totalItems) / usedBuckets : 0.0f, maxChain);
+    Con::printf("  Chains of length 0-6: %d %d %d %d %d %d %d, 7+: %d",
+        chainCounts[0], chainCounts[1], chainCounts[2], chainCounts[3],
+        chainCounts[4], chainCounts[5], chainCounts[6], chainCounts[7]);
+    Con::printf("  Bytes held: %d (strings %d, nodes %d, buckets %d)",
+        stringBytes + nodeBytes + bucketBytes, stringBytes, nodeBytes, bucketBytes);
+}
+
+ConsoleFunction(dumpStringTableStats, void, 1, 1, "dumpStringTableStats()\n"
+    "Prints the entry counts, chain lengths and memory use of the string table.")
+{
+    StringTable->dumpStats();
+}
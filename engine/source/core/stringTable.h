@@ -53,6 +53,12 @@
 ///  The scripting engine and the resource manager are the primary users of the
 ///  StringTable.
 ///
+/// The table may be used from any thread.  It is split into shards picked by
+/// the string's hash, each a hash table of its own with its own lock, so
+/// threads only wait on each other when their strings land in the same shard,
+/// and a shard that fills up only rehashes its own entries.  Entries never
+/// move, so a StringTableEntry stays valid with no lock held.
+///
 /// @note Be aware that the StringTable NEVER DEALLOCATES memory, so be careful when you
 ///       add strings to it. If you carelessly add many strings, you will end up wasting
 ///       space.
@@ -69,10 +75,31 @@ private:
         Node* next;
     };
 
-    Node** buckets;
-    U32         numBuckets;
-    U32         itemCount;
-    DataChunker mempool;
+    enum
+    {
+        /// The number of shards.  This must be a power of two.
+        NumShards = 32
+    };
+
+    struct Shard
+    {
+        void*       mutex;
+        Node**      buckets;
+        U32         numBuckets;
+        U32         itemCount;
+        U32         stringBytes;
+        DataChunker mempool;
+    };
+
+    Shard mShards[NumShards];
+
+    /// Picks the shard from the top bits of the scrambled hash, as the
+    /// low bits of the hash are used for the buckets.
+    static U32 getShard(U32 key) { return (key * 0x9E3779B1) >> 27; }
+
+    StringTableEntry insertLocked(Shard& shard, const char* val, U32 key, bool caseSens);
+    StringTableEntry lookupLocked(Shard& shard, const char* val, U32 key, bool caseSens);
+    void             resizeShard(Shard& shard, U32 newSize);
 
 protected:
     static const U32 csm_stInitSize;
@@ -108,6 +135,14 @@ public:
     /// @param  caseSens Determines whether case matters.
     StringTableEntry insertn(const char* string, S32 len, bool caseSens = false);
 
+    /// Insert many strings at once, taking each shard's lock only once.
+    ///
+    /// @param  strings  Strings to add.
+    /// @param  count    Number of strings.
+    /// @param  entries  Receives the entry for each string.
+    /// @param  caseSens Determines whether case matters.
+    void insertBatch(const char* const* strings, U32 count, StringTableEntry* entries, bool caseSens = false);
+
     /// Get a pointer from the string table, NOT adding the string to the table
     /// if it was not already present.
     ///
@@ -124,13 +159,16 @@ public:
     StringTableEntry lookupn(const char* string, S32 len, bool caseSens = false);
 
 
-    /// Resize the StringTable to be able to hold newSize items. This
-    /// is called automatically by the StringTable when the table is
-    /// full past a certain threshhold.
+    /// Resize the StringTable to be able to hold newSize items. Each shard
+    /// is resized automatically by the StringTable when it is full past a
+    /// certain threshhold.
     ///
     /// @param newSize   Number of new items to allocate space for.
     void             resize(const U32 newSize);
 
+    /// Print the entry counts, chain lengths and memory use of the table.
+    void             dumpStats();
+
     /// Hash a string into a U32.
     static U32 hashString(const char* in_pString);
 
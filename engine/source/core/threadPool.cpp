@@ -0,0 +1,221 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#include "core/threadPool.h"
+
+#include "platform/platformThread.h"
+#include "platform/platformMutex.h"
+#include "platform/platformSemaphore.h"
+#include "platform/profiler.h"
+#include "console/console.h"
+
+ThreadPool* ThreadPool::smGlobal = NULL;
+
+//----------------------------------------------------------------------------
+
+ThreadPool::ThreadPool(U32 numThreads)
+{
+    mQueueHead = 0;
+    mShuttingDown = false;
+    mQueueMutex = Mutex::createMutex();
+    mQueueSemaphore = Semaphore::createSemaphore(0);
+
+    for (U32 i = 0; i < numThreads; i++)
+        mThreads.push_back(new Thread(workerMain, this));
+}
+
+ThreadPool::~ThreadPool()
+{
+    Mutex::lockMutex(mQueueMutex);
+    mShuttingDown = true;
+    Mutex::unlockMutex(mQueueMutex);
+
+    // Wake every worker so it can notice the shutdown flag once the
+    // queue has drained.
+    for (U32 i = 0; i < mThreads.size(); i++)
+        Semaphore::releaseSemaphore(mQueueSemaphore);
+
+    for (U32 i = 0; i < mThreads.size(); i++)
+        delete mThreads[i];
+    mThreads.clear();
+
+    Semaphore::destroySemaphore(mQueueSemaphore);
+    Mutex::destroyMutex(mQueueMutex);
+}
+
+//----------------------------------------------------------------------------
+
+bool ThreadPool::popJob(Job& job)
+{
+    MutexHandle handle;
+    handle.lock(mQueueMutex);
+
+    if (mQueueHead >= mQueue.size())
+        return false;
+
+    job = mQueue[mQueueHead++];
+
+    // Reclaim the consumed front of the queue once it has emptied out.
+    if (mQueueHead == mQueue.size())
+    {
+        mQueue.clear();
+        mQueueHead = 0;
+    }
+    return true;
+}
+
+void ThreadPool::workerMain(void* pool)
+{
+    ThreadPool* self = reinterpret_cast<ThreadPool*>(pool);
+
+    while (true)
+    {
+        Semaphore::acquireSemaphore(self->mQueueSemaphore);
+
+        Job job;
+        if (self->popJob(job))
+            job.func(job.data);
+        else if (self->mShuttingDown)
+            return;
+    }
+}
+
+void ThreadPool::queueJob(JobFunction func, void* data)
+{
+    if (mThreads.empty())
+    {
+        func(data);
+        return;
+    }
+
+    Job job;
+    job.func = func;
+    job.data = data;
+
+    Mutex::lockMutex(mQueueMutex);
+    mQueue.push_back(job);
+    Mutex::unlockMutex(mQueueMutex);
+
+    Semaphore::releaseSemaphore(mQueueSemaphore);
+}
+
+//----------------------------------------------------------------------------
+
+void ThreadPool::runRange(RangeJob* job)
+{
+    while (true)
+    {
+        Mutex::lockMutex(job->mutex);
+        U32 index = job->next++;
+        Mutex::unlockMutex(job->mutex);
+
+        if (index >= job->count)
+            break;
+
+        job->func(job->data, index);
+    }
+}
+
+void ThreadPool::releaseRange(RangeJob* job)
+{
+    Mutex::lockMutex(job->mutex);
+    bool last = --job->refCount == 0;
+    Mutex::unlockMutex(job->mutex);
+
+    if (last)
+    {
+        Semaphore::destroySemaphore(job->doneSemaphore);
+        Mutex::destroyMutex(job->mutex);
+        delete job;
+    }
+}
+
+void ThreadPool::rangeWorker(void* rangeJob)
+{
+    RangeJob* job = reinterpret_cast<RangeJob*>(rangeJob);
+
+    // Only help out if the caller is still waiting on the range.
+    Mutex::lockMutex(job->mutex);
+    bool run = !job->closed;
+    if (run)
+        job->started++;
+    Mutex::unlockMutex(job->mutex);
+
+    if (run)
+    {
+        runRange(job);
+        Semaphore::releaseSemaphore(job->doneSemaphore);
+    }
+
+    releaseRange(job);
+}
+
+void ThreadPool::parallelFor(U32 count, RangeFunction func, void* data)
+{
+    if (count == 0)
+        return;
+
+    if (mThreads.empty() || count == 1)
+    {
+        for (U32 i = 0; i < count; i++)
+            func(data, i);
+        return;
+    }
+
+    PROFILE_START(ThreadPool_parallelFor);
+
+    // The calling thread takes a share of the work too, so never wake more
+    // helpers than there are indices left over for them.
+    U32 numHelpers = getMin(U32(mThreads.size()), count - 1);
+
+    RangeJob* job = new RangeJob;
+    job->func = func;
+    job->data = data;
+    job->next = 0;
+    job->count = count;
+    job->started = 0;
+    job->refCount = numHelpers + 1;
+    job->closed = false;
+    job->mutex = Mutex::createMutex();
+    job->doneSemaphore = Semaphore::createSemaphore(0);
+
+    for (U32 i = 0; i < numHelpers; i++)
+        queueJob(rangeWorker, job);
+
+    runRange(job);
+
+    // Every index has been claimed, so helpers which haven't started yet
+    // have nothing left to do.  Wait only for the ones already running.
+    Mutex::lockMutex(job->mutex);
+    job->closed = true;
+    U32 numStarted = job->started;
+    Mutex::unlockMutex(job->mutex);
+
+    for (U32 i = 0; i < numStarted; i++)
+        Semaphore::acquireSemaphore(job->doneSemaphore);
+
+    releaseRange(job);
+
+    PROFILE_END();
+}
+
+//----------------------------------------------------------------------------
+
+void ThreadPool::init()
+{
+    AssertFatal(smGlobal == NULL, "ThreadPool::init - already initialized");
+
+    U32 numCores = Platform::SystemInfo.processor.numLogicalProcessors;
+    U32 numThreads = numCores > 1 ? numCores - 1 : 0;
+
+    smGlobal = new ThreadPool(numThreads);
+    Con::printf("Thread pool: %d worker thread(s)", numThreads);
+}
+
+void ThreadPool::destroy()
+{
+    delete smGlobal;
+    smGlobal = NULL;
+}
@@ -0,0 +1,104 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#ifndef _THREADPOOL_H_
+#define _THREADPOOL_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/tVector.h"
+#endif
+
+class Thread;
+
+/// Fixed set of worker threads fed from a FIFO job queue.
+///
+/// Jobs are plain function/argument pairs so they can be queued from code
+/// that knows nothing about threads.  Work that must finish before the caller
+/// continues should go through parallelFor(), which also puts the calling
+/// thread to work instead of letting it idle on the result.
+///
+/// @code
+///   static void lightSurface(void* data, U32 index)
+///   {
+///      ((Surface*)data)[index].light();
+///   }
+///
+///   ThreadPool::getGlobal()->parallelFor(surfaces.size(), lightSurface, surfaces.address());
+/// @endcode
+class ThreadPool
+{
+public:
+    typedef void (*JobFunction)(void* data);
+    typedef void (*RangeFunction)(void* data, U32 index);
+
+private:
+    struct Job
+    {
+        JobFunction func;
+        void* data;
+    };
+
+    /// Shared by parallelFor() and the helpers it queues.  Helpers can sit
+    /// in the queue behind long jobs, so the caller only waits on the ones
+    /// which started before it ran out of work itself.  The rest find the
+    /// job closed when they finally run, and the last one out frees it.
+    struct RangeJob
+    {
+        RangeFunction func;
+        void* data;
+        U32 next;
+        U32 count;
+        U32 started;      ///< Helpers which joined in before the job closed
+        U32 refCount;     ///< Queued helpers plus the caller
+        bool closed;
+        void* mutex;
+        void* doneSemaphore;
+    };
+
+    Vector<Thread*> mThreads;
+    Vector<Job> mQueue;
+    U32 mQueueHead;
+    void* mQueueMutex;
+    void* mQueueSemaphore;
+    bool mShuttingDown;
+
+    static ThreadPool* smGlobal;
+
+    static void workerMain(void* pool);
+    static void rangeWorker(void* rangeJob);
+    static void runRange(RangeJob* job);
+    static void releaseRange(RangeJob* job);
+
+    bool popJob(Job& job);
+
+public:
+    ThreadPool(U32 numThreads);
+    ~ThreadPool();
+
+    /// Number of worker threads, not counting the caller of parallelFor().
+    U32 getNumThreads() const { return mThreads.size(); }
+
+    /// Queue a job to run on the next free worker. Returns immediately.
+    void queueJob(JobFunction func, void* data);
+
+    /// Call func(data, i) for every i in [0, count), spread across the workers
+    /// and the calling thread.  Blocks until every index has been processed,
+    /// but never on a helper which is still stuck behind other queued jobs.
+    void parallelFor(U32 count, RangeFunction func, void* data);
+
+    /// @name Global pool
+    /// The global pool is sized to the number of logical processors minus one,
+    /// since the main thread joins in on parallelFor().
+    /// @{
+    static void init();
+    static void destroy();
+    static ThreadPool* getGlobal() { return smGlobal; }
+    /// @}
+};
+
+#endif // _THREADPOOL_H_
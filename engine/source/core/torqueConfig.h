@@ -223,6 +223,20 @@
 /// Debug guard requires the Torque Memory manager.
 //#define TORQUE_DEBUG_GUARD
 
+/// Define me to have the Torque Memory Manager serve allocations of up to
+/// 1KB from size class slabs instead of its free block tree.
+///
+/// Each thread keeps its own free list per size class, so small allocations
+/// and frees only take the memory manager's global lock when a thread's list
+/// runs dry or grows too long and a batch of blocks moves to or from the
+/// shared lists.  Larger blocks still come from the tree.  Leak tracking
+/// (FlagCurrentAllocs, DumpUnflaggedAllocs, TORQUE_DEBUG_GUARD) covers slab
+/// blocks too, although with debug guards on every allocation takes the lock
+/// again to keep the allocation count.
+///
+/// The slab allocator requires the Torque Memory manager.
+//#define TORQUE_SLAB_ALLOCATOR
+
 /// Define to enable multiple binds per console function in an actionmap.  
 /// With this, you can bind multiple keys to the same "jump()" function 
 /// for instance.  Without it, you need to declare multiple jump functions
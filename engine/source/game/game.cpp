@@ -386,6 +386,20 @@ ConsoleFunction(lightScene, bool, 1, 3, "(script_function completeCallback=NULL,
     return(SceneLighting::lightScene(callback, flags));
 }
 
+ConsoleFunction(bakeSceneLighting, bool, 1, 2, "(string mode=\"\")"
+    "Light the server's mission and write the lighting cache file before returning.\n\n"
+    "Unlike lightScene this needs no client connection or canvas, so it can be run "
+    "from a dedicated server. Objects which haven't changed since the last lighting "
+    "keep their lightmaps unless mode is \"forceAlways\". Returns true if the mission's "
+    "lighting is up to date.")
+{
+    BitSet32 flags = SceneLighting::ForceWritable;
+    if ((argc > 1) && !dStricmp(argv[1], "forceAlways"))
+        flags = SceneLighting::ForceAlways;
+
+    return(SceneLighting::bakeScene(flags));
+}
+
 //--------------------------------------------------------------------------
 ConsoleFunction(registerLights, void, 1, 1, "()")
 {
@@ -673,6 +673,8 @@ void GameBase::initPersistFields()
 
 void GameBase::consoleInit()
 {
+    Con::addVariable("pref::Server::ParallelTick", TypeBool, &ProcessList::smParallelTick);
+
 #ifdef TORQUE_DEBUG
     Con::addVariable("GameBase::boundingBox", TypeBool, &gShowBoundingBox);
 #endif
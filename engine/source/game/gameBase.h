@@ -295,6 +295,18 @@ public:
     /// @param  move   Move event corresponding to this tick, or NULL.
     virtual void processTick(const Move* move);
 
+    /// Returns true if this object wants prepareTickParallel() called.
+    virtual bool hasParallelTickWork() { return false; }
+
+    /// Gives an object a chance to do tick work that only reads shared state,
+    /// ahead of processTick(), while the process list is in parallel mode.
+    ///
+    /// This is called from a worker thread, concurrently with the same call on
+    /// other objects, so it must only write to state owned by this object.
+    ///
+    /// @see ProcessList::smParallelTick
+    virtual void prepareTickParallel() {}
+
 #ifdef MB_CLIENT_PHYSICS_EVERY_FRAME
     virtual void processPhysicsTick(const Move* move, F32 dt);
 #endif
@@ -219,6 +219,10 @@ Item::Item()
     mCollisionTimeout = 0;
     //   mGenerateShadow = true;
 
+    // Moving and rotating doesn't depend on who we're sending to, so gems and
+    // powerups in view of many clients only get packed once per tick.
+    mSharedPackMask = PositionMask | RotationMask | NoWarpMask | ScaleMask;
+
 #ifdef MARBLE_BLAST
     mPermanent = false;
     mHiddenTimer = 0;
@@ -51,6 +51,7 @@
 #include "game/demoGame.h"
 #include "sim/decalManager.h"
 #include "core/frameAllocator.h"
+#include "core/threadPool.h"
 #include "sceneGraph/detailManager.h"
 #include "game/version.h"
 #include "platform/profiler.h"
@@ -201,6 +202,7 @@ static bool initLibraries()
     TelnetDebugger::create();
 
     Processor::init();
+    ThreadPool::init();
     Math::init();
     Platform::init();    // platform specific initialization
     InteriorInstance::init();
@@ -235,6 +237,7 @@ static void shutdownLibraries()
     //TextureManager::preDestroy();
 
     Platform::shutdown();
+    ThreadPool::destroy();
     TelnetDebugger::destroy();
     TelnetConsole::destroy();
 
@@ -16,6 +16,7 @@
 #include "game/fx/cameraFXMgr.h"
 #include "game/gameConnection.h"
 #include "sfx/sfxSystem.h"
+#include "platform/platformMutex.h"
 
 //----------------------------------------------------------------------------
 
@@ -35,9 +36,8 @@ U32 Marble::smEndPadId = 0;
 bool Marble::smUseEmotives = true;
 #endif
 SimObjectPtr<StaticShape> Marble::smEndPad = NULL;
-Vector<PathedInterior*> Marble::smPathItrVec;
-Vector<Marble*> Marble::marbles;
-ConcretePolyList Marble::polyList;
+void* Marble::smCollisionMutex = NULL;
+bool Marble::smUsePolyCache = true;
 
 #ifdef MB_PHYSICS_SWITCHABLE
 bool Marble::smTrapLaunch = false;
@@ -158,10 +158,23 @@ Marble::Marble()
     mSize = 1.5f;
 
     mCameraPosition = Point3F(0.0f, 0.0f, 0.0f);
+
+    mLastCollisionBox.min.set(0, 0, 0);
+    mLastCollisionBox.max.set(0, 0, 0);
+    mLastCollisionMask = 0;
+    mResetFindObjects = true;
+    mCollisionCountCalls = 0;
+    mCollisionQueryTotal = 0;
+    mCollisionPrefetched = false;
+    mSweepBatchDirty = true;
+    mPolyCacheUseCount = 0;
+    mMoveRecordStream = NULL;
 }
 
 Marble::~Marble()
 {
+    stopMoveRecording();
+
     S32 i;
     for (i = 0; i < PowerUpData::MaxPowerUps; i++)
     {
@@ -179,6 +192,8 @@ Marble::~Marble()
         mTrailEmitter->deleteWhenEmpty();
 
     delete mStencilMaterial;
+
+    clearPolyCache();
 }
 
 void Marble::initPersistFields()
@@ -193,6 +208,12 @@ void Marble::consoleInit()
 {
     Parent::consoleInit();
 
+    if (!smCollisionMutex)
+        smCollisionMutex = Mutex::createMutex();
+
+    Con::addVariable("Marble::UsePolyCache", TypeBool, &Marble::smUsePolyCache);
+    Con::addVariable("Marble::UseSIMDSweep", TypeBool, &SphereSweepBatch::smUseSIMD);
+
 #ifdef MB_PHYSICS_SWITCHABLE
     Con::addVariable("Pref::Marble::EnableTrapLaunch", TypeBool, &Marble::smTrapLaunch);
 #endif
@@ -1224,14 +1245,16 @@ bool Marble::updatePadState()
         float in_rRadius;
         in_rRadius = (box.max - boxCenter).len();
         SphereF sphere(boxCenter, in_rRadius);
-        polyList.clear();
-        mPadPtr->buildPolyList(&Marble::polyList, box, sphere);
-        if (!polyList.mPolyList.empty())
+        mPolyList.clear();
+        mSweepBatchDirty = true;
+        mCollisionPrefetched = false;
+        mPadPtr->buildPolyList(&mPolyList, box, sphere);
+        if (!mPolyList.mPolyList.empty())
         {
             int i = 0;
-            for (i = 0; i < Marble::polyList.mPolyList.size(); i++) 
+            for (i = 0; i < mPolyList.mPolyList.size(); i++) 
             {
-                auto& poly = Marble::polyList.mPolyList[i];
+                auto& poly = mPolyList.mPolyList[i];
 
                 if (mDot(poly.plane, upDir * -10) < 0.0)
                 {
@@ -1240,7 +1263,7 @@ bool Marble::updatePadState()
                         break;
                 }
             }
-            if (i >= Marble::polyList.mPolyList.size()) 
+            if (i >= mPolyList.mPolyList.size()) 
             {
                 this->mOnPad = false;
                 result = false;
@@ -2158,6 +2181,9 @@ void Marble::processTick(const Move* move)
     else
         newMove = &NullMove;
 
+    if (mMoveRecordStream && !isGhost())
+        recordMove(newMove);
+
 #ifndef MB_CLIENT_PHYSICS_EVERY_FRAME
     processMoveTriggers(newMove);
 #endif
@@ -18,6 +18,13 @@
 #include "collision/concretePolyList.h"
 #endif
 
+#ifndef _OBJECTSPACEPOLYLIST_H_
+#include "collision/objectSpacePolyList.h"
+#endif
+#ifndef _SPHERESWEEPBATCH_H_
+#include "collision/sphereSweepBatch.h"
+#endif
+
 #ifndef _H_PATHEDINTERIOR
 #include "interior/pathedInterior.h"
 #endif
@@ -46,6 +53,7 @@ extern Point3F gMarbleSideDir;
 //#define CheckNANAngp(c) { CheckNAN(c->axis.x) CheckNAN(c->axis.y) CheckNAN(c->axis.z) CheckNAN(c->angle) }
 
 class MarbleData;
+class Stream;
 
 class Marble : public ShapeBase
 {
@@ -153,6 +161,19 @@ private:
         NetObject* object;
     };
 
+    /// Interior polys extracted for one object space region of one object,
+    /// grouped by convex hull.  They are kept in object space, so an object
+    /// that moves (a pathed interior, or an interior dragged in the editor)
+    /// only needs them re-transformed rather than extracted again.
+    struct PolyCacheEntry
+    {
+        SimObjectPtr<SceneObject> object;
+        Box3F region;
+        Point3F scale;
+        U32 lastUsed;
+        ObjectSpacePolyList polys;
+    };
+
     struct PowerUpState
     {
         bool active;
@@ -232,6 +253,51 @@ private:
 
     Point3F mCameraPosition;
 
+    // Collision working set.  Every marble gathers into its own lists so the
+    // result never depends on which marble was processed before it.
+    ConcretePolyList mPolyList;
+    Vector<Marble*> mNearbyMarbles;
+    Vector<PathedInterior*> mPathItrVec;
+    Vector<Marble::MaterialCollision> mMaterialCollisions;
+    SimpleQueryList mCollisionQueryList;
+    Box3F mLastCollisionBox;
+    U32 mLastCollisionMask;
+    bool mResetFindObjects;
+    U32 mCollisionCountCalls;
+
+    // Every rebuild this marble has done.  Unlike mCollisionCountCalls
+    // it is never reset, so benchmarks can take differences of it.
+    U32 mCollisionQueryTotal;
+
+    // Set by prepareTickParallel() when mPolyList already holds the
+    // working set advancePhysics() is about to ask for.
+    bool mCollisionPrefetched;
+    Box3F mPrefetchBox;
+
+    // The objects the prefetched polys came from.  A marble ticked earlier
+    // can delete or move any of them, so they are checked before use.
+    struct PrefetchSource
+    {
+        SceneObject* object;
+        SimObjectId id;
+        MatrixF transform;
+        Point3F scale;
+    };
+    Vector<PrefetchSource> mPrefetchSources;
+
+    // SoA copy of mPolyList for testMove(), rebuilt whenever mPolyList has
+    // been cleared and refilled.
+    SphereSweepBatch mSweepBatch;
+    bool mSweepBatchDirty;
+
+    Vector<PolyCacheEntry*> mPolyCache;
+    U32 mPolyCacheUseCount;
+    Vector<U16> mPolyCacheHulls;
+
+    /// Server side move recording, for replaying through advancePhysics()
+    /// with benchPhysicsReplay().
+    Stream* mMoveRecordStream;
+
 public:
     DECLARE_CONOBJECT(Marble);
 
@@ -315,6 +381,8 @@ public:
     void processItemsAndTriggers(const Point3F& startPos, const Point3F& endPos);
     void setPowerUpId(U32 id, bool reset);
     virtual void processTick(const Move* move);
+    virtual bool hasParallelTickWork() { return true; }
+    virtual void prepareTickParallel();
 
 #ifdef MB_CLIENT_PHYSICS_EVERY_FRAME
     virtual void processPhysicsTick(const Move* move, F32 dt);
@@ -332,15 +400,21 @@ public:
     bool computeMoveForces(Point3D& aControl, Point3D& desiredOmega, const Move* move);
     void velocityCancel(bool surfaceSlide, bool noBounce, bool& bouncedYet, bool& stoppedPaths, Vector<PathedInterior*>& pitrVec);
     Point3D getExternalForces(const Move* move, F64 timeStep);
+    void getTickCollisionBox(U32 timeDelta, Box3F& box);
     void advancePhysics(const Move* move, U32 timeDelta);
 
     // Marble Collision
     void clearObjectsAndPolys();
-    void findObjectsAndPolys(U32 collisionMask, const Box3F& testBox, bool testPIs);
+    /// If queryMutex is set, it is held around the Container query and any
+    /// non-interior buildPolyList() calls.
+    void findObjectsAndPolys(U32 collisionMask, const Box3F& testBox, bool testPIs, void* queryMutex = NULL);
     bool testMove(Point3D velocity, Point3D& position, F64& deltaT, F64 radius, U32 collisionMask, bool testPIs);
     void findContacts(U32 contactMask, const Point3D* inPos, const F32* inRad);
     void computeFirstPlatformIntersect(F64& dt, Vector<PathedInterior*>& pitrVec);
     void resetObjectsAndPolys(U32 collisionMask, const Box3F& testBox);
+    void buildCachedPolyList(SceneObject* obj, const Box3F& box);
+    void clearPolyCache();
+    U32 getCollisionCountCalls() const { return mCollisionCountCalls; }
 
     // Marble Camera
     bool moveCamera(Point3F start, Point3F end, Point3F& result, U32 maxIterations, F32 timeStep);
@@ -354,11 +428,48 @@ public:
     void setPlatformsForCamera(const Point3F& marblePos, const Point3F& startCam, const Point3F& endCam);
     virtual void getCameraTransform(F32* pos, MatrixF* mat);
 
+    // Marble Replay
+    struct ReplayState
+    {
+        Point3D position;
+        Point3D velocity;
+        Point3D omega;
+        QuatF gravityFrame;
+        F32 mouseX;
+        F32 mouseY;
+        F32 lastYaw;
+        bool centeringCamera;
+        F32 radsLeftToCenter;
+        F32 radsStartingToCenter;
+        U32 mode;
+    };
+
+    struct ReplayResult
+    {
+        U32 ticks;
+        U32 iterations;
+        F64 nsPerTick;
+        U32 collisionQueries;    ///< findObjectsAndPolys() rebuilds per iteration
+        U32 checksum;            ///< CRC of the final physics state
+        bool deterministic;      ///< Every iteration ended in the same state
+    };
+
+    bool startMoveRecording(const char* fileName);
+    void stopMoveRecording();
+    bool isRecordingMoves() const { return mMoveRecordStream != NULL; }
+    void recordMove(const Move* move);
+    bool benchPhysicsReplay(const char* fileName, U32 iterations, ReplayResult& result);
+
     static U32 smEndPadId;
     static SimObjectPtr<StaticShape> smEndPad;
-    static Vector<PathedInterior*> smPathItrVec;
-    static Vector<Marble*> marbles;
-    static ConcretePolyList polyList;
+
+    /// Guards the Container queries and non-interior buildPolyList() calls
+    /// made while gathering collision polys from prepareTickParallel().
+    /// Interior queries are reentrant and run outside it.
+    static void* smCollisionMutex;
+
+    /// Reuse extracted interior polys across queries and ticks.
+    static bool smUsePolyCache;
 
 #ifdef MBXP_EMOTIVES
     static bool smUseEmotives;
@@ -372,6 +483,10 @@ private:
     virtual void setTransform(const MatrixF& mat);
     void renderShadowVolumes(SceneState* state);
 
+    // Marble Replay
+    void getReplayState(ReplayState& state);
+    void setReplayState(const ReplayState& state);
+
     // Marble Collision
     bool pointWithinPoly(const ConcretePolyList::Poly& poly, const Point3F& point);
     bool pointWithinPolyZ(const ConcretePolyList::Poly& poly, const Point3F& point, const Point3F& upDir);
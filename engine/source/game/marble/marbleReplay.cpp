@@ -0,0 +1,294 @@
+//-----------------------------------------------------------------------------
+// Torque Shader Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#include "marble.h"
+
+#include "core/resManager.h"
+#include "core/crc.h"
+#include "math/mathIO.h"
+#include "platform/profiler.h"
+
+//----------------------------------------------------------------------------
+// Move recordings
+//
+// A recording is the marble's physics state at the point recording started,
+// followed by every move the server fed to processTick() from then on:
+//
+//    U32 magic, U32 version, state, move, move, ...
+//
+// benchPhysicsReplay() feeds the moves straight into processCameraMove() and
+// advancePhysics(), skipping items, triggers and powerups so that each pass
+// over the recording starts from and ends in exactly the same state.
+
+static const U32 csReplayMagic = 0x5052424D; // 'MBRP'
+static const U32 csReplayVersion = 1;
+
+static void writeReplayMove(Stream* stream, const Move* move)
+{
+    stream->write(move->x);
+    stream->write(move->y);
+    stream->write(move->z);
+    stream->write(move->yaw);
+    stream->write(move->pitch);
+    stream->write(move->roll);
+
+    for (U32 i = 0; i < MaxTriggerKeys; i++)
+        stream->write(move->trigger[i]);
+
+    stream->write(move->deviceIsKeyboardMouse);
+    stream->write(move->autoCenterCamera);
+    stream->write(move->freeLook);
+
+    stream->write(move->horizontalDeadZone);
+    stream->write(move->verticalDeadZone);
+    stream->write(move->cameraAccelSpeed);
+    stream->write(move->cameraSensitivityHorizontal);
+    stream->write(move->cameraSensitivityVertical);
+}
+
+static bool readReplayMove(Stream* stream, Move* move)
+{
+    *move = NullMove;
+
+    stream->read(&move->x);
+    stream->read(&move->y);
+    stream->read(&move->z);
+    stream->read(&move->yaw);
+    stream->read(&move->pitch);
+    stream->read(&move->roll);
+
+    for (U32 i = 0; i < MaxTriggerKeys; i++)
+        stream->read(&move->trigger[i]);
+
+    stream->read(&move->deviceIsKeyboardMouse);
+    stream->read(&move->autoCenterCamera);
+    stream->read(&move->freeLook);
+
+    stream->read(&move->horizontalDeadZone);
+    stream->read(&move->verticalDeadZone);
+    stream->read(&move->cameraAccelSpeed);
+    stream->read(&move->cameraSensitivityHorizontal);
+    return stream->read(&move->cameraSensitivityVertical);
+}
+
+static void writeReplayState(Stream* stream, const Marble::ReplayState& state)
+{
+    mathWrite(*stream, state.position);
+    mathWrite(*stream, state.velocity);
+    mathWrite(*stream, state.omega);
+    mathWrite(*stream, state.gravityFrame);
+    stream->write(state.mouseX);
+    stream->write(state.mouseY);
+    stream->write(state.lastYaw);
+    stream->write(state.centeringCamera);
+    stream->write(state.radsLeftToCenter);
+    stream->write(state.radsStartingToCenter);
+    stream->write(state.mode);
+}
+
+static bool readReplayState(Stream* stream, Marble::ReplayState& state)
+{
+    mathRead(*stream, &state.position);
+    mathRead(*stream, &state.velocity);
+    mathRead(*stream, &state.omega);
+    mathRead(*stream, &state.gravityFrame);
+    stream->read(&state.mouseX);
+    stream->read(&state.mouseY);
+    stream->read(&state.lastYaw);
+    stream->read(&state.centeringCamera);
+    stream->read(&state.radsLeftToCenter);
+    stream->read(&state.radsStartingToCenter);
+    return stream->read(&state.mode);
+}
+
+//----------------------------------------------------------------------------
+
+void Marble::getReplayState(ReplayState& state)
+{
+    state.position = mPosition;
+    state.velocity = mVelocity;
+    state.omega = mOmega;
+    state.gravityFrame = mGravityFrame;
+    state.mouseX = mMouseX;
+    state.mouseY = mMouseY;
+    state.lastYaw = mLastYaw;
+    state.centeringCamera = mCenteringCamera;
+    state.radsLeftToCenter = mRadsLeftToCenter;
+    state.radsStartingToCenter = mRadsStartingToCenter;
+    state.mode = mMode;
+}
+
+void Marble::setReplayState(const ReplayState& state)
+{
+    mVelocity = state.velocity;
+    mOmega = state.omega;
+    mSinglePrecision.mVelocity = mVelocity;
+    mSinglePrecision.mOmega = mOmega;
+    setPosition(state.position, true);
+
+    mGravityFrame = state.gravityFrame;
+    mGravityRenderFrame = state.gravityFrame;
+    mMouseX = state.mouseX;
+    mMouseY = state.mouseY;
+    mLastYaw = state.lastYaw;
+    mCenteringCamera = state.centeringCamera;
+    mRadsLeftToCenter = state.radsLeftToCenter;
+    mRadsStartingToCenter = state.radsStartingToCenter;
+    mMode = state.mode;
+
+    mContacts.clear();
+    clearObjectsAndPolys();
+}
+
+bool Marble::startMoveRecording(const char* fileName)
+{
+    stopMoveRecording();
+
+    Stream* fs = NULL;
+    if (!ResourceManager->openFileForWrite(fs, fileName))
+        return false;
+
+    ReplayState state;
+    getReplayState(state);
+
+    fs->write(csReplayMagic);
+    fs->write(csReplayVersion);
+    writeReplayState(fs, state);
+
+    mMoveRecordStream = fs;
+    return true;
+}
+
+void Marble::stopMoveRecording()
+{
+    if (mMoveRecordStream)
+    {
+        delete mMoveRecordStream;
+        mMoveRecordStream = NULL;
+    }
+}
+
+void Marble::recordMove(const Move* move)
+{
+    writeReplayMove(mMoveRecordStream, move);
+}
+
+bool Marble::benchPhysicsReplay(const char* fileName, U32 iterations, ReplayResult& result)
+{
+    Stream* stream = ResourceManager->openStream(fileName);
+    if (!stream)
+        return false;
+
+    U32 magic = 0, version = 0;
+    stream->read(&magic);
+    stream->read(&version);
+    if (magic != csReplayMagic || version != csReplayVersion)
+    {
+        ResourceManager->closeStream(stream);
+        return false;
+    }
+
+    ReplayState start;
+    bool ok = readReplayState(stream, start);
+
+    Vector<Move> moves;
+    Move move;
+    while (ok && readReplayMove(stream, &move))
+        moves.push_back(move);
+
+    ResourceManager->closeStream(stream);
+    if (!ok || moves.empty())
+        return false;
+
+    if (iterations == 0)
+        iterations = 1;
+
+    ReplayState saved;
+    getReplayState(saved);
+
+    result.ticks = moves.size();
+    result.iterations = iterations;
+    result.deterministic = true;
+    result.checksum = 0;
+
+    U32 startQueries = mCollisionQueryTotal;
+    U64 startTime = Platform::getPerformanceCounter();
+
+    PROFILE_START(Marble_benchPhysicsReplay);
+
+    for (U32 i = 0; i < iterations; i++)
+    {
+        setReplayState(start);
+
+        for (U32 j = 0; j < moves.size(); j++)
+        {
+            processCameraMove(&moves[j]);
+            advancePhysics(&moves[j], TickMs);
+        }
+
+        ReplayState end;
+        getReplayState(end);
+        U32 checksum = calculateCRC(&end.position, sizeof(Point3D));
+        checksum = calculateCRC(&end.velocity, sizeof(Point3D), checksum);
+        checksum = calculateCRC(&end.omega, sizeof(Point3D), checksum);
+        checksum = calculateCRC(&end.mouseX, sizeof(F32), checksum);
+        checksum = calculateCRC(&end.mouseY, sizeof(F32), checksum);
+
+        if (i == 0)
+            result.checksum = checksum;
+        else if (checksum != result.checksum)
+            result.deterministic = false;
+    }
+
+    PROFILE_END();
+
+    U64 elapsed = Platform::getPerformanceCounter() - startTime;
+    F64 elapsedNs = F64(elapsed) * 1000000000.0 / F64(Platform::getPerformanceFrequency());
+
+    result.nsPerTick = elapsedNs / (F64(moves.size()) * iterations);
+    result.collisionQueries = (mCollisionQueryTotal - startQueries) / iterations;
+
+    setReplayState(saved);
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+ConsoleMethod(Marble, startMoveRecording, bool, 3, 3, "(string fileName) Record every move this marble processes on the server.")
+{
+    char fileName[1024];
+    Con::expandScriptFilename(fileName, sizeof(fileName), argv[2]);
+    return object->startMoveRecording(fileName);
+}
+
+ConsoleMethod(Marble, stopMoveRecording, void, 2, 2, "()")
+{
+    object->stopMoveRecording();
+}
+
+ConsoleMethod(Marble, benchPhysicsReplay, const char*, 3, 4, "(string fileName, int iterations=1)"
+              "Replay a move recording through the marble physics and report the cost per tick. "
+              "Returns \"nsPerTick collisionQueries checksum deterministic\", or \"\" if the file could not be read.")
+{
+    char fileName[1024];
+    Con::expandScriptFilename(fileName, sizeof(fileName), argv[2]);
+
+    U32 iterations = argc > 3 ? dAtoi(argv[3]) : 1;
+
+    Marble::ReplayResult result;
+    if (!object->benchPhysicsReplay(fileName, iterations, result))
+    {
+        Con::errorf("benchPhysicsReplay: unable to read move recording %s", fileName);
+        return "";
+    }
+
+    Con::printf("Physics replay: %d ticks x %d iterations, %.0f ns/tick, %d collision queries, checksum %08x%s",
+        result.ticks, result.iterations, result.nsPerTick, result.collisionQueries, result.checksum,
+        result.deterministic ? "" : " (NOT DETERMINISTIC)");
+
+    char* ret = Con::getReturnBuffer(128);
+    dSprintf(ret, 128, "%.0f %d %08x %d", result.nsPerTick, result.collisionQueries, result.checksum, result.deterministic);
+    return ret;
+}
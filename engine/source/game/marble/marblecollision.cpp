@@ -6,20 +6,17 @@
 #include "marble.h"
 
 #include "materials/material.h"
+#include "interior/interiorInstance.h"
 #include "math/mathUtils.h"
 
 //----------------------------------------------------------------------------
 
-static Box3F sgLastCollisionBox;
-static U32 sgLastCollisionMask;
-static bool sgResetFindObjects;
-static U32 sgCountCalls;
-
 void Marble::clearObjectsAndPolys()
 {
-    sgResetFindObjects = true;
-	sgLastCollisionBox.min.set(0, 0, 0);
-	sgLastCollisionBox.max.set(0, 0, 0);
+    mResetFindObjects = true;
+    mCollisionPrefetched = false;
+	mLastCollisionBox.min.set(0, 0, 0);
+	mLastCollisionBox.max.set(0, 0, 0);
 }
 
 bool Marble::pointWithinPoly(const ConcretePolyList::Poly& poly, const Point3F& point)
@@ -27,11 +24,11 @@ bool Marble::pointWithinPoly(const ConcretePolyList::Poly& poly, const Point3F&
     if (poly.vertexCount == 0)
         return true;
 
-    Point3F lastVert = Marble::polyList.mVertexList[Marble::polyList.mIndexList[poly.vertexStart + poly.vertexCount - 1]];
+    Point3F lastVert = mPolyList.mVertexList[mPolyList.mIndexList[poly.vertexStart + poly.vertexCount - 1]];
 
     for (int i = 0; i < poly.vertexCount; i++)
     {
-        Point3F& v = Marble::polyList.mVertexList[Marble::polyList.mIndexList[i + poly.vertexStart]];
+        Point3F& v = mPolyList.mVertexList[mPolyList.mIndexList[i + poly.vertexStart]];
         PlaneF p(v + poly.plane, v, lastVert);
         lastVert = v;
         if (p.distToPlane(point) < 0.0f)
@@ -45,11 +42,11 @@ bool Marble::pointWithinPolyZ(const ConcretePolyList::Poly& poly, const Point3F&
     if (poly.vertexCount == 0)
         return true;
 
-    Point3F lastVert = Marble::polyList.mVertexList[Marble::polyList.mIndexList[poly.vertexStart + poly.vertexCount - 1]];
+    Point3F lastVert = mPolyList.mVertexList[mPolyList.mIndexList[poly.vertexStart + poly.vertexCount - 1]];
     
     for (int i = 0; i < poly.vertexCount; i++)
     {
-        Point3F& v = Marble::polyList.mVertexList[Marble::polyList.mIndexList[i + poly.vertexStart]];
+        Point3F& v = mPolyList.mVertexList[mPolyList.mIndexList[i + poly.vertexStart]];
         PlaneF p(v + upDir, v, lastVert);
         lastVert = v;
         if (p.distToPlane(point) < -0.003f)
@@ -58,50 +55,191 @@ bool Marble::pointWithinPolyZ(const ConcretePolyList::Poly& poly, const Point3F&
     return true;
 }
 
-void Marble::findObjectsAndPolys(U32 collisionMask, const Box3F& testBox, bool testPIs)
+void Marble::findObjectsAndPolys(U32 collisionMask, const Box3F& testBox, bool testPIs, void* queryMutex)
 {
-    if (collisionMask != sgLastCollisionMask || !sgLastCollisionBox.isContained(testBox) || sgResetFindObjects || !smPathItrVec.empty())
+    if (collisionMask != mLastCollisionMask || !mLastCollisionBox.isContained(testBox) || mResetFindObjects || !mPathItrVec.empty())
     {
-        ++sgCountCalls;
-		if (sgResetFindObjects || !smPathItrVec.empty())
+        ++mCollisionCountCalls;
+        ++mCollisionQueryTotal;
+        mCollisionPrefetched = false;
+		if (mResetFindObjects || !mPathItrVec.empty())
 		{
-			sgLastCollisionBox.min = testBox.min - 0.5f;
-			sgLastCollisionBox.max = testBox.max + 0.5f;
+			mLastCollisionBox.min = testBox.min - 0.5f;
+			mLastCollisionBox.max = testBox.max + 0.5f;
 		} else
 		{
-			sgLastCollisionBox.min.setMin(testBox.min - 0.5f);
-		    sgLastCollisionBox.max.setMax(testBox.max + 0.5f);
+			mLastCollisionBox.min.setMin(testBox.min - 0.5f);
+		    mLastCollisionBox.max.setMax(testBox.max + 0.5f);
 		}
 
-        sgLastCollisionMask = collisionMask;
-        sgResetFindObjects = false;
+        mLastCollisionMask = collisionMask;
+        mResetFindObjects = false;
 
-		Point3D pos = (sgLastCollisionBox.max + sgLastCollisionBox.min) * 0.5f;
-		Point3F test = sgLastCollisionBox.max - sgLastCollisionBox.min;
+		Point3D pos = (mLastCollisionBox.max + mLastCollisionBox.min) * 0.5f;
+		Point3F test = mLastCollisionBox.max - mLastCollisionBox.min;
 		SphereF sphere(pos, test.len() * 0.5f);
 		
-		static SimpleQueryList sql;
-		sql.mList.clear();
-		mContainer->findObjects(sgLastCollisionBox, collisionMask, SimpleQueryList::insertionCallback, &sql);
-		polyList.clear();
-		marbles.clear();
-
-		for (S32 i = 0; i < sql.mList.size(); i++)
+		mCollisionQueryList.mList.clear();
+		if (queryMutex)
+		    Mutex::lockMutex(queryMutex);
+		mContainer->findObjects(mLastCollisionBox, collisionMask, SimpleQueryList::insertionCallback, &mCollisionQueryList);
+		if (queryMutex)
+		    Mutex::unlockMutex(queryMutex);
+		mPolyList.clear();
+		mSweepBatchDirty = true;
+		mNearbyMarbles.clear();
+
+		for (S32 i = 0; i < mCollisionQueryList.mList.size(); i++)
 		{
-		    SceneObject* obj = sql.mList[i];
+		    SceneObject* obj = mCollisionQueryList.mList[i];
 
-		    if ((sql.mList[i]->getTypeMask() & PlayerObjectType) == 0)
+		    if ((obj->getTypeMask() & PlayerObjectType) == 0)
 		    {
 				if (testPIs || !dynamic_cast<PathedInterior*>(obj))
-				    obj->buildPolyList(&polyList, sgLastCollisionBox, sphere);
+				{
+				    // Interior queries are reentrant, anything else has to
+				    // hold the query mutex.
+				    bool isInterior = (obj->getTypeMask() & InteriorObjectType) != 0;
+				    if (smUsePolyCache && isInterior)
+				        buildCachedPolyList(obj, mLastCollisionBox);
+				    else if (queryMutex && !isInterior)
+				    {
+				        Mutex::lockMutex(queryMutex);
+				        obj->buildPolyList(&mPolyList, mLastCollisionBox, sphere);
+				        Mutex::unlockMutex(queryMutex);
+				    }
+				    else
+				        obj->buildPolyList(&mPolyList, mLastCollisionBox, sphere);
+				}
 		    } else if (obj != this)
 		    {
-		        marbles.push_back(reinterpret_cast<Marble*>(obj));
+		        mNearbyMarbles.push_back(reinterpret_cast<Marble*>(obj));
 		    }
 		}
     }
 }
 
+//----------------------------------------------------------------------------
+
+// Cached regions are snapped outward to this grid in object space, so that the
+// polys a query gets back depend only on the query box and never on which
+// regions happened to be cached before it.
+static const F32 sPolyCacheGridSize = 8.0f;
+static const F32 sPolyCacheMargin = 1.0f;
+static const U32 sPolyCacheMaxEntries = 8;
+
+void Marble::clearPolyCache()
+{
+    for (S32 i = 0; i < mPolyCache.size(); i++)
+        delete mPolyCache[i];
+    mPolyCache.clear();
+}
+
+static Interior* getCollisionInterior(SceneObject* obj)
+{
+    if (InteriorInstance* instance = dynamic_cast<InteriorInstance*>(obj))
+        return bool(instance->getResource()) ? instance->getDetailLevel(0) : NULL;
+    if (PathedInterior* pathed = dynamic_cast<PathedInterior*>(obj))
+        return pathed->getInterior();
+    return NULL;
+}
+
+void Marble::buildCachedPolyList(SceneObject* obj, const Box3F& box)
+{
+    Interior* interior = getCollisionInterior(obj);
+    if (!interior)
+        return;
+
+    const Point3F& scale = obj->getScale();
+
+    // Query box in the object's unscaled space, which is the space the
+    // interior emits its points in.
+    Box3F localBox = box;
+    obj->getWorldTransform().mul(localBox);
+    Point3F a(localBox.min.x / scale.x, localBox.min.y / scale.y, localBox.min.z / scale.z);
+    Point3F b(localBox.max.x / scale.x, localBox.max.y / scale.y, localBox.max.z / scale.z);
+    localBox.min = a;
+    localBox.max = a;
+    localBox.min.setMin(b);
+    localBox.max.setMax(b);
+
+    Box3F region;
+    region.min.x = mFloor((localBox.min.x - sPolyCacheMargin) / sPolyCacheGridSize) * sPolyCacheGridSize;
+    region.min.y = mFloor((localBox.min.y - sPolyCacheMargin) / sPolyCacheGridSize) * sPolyCacheGridSize;
+    region.min.z = mFloor((localBox.min.z - sPolyCacheMargin) / sPolyCacheGridSize) * sPolyCacheGridSize;
+    region.max.x = mCeil((localBox.max.x + sPolyCacheMargin) / sPolyCacheGridSize) * sPolyCacheGridSize;
+    region.max.y = mCeil((localBox.max.y + sPolyCacheMargin) / sPolyCacheGridSize) * sPolyCacheGridSize;
+    region.max.z = mCeil((localBox.max.z + sPolyCacheMargin) / sPolyCacheGridSize) * sPolyCacheGridSize;
+
+    PolyCacheEntry* entry = NULL;
+    PolyCacheEntry* oldest = NULL;
+    for (S32 i = 0; i < mPolyCache.size(); i++)
+    {
+        PolyCacheEntry* e = mPolyCache[i];
+        if ((SceneObject*)e->object == obj && e->scale == scale && e->region.min == region.min && e->region.max == region.max)
+        {
+            entry = e;
+            break;
+        }
+
+        // Entries for deleted objects are the first to go
+        if (!oldest || e->object.isNull() || (!oldest->object.isNull() && e->lastUsed < oldest->lastUsed))
+            oldest = e;
+    }
+
+    if (!entry)
+    {
+        if (mPolyCache.size() < sPolyCacheMaxEntries)
+        {
+            entry = new PolyCacheEntry;
+            mPolyCache.push_back(entry);
+        }
+        else
+            entry = oldest;
+
+        entry->object = obj;
+        entry->region = region;
+        entry->scale = scale;
+        entry->polys.clear();
+
+        Box3F worldRegion = region;
+        worldRegion.min.convolve(scale);
+        worldRegion.max.convolve(scale);
+        obj->getTransform().mul(worldRegion);
+
+        // Record every hull the region touches, in the order the interior
+        // exports them.
+        Interior::HullQuery regionQuery;
+        interior->setupHullQuery(regionQuery, &entry->polys, worldRegion, obj->getWorldTransform(), scale);
+
+        mPolyCacheHulls.clear();
+        interior->getQueryHulls(regionQuery, mPolyCacheHulls);
+        for (S32 i = 0; i < mPolyCacheHulls.size(); i++)
+        {
+            entry->polys.beginGroup(mPolyCacheHulls[i]);
+            interior->exportHullPolys(&entry->polys, mPolyCacheHulls[i]);
+        }
+    }
+
+    entry->lastUsed = ++mPolyCacheUseCount;
+
+    mPolyList.setTransform(&obj->getTransform(), scale);
+    mPolyList.setObject(obj);
+
+    // Pick the hulls exactly as a direct buildPolyList() would.  Its hulls
+    // are a subset of the region's, and both come out in the order of the
+    // interior's hull tree, so the polys match a direct query one for one.
+    Interior::HullQuery query;
+    interior->setupHullQuery(query, &mPolyList, box, obj->getWorldTransform(), scale);
+
+    const ObjectSpacePolyList::GroupList& hulls = entry->polys.mGroupList;
+    for (U32 i = 0; i < hulls.size(); i++)
+    {
+        if (interior->isHullInQuery(query, hulls[i].key))
+            entry->polys.replayGroup(&mPolyList, i);
+    }
+}
+
 bool Marble::testMove(Point3D velocity, Point3D& position, F64& deltaT, F64 radius, U32 collisionMask, bool testPIs)
 {
 	F64 velLen = velocity.len();
@@ -150,9 +288,9 @@ bool Marble::testMove(Point3D velocity, Point3D& position, F64& deltaT, F64 radi
 	{
         Point3F nextPos = position + deltaPosition;
         
-        for (S32 i = 0; i < marbles.size(); i++)
+        for (S32 i = 0; i < mNearbyMarbles.size(); i++)
         {
-            Marble* other = marbles[i];
+            Marble* other = mNearbyMarbles[i];
 
             Point3F otherPos = other->getPosition();
 
@@ -192,47 +330,49 @@ bool Marble::testMove(Point3D velocity, Point3D& position, F64& deltaT, F64 radi
 	}
     
     // Marble on Platform collision
-    if (!polyList.mPolyList.empty())
+    if (!mPolyList.mPolyList.empty())
     {
         ConcretePolyList::Poly* poly;
 
-        for (S32 index = 0; index < polyList.mPolyList.size(); index++)
+        if (mSweepBatchDirty)
         {
-            poly = &polyList.mPolyList[index];
+            mSweepBatch.build(mPolyList);
+            mSweepBatchDirty = false;
+        }
 
-            PlaneD polyPlane = poly->plane;
+        // Plane distance and time of impact for every poly at once.
+        mSweepBatch.setSweep(velocityDir, velocity, position, radius);
+        mSweepBatch.cullPlanes(0, finalPosition);
+        Point3D culledPosition = finalPosition;
+
+        for (S32 index = 0; index < mPolyList.mPolyList.size(); index++)
+        {
+            poly = &mPolyList.mPolyList[index];
+
+            // The plane culling depends on where we end up, so redo it for the
+            // remaining polys whenever an earlier one moved that.
+            if (finalPosition != culledPosition)
+            {
+                mSweepBatch.cullPlanes(index, finalPosition);
+                culledPosition = finalPosition;
+            }
 
             // If we're going the wrong direction or not going to touch the plane, ignore...
-            if (mDot(polyPlane, velocityDir) > -0.001 || mDot(polyPlane, finalPosition) + polyPlane.d > radius)
+            if (!mSweepBatch.isCandidate(index))
                 continue;
 
+            PlaneD polyPlane = poly->plane;
+
             // Time until collision with the plane
-            F64 collisionTime = (radius - (mDot(polyPlane, position) + polyPlane.d)) / mDot(polyPlane, velocity);
+            F64 collisionTime = mSweepBatch.getCollisionTime(index);
 
             // Are we going to touch the plane during this time step?
             if (collisionTime >= 0.0 && finalT >= collisionTime)
             {
-                U32 lastVertIndex = polyList.mIndexList[poly->vertexCount - 1 + poly->vertexStart];
-                Point3F lastVert = polyList.mVertexList[lastVertIndex];
-
                 Point3D collisionPos = velocity * collisionTime + position;
 
-                U32 i;
-                for (i = 0; i < poly->vertexCount; i++)
-                {
-                    Point3F thisVert = polyList.mVertexList[polyList.mIndexList[i + poly->vertexStart]];
-                    if (thisVert != lastVert)
-                    {
-                        PlaneD edgePlane(thisVert + polyPlane, thisVert, lastVert);
-                        lastVert = thisVert;
-
-                        // if we are on the far side of the edge
-                        if (mDot(edgePlane, collisionPos) + edgePlane.d < 0.0)
-                            break;
-                    }
-                }
-
-                bool isOnEdge = i != poly->vertexCount;
+                // if we are on the far side of any edge
+                bool isOnEdge = mSweepBatch.isOutsideEdges(index, collisionPos);
 
                 // If we're inside the poly, just get the position
                 if (!isOnEdge)
@@ -247,7 +387,7 @@ bool Marble::testMove(Point3D velocity, Point3D& position, F64& deltaT, F64 radi
 
             // We *might* be colliding with an edge
 
-            Point3F lastVert = polyList.mVertexList[polyList.mIndexList[poly->vertexCount - 1 + poly->vertexStart]];
+            Point3F lastVert = mPolyList.mVertexList[mPolyList.mIndexList[poly->vertexCount - 1 + poly->vertexStart]];
 
             if (poly->vertexCount == 0)
                 continue;
@@ -256,7 +396,7 @@ bool Marble::testMove(Point3D velocity, Point3D& position, F64& deltaT, F64 radi
 
             for (S32 iter = 0; iter < poly->vertexCount; iter++)
             {
-                Point3D thisVert = polyList.mVertexList[polyList.mIndexList[iter + poly->vertexStart]];
+                Point3D thisVert = mPolyList.mVertexList[mPolyList.mIndexList[iter + poly->vertexStart]];
 
                 Point3D vertDiff = lastVert - thisVert;
                 Point3D posDiff = position - thisVert;
@@ -490,9 +630,7 @@ bool Marble::testMove(Point3D velocity, Point3D& position, F64& deltaT, F64 radi
 void Marble::findContacts(U32 contactMask, const Point3D* inPos, const F32* inRad)
 {
     mContacts.clear();
-
-    static Vector<Marble::MaterialCollision> materialCollisions;
-    materialCollisions.clear();
+    mMaterialCollisions.clear();
 
     F32 rad;
     Box3F objBox;
@@ -533,9 +671,9 @@ void Marble::findContacts(U32 contactMask, const Point3D* inPos, const F32* inRa
 
     if ((contactMask & PlayerObjectType) != 0)
     {
-        for (S32 i = 0; i < marbles.size(); i++)
+        for (S32 i = 0; i < mNearbyMarbles.size(); i++)
         {
-            Marble* otherMarble = marbles[i];
+            Marble* otherMarble = mNearbyMarbles[i];
 
 			Point3F otherDist = otherMarble->getPosition() - *pos;
 
@@ -564,13 +702,13 @@ void Marble::findContacts(U32 contactMask, const Point3D* inPos, const F32* inRa
         }
     }
     
-	for (int i = 0; i < polyList.mPolyList.size(); i++)
+	for (int i = 0; i < mPolyList.mPolyList.size(); i++)
 	{
-		ConcretePolyList::Poly* poly = &polyList.mPolyList[i];
+		ConcretePolyList::Poly* poly = &mPolyList.mPolyList[i];
 		PlaneD plane(poly->plane);
 		F64 distance = plane.distToPlane(*pos);
 		if (mFabsD(distance) <= (F64)rad + 0.0001) {
-			Point3D lastVertex(polyList.mVertexList[polyList.mIndexList[poly->vertexStart + poly->vertexCount - 1]]);
+			Point3D lastVertex(mPolyList.mVertexList[mPolyList.mIndexList[poly->vertexStart + poly->vertexCount - 1]]);
 
 			Point3D contactVert = plane.project(*pos);
 
@@ -582,7 +720,7 @@ void Marble::findContacts(U32 contactMask, const Point3D* inPos, const F32* inRa
 			F64 separation = mSqrtD(rad * rad - distance * distance);
 
 			for (int j = 0; j < poly->vertexCount; j++) {
-				Point3D vertex = polyList.mVertexList[polyList.mIndexList[poly->vertexStart + j]];
+				Point3D vertex = mPolyList.mVertexList[mPolyList.mIndexList[poly->vertexStart + j]];
 				if (vertex != lastVertex) {
 					PlaneD vertPlane(vertex + plane, vertex, lastVertex);
 					F64 vertDistance = vertPlane.distToPlane(contactVert);
@@ -678,8 +816,8 @@ void Marble::findContacts(U32 contactMask, const Point3D* inPos, const F32* inRa
 				U32 netIndex = gb->getNetIndex();
 
 				bool found = false;
-				for (int j = 0; j < materialCollisions.size(); j++) {
-					if (materialCollisions[j].ghostIndex == netIndex && materialCollisions[j].materialId == materialId) {
+				for (int j = 0; j < mMaterialCollisions.size(); j++) {
+					if (mMaterialCollisions[j].ghostIndex == netIndex && mMaterialCollisions[j].materialId == materialId) {
 						found = true;
 						break;
 					}
@@ -691,7 +829,7 @@ void Marble::findContacts(U32 contactMask, const Point3D* inPos, const F32* inRa
 					coll.ghostIndex = netIndex;
 					coll.materialId = materialId;
 					coll.object = NULL;
-					materialCollisions.push_back(coll);
+					mMaterialCollisions.push_back(coll);
 					Point3F offset(0, 0, 0);
 					queueCollision(reinterpret_cast<ShapeBase*>(gb), offset, materialId);
 				}
@@ -751,8 +889,12 @@ void Marble::computeFirstPlatformIntersect(F64& dt, Vector<PathedInterior*>& pit
 
                     Point3F diff = itBox.max - boxCenter;
                     SphereF sphere(boxCenter, diff.len());
-                    polyList.clear();
-                    it->buildPolyList(&polyList, itBox, sphere);
+                    mPolyList.clear();
+                    mSweepBatchDirty = true;
+                    if (smUsePolyCache)
+                        buildCachedPolyList(it, itBox);
+                    else
+                        it->buildPolyList(&mPolyList, itBox, sphere);
 
                     Point3D position = mPosition;
                     testMove(vel, position, dt, mRadius, 0, false);
@@ -764,12 +906,57 @@ void Marble::computeFirstPlatformIntersect(F64& dt, Vector<PathedInterior*>& pit
 
 void Marble::resetObjectsAndPolys(U32 collisionMask, const Box3F& testBox)
 {
-    sgLastCollisionBox.min.set(0, 0, 0);
-    sgLastCollisionBox.max.set(0, 0, 0);
+    // prepareTickParallel() already ran exactly this query on a worker
+    // thread.  Marbles processed earlier this tick may have moved since,
+    // and their ticks may have deleted or moved the objects the polys came
+    // from, so the query is run again and the polys are only kept if it
+    // still finds the same static objects where they were.
+    if (mCollisionPrefetched && mPathItrVec.empty() && collisionMask == mLastCollisionMask &&
+        testBox.min == mPrefetchBox.min && testBox.max == mPrefetchBox.max)
+    {
+        mCollisionPrefetched = false;
+
+        mCollisionQueryList.mList.clear();
+        mContainer->findObjects(mLastCollisionBox, collisionMask, SimpleQueryList::insertionCallback, &mCollisionQueryList);
+
+        mNearbyMarbles.clear();
+        bool valid = true;
+        S32 source = 0;
+        for (S32 i = 0; valid && i < mCollisionQueryList.mList.size(); i++)
+        {
+            SceneObject* obj = mCollisionQueryList.mList[i];
+            if (obj->getTypeMask() & PlayerObjectType)
+            {
+                if (obj != this)
+                    mNearbyMarbles.push_back(reinterpret_cast<Marble*>(obj));
+                continue;
+            }
+            if (dynamic_cast<PathedInterior*>(obj))
+                continue;
+
+            // Same objects in the same order, none of them moved.
+            valid = source < mPrefetchSources.size() &&
+                mPrefetchSources[source].object == obj &&
+                mPrefetchSources[source].id == obj->getId() &&
+                mPrefetchSources[source].scale == obj->getScale() &&
+                !dMemcmp(&mPrefetchSources[source].transform, &obj->getTransform(), sizeof(MatrixF));
+            source++;
+        }
+
+        if (valid && source == mPrefetchSources.size())
+        {
+            mCollisionCountCalls = 1;
+            return;
+        }
+    }
+
+    mLastCollisionBox.min.set(0, 0, 0);
+    mLastCollisionBox.max.set(0, 0, 0);
 
-    sgResetFindObjects = true;
-    sgCountCalls = 0;
+    mResetFindObjects = true;
+    mCollisionPrefetched = false;
+    mCollisionCountCalls = 0;
 
-    if (smPathItrVec.empty())
+    if (mPathItrVec.empty())
         findObjectsAndPolys(collisionMask, testBox, false);
 }
@@ -630,24 +630,68 @@ Point3D Marble::getExternalForces(const Move* move, F64 timeStep)
     return ret;
 }
 
-void Marble::advancePhysics(const Move* move, U32 timeDelta)
+void Marble::getTickCollisionBox(U32 timeDelta, Box3F& box)
 {
-    dMemcpy(&delta.posVec, &mPosition, sizeof(delta.posVec));
-
-    smPathItrVec.clear();
-
     F32 dt = timeDelta / 1000.0;
 
-    Box3F extrudedMarble = this->mWorldBox;
+    box = this->mWorldBox;
 
     Point3F velocityExpansion = (mVelocity * dt) * 1.100000023841858;
     Point3F absVelocityExpansion = velocityExpansion.abs();
 
-    extrudedMarble.min += (velocityExpansion - absVelocityExpansion) * 0.5f;
-    extrudedMarble.max += (velocityExpansion + absVelocityExpansion) * 0.5f;
+    box.min += (velocityExpansion - absVelocityExpansion) * 0.5f;
+    box.max += (velocityExpansion + absVelocityExpansion) * 0.5f;
+
+    box.min -= dt * 25.0;
+    box.max += dt * 25.0;
+}
+
+void Marble::prepareTickParallel()
+{
+    Box3F extrudedMarble;
+    getTickCollisionBox(TickMs, extrudedMarble);
+
+    // Pathed interiors move during the tick, so advancePhysics() rebuilds
+    // the working set on every query anyway.
+    for (PathedInterior* obj = PathedInterior::getPathedInteriors(this); obj; obj = obj->getNext())
+    {
+        if (extrudedMarble.isOverlapped(obj->getExtrudedBox()))
+            return;
+    }
+
+    mPathItrVec.clear();
+    clearObjectsAndPolys();
+
+    findObjectsAndPolys(sContactMask, extrudedMarble, false, smCollisionMutex);
+
+    // Nothing ticks during the prepare phase, so these can be read here.
+    mPrefetchSources.clear();
+    for (S32 i = 0; i < mCollisionQueryList.mList.size(); i++)
+    {
+        SceneObject* obj = mCollisionQueryList.mList[i];
+        if ((obj->getTypeMask() & PlayerObjectType) || dynamic_cast<PathedInterior*>(obj))
+            continue;
+
+        mPrefetchSources.increment();
+        PrefetchSource& source = mPrefetchSources.last();
+        source.object = obj;
+        source.id = obj->getId();
+        source.transform = obj->getTransform();
+        source.scale = obj->getScale();
+    }
+
+    mPrefetchBox = extrudedMarble;
+    mCollisionPrefetched = true;
+}
+
+void Marble::advancePhysics(const Move* move, U32 timeDelta)
+{
+    dMemcpy(&delta.posVec, &mPosition, sizeof(delta.posVec));
+
+    mPathItrVec.clear();
 
-    extrudedMarble.min -= dt * 25.0;
-    extrudedMarble.max += dt * 25.0;
+    Box3F extrudedMarble;
+    getTickCollisionBox(timeDelta, extrudedMarble);
 
     for (PathedInterior* obj = PathedInterior::getPathedInteriors(this); ; obj = obj->getNext())
     {
@@ -658,7 +702,7 @@ void Marble::advancePhysics(const Move* move, U32 timeDelta)
         {
             obj->pushTickState();
             obj->computeNextPathStep(timeDelta);
-            smPathItrVec.push_back(obj);
+            mPathItrVec.push_back(obj);
         }
     }
 
@@ -691,7 +735,7 @@ void Marble::advancePhysics(const Move* move, U32 timeDelta)
         findContacts(sContactMask, NULL, NULL);
 
         bool stoppedPaths = false;
-        velocityCancel(isCentered, false, bouncedYet, stoppedPaths, smPathItrVec);
+        velocityCancel(isCentered, false, bouncedYet, stoppedPaths, mPathItrVec);
         Point3D A = getExternalForces(move, timeStep);
 
         Point3D a(0, 0, 0);
@@ -709,10 +753,10 @@ void Marble::advancePhysics(const Move* move, U32 timeDelta)
 #endif
         }
 
-        velocityCancel(isCentered, true, bouncedYet, stoppedPaths, smPathItrVec);
+        velocityCancel(isCentered, true, bouncedYet, stoppedPaths, mPathItrVec);
 
         F64 moveTime = timeStep;
-        computeFirstPlatformIntersect(moveTime, smPathItrVec);
+        computeFirstPlatformIntersect(moveTime, mPathItrVec);
         if (mPhysics == XNA)
             mPosition += mVelocity * moveTime; // XNA
         else
@@ -746,9 +790,9 @@ void Marble::advancePhysics(const Move* move, U32 timeDelta)
 
         timeStep = (startTime - timeRemaining) * 1000.0;
 
-        for (S32 i = 0; i < smPathItrVec.size(); i++)
+        for (S32 i = 0; i < mPathItrVec.size(); i++)
         {
-            PathedInterior* pint = smPathItrVec[i];
+            PathedInterior* pint = mPathItrVec[i];
             pint->resetTickState(false);
             pint->advance(timeStep);
         }
@@ -756,8 +800,8 @@ void Marble::advancePhysics(const Move* move, U32 timeDelta)
         it++;
     } while (mPhysics == MBG || mPhysics == MBGSlopes || it <= 10);
 
-    for (S32 i = 0; i < smPathItrVec.size(); i++)
-        smPathItrVec[i]->popTickState();
+    for (S32 i = 0; i < mPathItrVec.size(); i++)
+        mPathItrVec[i]->popTickState();
 
     F32 contactPct = contactTime * 1000.0 / timeDelta;
 
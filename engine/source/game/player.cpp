@@ -1897,14 +1897,12 @@ MatrixF* Player::Death::fallToGround(F32 dt, const Point3F& loc, F32 curZ, F32 b
             }
 
             // Do the three casts-
-            for (S32 c = 0; c < 3; c++)
-                if (getCurrentClientContainer()->castRay(corners[c], downpts[c], sPlayerConformMask, &coll))
-                    downpts[c] = coll.point;
-                else
-                    break;
-
-            // Do the math if everything hit below-
-            if (c == 3) {
+            RayInfo  downInfo[3];
+            bool     downHit[3];
+            if (getCurrentClientContainer()->castRays(corners, downpts, 3, sPlayerConformMask, downInfo, downHit) == 3) {
+                // Do the math if everything hit below-
+                for (c = 0; c < 3; c++)
+                    downpts[c] = downInfo[c].point;
                 mCross(downpts[1] -= downpts[0], downpts[2] -= downpts[1], &desNormal);
                 AssertFatal(desNormal.z > 0, "Abnormality in Player::Death::fallToGround()");
                 desNormal.normalize();
@@ -258,9 +258,10 @@ bool GFXD3D9TextureManager::_loadTexture(GFXTextureObject *aTexture, GBitmap *pD
       isPow2( pDL->getHeight() ) && isPow2( pDL->getWidth() ) )
       pDL->extrudeMipLevels(false);
 
-   // Settings for mipmap generation
-   U32 maxDownloadMip = pDL->getNumMipLevels();
-   U32 nbMipMapLevel  = pDL->getNumMipLevels();
+   // Settings for mipmap generation.  Cooked bitmaps can carry more
+   // levels than the texture has.
+   U32 maxDownloadMip = getMin( pDL->getNumMipLevels(), aTexture->mMipLevels );
+   U32 nbMipMapLevel  = maxDownloadMip;
 
    if(supportsAutoMips)
    {
@@ -38,6 +38,12 @@ protected:
       { 
          GFXNullTextureObject* to = new GFXNullTextureObject(GFX, profile);
          to->mBitmap = new GBitmap(width, height);
+
+         // Keep the sizes so callers can tell textures apart, as with
+         // the placeholders used by asynchronous loads.
+         to->mTextureSize.set( width, height, depth );
+         to->mMipLevels = numMipLevels;
+         to->mFormat = format;
          return to;
       };
 
@@ -0,0 +1,196 @@
+//-----------------------------------------------------------------------------
+// Torque Shader Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#include "gfx/gBitmap.h"
+#include "core/crc.h"
+#include "core/fileStream.h"
+#include "core/memstream.h"
+#include "platform/profiler.h"
+#include "platform/platformThread.h"
+
+bool GBitmap::smUseCookedCache = true;
+
+static const U32 csCookedMagic = 0x434d4247;   // "GBMC"
+static const U32 csCookedVersion = 1;
+
+//------------------------------------------------------------------------------
+
+bool GBitmap::CookedSource::set(ResourceObject* obj)
+{
+    // Zip entries share the modify time of the zip, and dbm files
+    // are as cooked as they get already.
+    if (!(obj->flags & ResourceObject::File))
+        return false;
+
+    RESOURCE_CREATE_FN createFn = ResourceManager->getCreateFunction(obj->name);
+    if (!createFn || createFn == constructBitmapDBM)
+        return false;
+
+    dSprintf(sourcePath, sizeof(sourcePath), "%s/%s", obj->path, obj->name);
+    if (!Platform::getFileTimes(sourcePath, NULL, &modifyTime))
+        return false;
+
+    const char* cacheDir = Platform::getPrefsPath("textureCache");
+    if (!cacheDir)
+        return false;
+
+    U32 pathHash = calculateCRC(sourcePath, dStrlen(sourcePath));
+    dSprintf(cachePath, sizeof(cachePath), "%s/%08x.bmc", cacheDir, pathHash);
+
+    size = obj->fileSize;
+    crc = obj->crc;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+
+GBitmap* GBitmap::readCooked(const CookedSource& source)
+{
+    PROFILE_START(GBitmap_readCooked);
+
+    U32 size;
+    void* mapping;
+    const U8* data = Platform::mapFile(source.cachePath, &size, &mapping);
+    if (!data)
+    {
+        PROFILE_END();
+        return NULL;
+    }
+
+    MemStream stream(size, (void*)data, true, false);
+
+    U32 magic, version, bitmapVersion;
+    char path[1024];
+    U32 sourceSize, sourceCRC;
+    FileTime modifyTime;
+
+    stream.read(&magic);
+    stream.read(&version);
+    stream.readLongString(sizeof(path) - 1, path);
+    stream.read(&sourceSize);
+    stream.read(&sourceCRC);
+    stream.read(sizeof(modifyTime), &modifyTime);
+
+    // The bitmap itself is write()'s output, peek at its version too.
+    U32 bitmapStart = stream.getPosition();
+    stream.read(&bitmapVersion);
+    stream.setPosition(bitmapStart);
+
+    bool upToDate = stream.getStatus() == Stream::Ok &&
+        magic == csCookedMagic &&
+        version == csCookedVersion &&
+        bitmapVersion == csFileVersion &&
+        !dStrcmp(path, source.sourcePath) &&
+        sourceSize == source.size &&
+        Platform::compareFileTimes(modifyTime, source.modifyTime) == 0 &&
+        (sourceCRC == InvalidCRC || source.crc == InvalidCRC || sourceCRC == source.crc);
+
+    GBitmap* bmp = NULL;
+    if (upToDate)
+    {
+        bmp = new GBitmap;
+        if (!bmp->read(stream))
+        {
+            delete bmp;
+            bmp = NULL;
+        }
+    }
+
+    Platform::unmapFile(data, size, mapping);
+
+    PROFILE_END();
+    return bmp;
+}
+
+bool GBitmap::writeCooked(const CookedSource& source, GBitmap* bmp)
+{
+    // Palettes can't be copied around with the bitmap, so leave them be.
+    if (bmp->getFormat() == GFXFormatP8)
+        return false;
+
+    PROFILE_START(GBitmap_writeCooked);
+
+    // Build the mips under the same rules the devices use, so the
+    // cooked copy is ready to be uploaded.  Fonts keep a single level.
+    if (bmp->getNumMipLevels() == 1 && bmp->getFormat() != GFXFormatA8 &&
+        isPow2(bmp->getWidth()) && isPow2(bmp->getHeight()))
+        bmp->extrudeMipLevels(false);
+
+    if (!Platform::createPath(source.cachePath))
+    {
+        PROFILE_END();
+        return false;
+    }
+
+    // A worker and the main thread can cook the same bitmap at once, and
+    // others may have the cache file mapped, so never write it in place.
+    // Each writer fills a file of its own and renames it over the cache.
+    static U32 sTempCount = 0;
+    char tempPath[1024];
+    dSprintf(tempPath, sizeof(tempPath), "%s.%x.%x.%x", source.cachePath,
+        Thread::getCurrentThreadId(), Platform::getRealMilliseconds(), sTempCount++);
+
+    FileStream stream;
+    if (!stream.open(tempPath, FileStream::Write))
+    {
+        PROFILE_END();
+        return false;
+    }
+
+    // The magic is written last, so a half written file is never used.
+    stream.write(U32(0));
+    stream.write(csCookedVersion);
+    stream.writeLongString(sizeof(source.sourcePath) - 1, source.sourcePath);
+    stream.write(source.size);
+    stream.write(source.crc);
+    stream.write(sizeof(source.modifyTime), &source.modifyTime);
+
+    bool ok = bmp->write(stream) && stream.getStatus() == Stream::Ok;
+    if (ok)
+    {
+        stream.setPosition(0);
+        stream.write(csCookedMagic);
+    }
+    stream.close();
+
+    // Rename even a failed write, its missing magic keeps it from being
+    // used.  The rename can fail on Windows while the cache is mapped.
+    if (!dFileRename(tempPath, source.cachePath))
+    {
+        dFileDelete(tempPath);
+        ok = false;
+    }
+
+    PROFILE_END();
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+
+GBitmap* GBitmap::loadResource(const char* fileName)
+{
+    if (!smUseCookedCache)
+        return (GBitmap*)ResourceManager->loadInstance(fileName);
+
+    ResourceObject* obj = ResourceManager->find(fileName);
+    if (!obj)
+        return NULL;
+
+    CookedSource source;
+    if (!source.set(obj))
+        return (GBitmap*)ResourceManager->loadInstance(obj);
+
+    GBitmap* bmp = readCooked(source);
+    if (bmp)
+    {
+        bmp->mSourceResource = obj;
+        return bmp;
+    }
+
+    bmp = (GBitmap*)ResourceManager->loadInstance(obj);
+    if (bmp)
+        writeCooked(source, bmp);
+    return bmp;
+}
@@ -106,7 +106,8 @@ bool GBitmap::readPNG(Stream& io_rStream, bool useMemoryManager /* = false */)
         return false;
     }
 
-    U32 prevWaterMark = FrameAllocator::getWaterMark();
+    // The png structs come from the real heap rather than the FrameAllocator,
+    //  so this is safe to run on the thread pool.
     png_structp png_ptr = png_create_read_struct_2(PNG_LIBPNG_VER_STRING,
         NULL,
         pngFatalErrorFn,
@@ -119,8 +120,6 @@ bool GBitmap::readPNG(Stream& io_rStream, bool useMemoryManager /* = false */)
 
     if (png_ptr == NULL)
     {
-        //if (!useMemoryManager)
-            FrameAllocator::setWaterMark(prevWaterMark);
         return false;
     }
 
@@ -131,9 +130,6 @@ bool GBitmap::readPNG(Stream& io_rStream, bool useMemoryManager /* = false */)
             (png_infopp)NULL,
             (png_infopp)NULL);
 
-        //if (!useMemoryManager)
-            FrameAllocator::setWaterMark(prevWaterMark);
-
         return false;
     }
 
@@ -144,9 +140,6 @@ bool GBitmap::readPNG(Stream& io_rStream, bool useMemoryManager /* = false */)
             &info_ptr,
             (png_infopp)NULL);
 
-        //if (!useMemoryManager)
-            FrameAllocator::setWaterMark(prevWaterMark);
-
         return false;
     }
 
@@ -266,8 +259,6 @@ bool GBitmap::readPNG(Stream& io_rStream, bool useMemoryManager /* = false */)
     //
     // actually, all of that was handled by allocateBitmap, so we're outta here
     //
-    //if (!useMemoryManager)
-        FrameAllocator::setWaterMark(prevWaterMark);
 
     return true;
 }
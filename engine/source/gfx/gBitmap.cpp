@@ -14,6 +14,10 @@
 
 #include "console/console.h"
 
+#ifdef TORQUE_BITMAP_SSE2
+#include <emmintrin.h>
+#endif
+
 const U32 GBitmap::csFileVersion = 3;
 U32       GBitmap::sBitmapIdSource = 0;
 
@@ -447,9 +451,146 @@ void bitmapExtrudeRGBA_c(const void* srcMip, void* mip, U32 srcHeight, U32 srcWi
     }
 }
 
+#ifdef TORQUE_BITMAP_SSE2
+
+//--------------------------------------------------------------------------
+// The SSE2 box filters sum the rows and then the neighbouring pixels in 16
+// bits, and round the same way the C versions do, so they give the same
+// result.  Single rows and columns are left to the C versions.
+void bitmapExtrudeRGB_sse2(const void* srcMip, void* mip, U32 srcHeight, U32 srcWidth)
+{
+    if (srcHeight == 1 || srcWidth == 1)
+    {
+        bitmapExtrudeRGB_c(srcMip, mip, srcHeight, srcWidth);
+        return;
+    }
+
+    const U32 width = srcWidth >> 1;
+    const U32 height = srcHeight >> 1;
+    const U32 stride = srcWidth * 3;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i two = _mm_set1_epi16(2);
+
+    for (U32 y = 0; y < height; y++)
+    {
+        const U8* row0 = (const U8*)srcMip + y * 2 * stride;
+        const U8* row1 = row0 + stride;
+        U8* dst = (U8*)mip + y * width * 3;
+
+        // Four pixels at a time, from 24 bytes of each row
+        U32 x = 0;
+        for (; x + 4 <= width; x += 4)
+        {
+            const U8* a = row0 + x * 6;
+            const U8* b = row1 + x * 6;
+
+            __m128i a01 = _mm_loadu_si128((const __m128i*)a);
+            __m128i b01 = _mm_loadu_si128((const __m128i*)b);
+            __m128i a2 = _mm_loadl_epi64((const __m128i*)(a + 16));
+            __m128i b2 = _mm_loadl_epi64((const __m128i*)(b + 16));
+
+            __m128i v0 = _mm_add_epi16(_mm_unpacklo_epi8(a01, zero), _mm_unpacklo_epi8(b01, zero));
+            __m128i v1 = _mm_add_epi16(_mm_unpackhi_epi8(a01, zero), _mm_unpackhi_epi8(b01, zero));
+            __m128i v2 = _mm_add_epi16(_mm_unpacklo_epi8(a2, zero), _mm_unpacklo_epi8(b2, zero));
+
+            // Add each channel to the same channel of the next pixel
+            v0 = _mm_add_epi16(v0, _mm_or_si128(_mm_srli_si128(v0, 6), _mm_slli_si128(v1, 10)));
+            v1 = _mm_add_epi16(v1, _mm_or_si128(_mm_srli_si128(v1, 6), _mm_slli_si128(v2, 10)));
+            v2 = _mm_add_epi16(v2, _mm_srli_si128(v2, 6));
+
+            v0 = _mm_srli_epi16(_mm_add_epi16(v0, two), 2);
+            v1 = _mm_srli_epi16(_mm_add_epi16(v1, two), 2);
+            v2 = _mm_srli_epi16(_mm_add_epi16(v2, two), 2);
+
+            // Every other pixel holds a result
+            U8 sums[32];
+            _mm_storeu_si128((__m128i*)sums, _mm_packus_epi16(v0, v1));
+            _mm_storeu_si128((__m128i*)(sums + 16), _mm_packus_epi16(v2, zero));
+            for (U32 i = 0; i < 4; i++)
+            {
+                dst[x * 3 + i * 3 + 0] = sums[i * 6 + 0];
+                dst[x * 3 + i * 3 + 1] = sums[i * 6 + 1];
+                dst[x * 3 + i * 3 + 2] = sums[i * 6 + 2];
+            }
+        }
+
+        for (; x < width; x++)
+        {
+            const U8* a = row0 + x * 6;
+            const U8* b = row1 + x * 6;
+            for (U32 c = 0; c < 3; c++)
+                dst[x * 3 + c] = (U32(a[c]) + U32(a[c + 3]) + U32(b[c]) + U32(b[c + 3]) + 2) >> 2;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+void bitmapExtrudeRGBA_sse2(const void* srcMip, void* mip, U32 srcHeight, U32 srcWidth)
+{
+    if (srcHeight == 1 || srcWidth == 1)
+    {
+        bitmapExtrudeRGBA_c(srcMip, mip, srcHeight, srcWidth);
+        return;
+    }
+
+    const U32 width = srcWidth >> 1;
+    const U32 height = srcHeight >> 1;
+    const U32 stride = srcWidth * 4;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i two = _mm_set1_epi16(2);
+
+    for (U32 y = 0; y < height; y++)
+    {
+        const U8* row0 = (const U8*)srcMip + y * 2 * stride;
+        const U8* row1 = row0 + stride;
+        U8* dst = (U8*)mip + y * width * 4;
+
+        // Four pixels at a time, from 32 bytes of each row
+        U32 x = 0;
+        for (; x + 4 <= width; x += 4)
+        {
+            __m128i a01 = _mm_loadu_si128((const __m128i*)(row0 + x * 8));
+            __m128i a23 = _mm_loadu_si128((const __m128i*)(row0 + x * 8 + 16));
+            __m128i b01 = _mm_loadu_si128((const __m128i*)(row1 + x * 8));
+            __m128i b23 = _mm_loadu_si128((const __m128i*)(row1 + x * 8 + 16));
+
+            // Each register holds the two source pixels of one result
+            __m128i s0 = _mm_add_epi16(_mm_unpacklo_epi8(a01, zero), _mm_unpacklo_epi8(b01, zero));
+            __m128i s1 = _mm_add_epi16(_mm_unpackhi_epi8(a01, zero), _mm_unpackhi_epi8(b01, zero));
+            __m128i s2 = _mm_add_epi16(_mm_unpacklo_epi8(a23, zero), _mm_unpacklo_epi8(b23, zero));
+            __m128i s3 = _mm_add_epi16(_mm_unpackhi_epi8(a23, zero), _mm_unpackhi_epi8(b23, zero));
+
+            s0 = _mm_add_epi16(s0, _mm_srli_si128(s0, 8));
+            s1 = _mm_add_epi16(s1, _mm_srli_si128(s1, 8));
+            s2 = _mm_add_epi16(s2, _mm_srli_si128(s2, 8));
+            s3 = _mm_add_epi16(s3, _mm_srli_si128(s3, 8));
+
+            __m128i lo = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(s0, s1), two), 2);
+            __m128i hi = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(s2, s3), two), 2);
+            _mm_storeu_si128((__m128i*)(dst + x * 4), _mm_packus_epi16(lo, hi));
+        }
+
+        for (; x < width; x++)
+        {
+            const U8* a = row0 + x * 8;
+            const U8* b = row1 + x * 8;
+            for (U32 c = 0; c < 4; c++)
+                dst[x * 4 + c] = (U32(a[c]) + U32(a[c + 4]) + U32(b[c]) + U32(b[c + 4]) + 2) >> 2;
+        }
+    }
+}
+
+void (*bitmapExtrude5551)(const void* srcMip, void* mip, U32 height, U32 width) = bitmapExtrude5551_c;
+void (*bitmapExtrudeRGB)(const void* srcMip, void* mip, U32 srcHeight, U32 srcWidth) = bitmapExtrudeRGB_sse2;
+void (*bitmapExtrudeRGBA)(const void* srcMip, void* mip, U32 srcHeight, U32 srcWidth) = bitmapExtrudeRGBA_sse2;
+
+#else
+
 void (*bitmapExtrude5551)(const void* srcMip, void* mip, U32 height, U32 width) = bitmapExtrude5551_c;
 void (*bitmapExtrudeRGB)(const void* srcMip, void* mip, U32 srcHeight, U32 srcWidth) = bitmapExtrudeRGB_c;
 void (*bitmapExtrudeRGBA)(const void* srcMip, void* mip, U32 srcHeight, U32 srcWidth) = bitmapExtrudeRGBA_c;
+
+#endif
 void (*bitmapExtrudePaletted)(const void* srcMip, void* mip, U32 srcHeight, U32 srcWidth) = bitmapExtrudePaletted_c;
 
 
@@ -899,7 +1040,7 @@ GBitmap* GBitmap::load(const char* path)
     for (U32 i = 0; i < EXT_ARRAY_SIZE; i++)
     {
         dStrncpy(fileNameBuffer + len, extArray[i], BufSize - len - 1);
-        bmp = (GBitmap*)ResourceManager->loadInstance(fileNameBuffer);
+        bmp = loadResource(fileNameBuffer);
 
         if (bmp != NULL)
             break;
@@ -144,9 +144,54 @@ public:
 
     bool writePNGDebug(char* name) const;
 
+    /// @name Cooked Cache
+    ///
+    /// load() keeps decoded bitmaps, with their mip levels already built, in
+    /// a cache under the prefs path so later runs skip the decode and the
+    /// downsampling.  A cache file is named after a hash of the source path
+    /// and records the path, size and modify time of the source, which all
+    /// have to match for it to be used.  The source CRC is checked too when
+    /// the resource manager knows it.  Only loose files are cooked, as zip
+    /// entries have no modify time of their own.
+    ///
+    /// The cache files are a small header followed by write()'s output, so
+    /// they can be mapped and read in place.  All of this is located in
+    /// bitmapCooked.cpp.
+    ///
+    /// @{
+
+    /// Identifies the source of a cooked bitmap.
+    struct CookedSource
+    {
+        char sourcePath[1024];
+        char cachePath[1024];
+        U32 size;
+        U32 crc;
+        FileTime modifyTime;
+
+        /// Fills in the key for the resource, on the main thread.
+        /// Returns false if the resource can't be cooked.
+        bool set(ResourceObject* obj);
+    };
+
+    static bool smUseCookedCache;
+
+    /// Reads the cooked copy of the source, or returns NULL if there
+    /// isn't an up to date one.  Safe to call from any thread.
+    static GBitmap* readCooked(const CookedSource& source);
+
+    /// Builds the mip levels of the bitmap, if it can have them, and
+    /// writes it to the cache.  Safe to call from any thread.
+    static bool writeCooked(const CookedSource& source, GBitmap* bmp);
+
+    /// @}
+
 private:
     bool _writePNG(Stream& stream, const U32, const U32, const U32) const;
 
+    /// Loads one of the names tried by load(), through the cooked cache.
+    static GBitmap* loadResource(const char* fileName);
+
     static const U32 csFileVersion;
 };
 
@@ -242,4 +287,13 @@ extern void (*bitmapExtrudePaletted)(const void* srcMip, void* mip, U32 height,
 
 void bitmapExtrudeRGB_c(const void* srcMip, void* mip, U32 height, U32 width);
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TORQUE_BITMAP_SSE2
+#endif
+
+#ifdef TORQUE_BITMAP_SSE2
+void bitmapExtrudeRGB_sse2(const void* srcMip, void* mip, U32 height, U32 width);
+void bitmapExtrudeRGBA_sse2(const void* srcMip, void* mip, U32 height, U32 width);
+#endif
+
 #endif //_GBITMAP_H_
@@ -2092,6 +2092,10 @@ void GFXDevice::processStateWatchHistory( const GFXDebugState::GFXDebugStateWatc
 // debugging. [6/7/2007 Pat]
 inline void GFXDevice::beginScene()
 {
+    // Swap in any textures which finished loading since the last scene.
+    if (mTextureManager)
+        mTextureManager->updateAsyncLoads();
+
     beginSceneInternal();
 }
 
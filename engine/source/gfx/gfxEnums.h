@@ -38,6 +38,7 @@ enum GFXTexCallbackCode
 {
     GFXZombify,
     GFXResurrect,
+    GFXTexLoaded,   ///< An asynchronous texture load has finished.
 };
 
 
@@ -10,6 +10,9 @@
 #include "console/consoleTypes.h"
 #include "gui/core/guiCanvas.h"
 #include "math/mathUtils.h"
+#include "core/memstream.h"
+#include "core/threadPool.h"
+#include "platform/platformSemaphore.h"
 
 /// Threshold of total VRAM under which we start scaling textures down...
 ///
@@ -27,6 +30,82 @@ S32 gTextureQualityMode = 0;
 // 0 == none, 1 == 1/(4^1), 2 == 1/(4^2), 3 = 1/(4^3)
 S32 gTextureReductionLevel = 1;
 
+/// Allows createTextureAsync() to decode on the thread pool.
+bool gTextureAsyncLoading = true;
+
+//-----------------------------------------------------------------------------
+
+/// A texture file being decoded on the thread pool.
+///
+/// The resource manager isn't safe to use from the workers, so files which
+/// can't be cooked are read on the main thread, and the worker only decodes
+/// the data and builds the mips.  Loose files are left to the worker, which
+/// reads the cooked copy or maps the file itself.  Either way it releases
+/// doneSemaphore when it's done.
+struct GFXAsyncTextureLoad
+{
+    ResourceObject* resource;
+    StringTableEntry path;
+    GFXTextureProfile* profile;
+    RESOURCE_CREATE_FN createFn;
+
+    bool cook;
+    GBitmap::CookedSource cooked;
+
+    U8* data;
+    U32 size;
+
+    GBitmap* bitmap;        ///< Result of the decode, NULL if it failed.
+    void* doneSemaphore;
+
+    struct Callback
+    {
+        GFXTexEventCallback callback;
+        void* userData;
+    };
+    Vector<Callback> callbacks;
+};
+
+static void decodeTexture(void* data)
+{
+    GFXAsyncTextureLoad* load = (GFXAsyncTextureLoad*)data;
+
+    GBitmap* bmp = NULL;
+    if (load->cook)
+    {
+        bmp = GBitmap::readCooked(load->cooked);
+        if (!bmp)
+        {
+            U32 size;
+            void* mapping;
+            const U8* source = Platform::mapFile(load->cooked.sourcePath, &size, &mapping);
+            if (source)
+            {
+                MemStream stream(size, (void*)source, true, false);
+                bmp = (GBitmap*)load->createFn(stream);
+                Platform::unmapFile(source, size, mapping);
+
+                if (bmp)
+                    GBitmap::writeCooked(load->cooked, bmp);
+            }
+        }
+    }
+    else
+    {
+        MemStream stream(load->size, load->data, true, false);
+        bmp = (GBitmap*)load->createFn(stream);
+    }
+
+    // Build the mips here rather than in _loadTexture(), under the same rules
+    // the device uses.  Fonts and other alpha only textures keep one level.
+    if (bmp && !load->profile->noMip() && bmp->getNumMipLevels() == 1 &&
+        bmp->getFormat() != GFXFormatA8 && isPow2(bmp->getWidth()) && isPow2(bmp->getHeight()))
+        bmp->extrudeMipLevels(false);
+
+    load->bitmap = bmp;
+    Semaphore::releaseSemaphore(load->doneSemaphore);
+}
+
 //-----------------------------------------------------------------------------
 
 void GFXTextureManager::init()
@@ -34,6 +113,8 @@ void GFXTextureManager::init()
     Con::addVariable("pref::TextureManager::scaleThreshold", TypeS32, &gTextureScaleThreshold);
     Con::addVariable("pref::TextureManager::qualityMode", TypeS32, &gTextureQualityMode);
     Con::addVariable("pref::TextureManager::reductionLevel", TypeS32, &gTextureReductionLevel);
+    Con::addVariable("pref::TextureManager::asyncLoading", TypeBool, &gTextureAsyncLoading);
+    Con::addVariable("pref::TextureManager::cookedCache", TypeBool, &GBitmap::smUseCookedCache);
 }
 
 GFXTextureManager::GFXTextureManager()
@@ -49,6 +130,7 @@ GFXTextureManager::GFXTextureManager()
 
     mValidTextureQualityInfo = false;
     mHandleCount = 0;
+    mFinishingLoad = NULL;
 }
 
 //-----------------------------------------------------------------------------
@@ -149,6 +231,17 @@ void GFXTextureManager::kill()
 {
     AssertFatal(mTextureManagerState != GFXTextureManager::Dead, "Don't beat a dead texture manager!");
 
+    // Nobody gets their textures now, but the workers still have to be done
+    // with the loads before we can free them.
+    for (U32 i = 0; i < mAsyncLoads.size(); i++)
+    {
+        Semaphore::acquireSemaphore(mAsyncLoads[i]->doneSemaphore);
+        freeAsyncLoad(mAsyncLoads[i]);
+    }
+    mAsyncLoads.clear();
+
+    mPlaceholder = NULL;
+
     GFXTextureObject* curr = mListHead;
     GFXTextureObject* temp;
 
@@ -253,7 +346,9 @@ GFXTextureObject* GFXTextureManager::createTexture(GBitmap* bmp, GFXTextureProfi
 
         realBmp = new GBitmap(realWidth, realHeight, false, bmp->getFormat());
 
-        padBmp->extrudeMipLevels();
+        // Cooked bitmaps come with their mips.
+        if (padBmp->getNumMipLevels() == 1)
+            padBmp->extrudeMipLevels();
 
         // Copy to the new bitmap...
         dMemcpy(
@@ -517,6 +612,193 @@ GFXTextureObject* GFXTextureManager::createTexture(U32 width,
     return ret;
 }
 
+//-----------------------------------------------------------------------------
+// Asynchronous loading
+//-----------------------------------------------------------------------------
+GFXTextureObject* GFXTextureManager::createTextureAsync(const char* filename,
+    GFXTextureProfile* profile,
+    GFXTexEventCallback callback,
+    void* userData)
+{
+    ThreadPool* pool = ThreadPool::getGlobal();
+    ResourceObject* ro = GBitmap::findBmpResource(filename);
+
+    // Anything we can't hand to the pool takes the usual path, which also
+    // deals with the search through the parent directories.
+    if (!gTextureAsyncLoading || !pool || !ro || mTextureManagerState == GFXTextureManager::Dead)
+        return createTexture(filename, profile);
+
+    StringTableEntry path = ro->getFullPath();
+    GFXTextureObject* cacheHit = hashFind(path);
+    if (cacheHit)
+        return cacheHit;
+
+    PROFILE_START(GFXTextureManager_createTextureAsync);
+
+    GFXAsyncTextureLoad::Callback cb;
+    cb.callback = callback;
+    cb.userData = userData;
+
+    // Someone may already be waiting on this file.
+    for (U32 i = 0; i < mAsyncLoads.size(); i++)
+    {
+        if (mAsyncLoads[i]->path == path)
+        {
+            mAsyncLoads[i]->callbacks.push_back(cb);
+            PROFILE_END();
+            return getPlaceholderTexture();
+        }
+    }
+
+    RESOURCE_CREATE_FN createFn = ResourceManager->getCreateFunction(ro->name);
+    if (!createFn)
+    {
+        PROFILE_END();
+        return createTexture(filename, profile);
+    }
+
+    GFXAsyncTextureLoad* load = new GFXAsyncTextureLoad;
+    load->resource = ro;
+    load->path = path;
+    load->profile = profile;
+    load->createFn = createFn;
+    load->cook = GBitmap::smUseCookedCache && load->cooked.set(ro);
+    load->data = NULL;
+    load->size = 0;
+    load->bitmap = NULL;
+    load->doneSemaphore = Semaphore::createSemaphore(0);
+    load->callbacks.push_back(cb);
+
+    if (!load->cook)
+    {
+        Stream* stream = ResourceManager->openStream(ro);
+        bool ok = stream != NULL;
+        if (ok)
+        {
+            load->size = stream->getStreamSize();
+            load->data = new U8[load->size];
+            ok = stream->read(load->size, load->data);
+            ResourceManager->closeStream(stream);
+        }
+
+        if (!ok)
+        {
+            freeAsyncLoad(load);
+            PROFILE_END();
+            return createTexture(filename, profile);
+        }
+    }
+
+    mAsyncLoads.push_back(load);
+    pool->queueJob(decodeTexture, load);
+
+    PROFILE_END();
+    return getPlaceholderTexture();
+}
+
+void GFXTextureManager::cancelAsyncLoads(void* userData)
+{
+    for (U32 i = 0; i < mAsyncLoads.size(); i++)
+    {
+        Vector<GFXAsyncTextureLoad::Callback>& callbacks = mAsyncLoads[i]->callbacks;
+        for (S32 j = callbacks.size() - 1; j >= 0; j--)
+            if (callbacks[j].userData == userData)
+                callbacks.erase(j);
+    }
+
+    if (mFinishingLoad)
+    {
+        Vector<GFXAsyncTextureLoad::Callback>& callbacks = mFinishingLoad->callbacks;
+        for (S32 j = callbacks.size() - 1; j >= 0; j--)
+            if (callbacks[j].userData == userData)
+                callbacks.erase(j);
+    }
+}
+
+U32 GFXTextureManager::updateAsyncLoads(bool wait)
+{
+    // Textures can't be created while the device is lost.
+    if (mTextureManagerState != GFXTextureManager::Living || mAsyncLoads.empty())
+        return 0;
+
+    PROFILE_START(GFXTextureManager_updateAsyncLoads);
+
+    // The callbacks may start new loads, so don't hold on to the size.
+    U32 finished = 0;
+    for (U32 i = 0; i < mAsyncLoads.size(); )
+    {
+        GFXAsyncTextureLoad* load = mAsyncLoads[i];
+        if (!Semaphore::acquireSemaphore(load->doneSemaphore, wait))
+        {
+            i++;
+            continue;
+        }
+
+        mAsyncLoads.erase(i);
+        finishAsyncLoad(load);
+        finished++;
+    }
+
+    PROFILE_END();
+    return finished;
+}
+
+void GFXTextureManager::finishAsyncLoad(GFXAsyncTextureLoad* load)
+{
+    // Only bother with the texture if someone still wants it.
+    if (load->bitmap && load->callbacks.size())
+    {
+        load->bitmap->mSourceResource = load->resource;
+        createTexture(load->bitmap, load->profile, true);
+        load->bitmap = NULL;
+    }
+    else if (!load->bitmap)
+        Con::errorf("GFXTextureManager - failed to decode '%s'", load->path);
+
+    // Owners pick up the texture with createTexture(), or find out it
+    // failed the same way.
+    mFinishingLoad = load;
+    while (load->callbacks.size())
+    {
+        GFXAsyncTextureLoad::Callback cb = load->callbacks.last();
+        load->callbacks.pop_back();
+        cb.callback(GFXTexLoaded, cb.userData);
+    }
+    mFinishingLoad = NULL;
+
+    freeAsyncLoad(load);
+}
+
+void GFXTextureManager::freeAsyncLoad(GFXAsyncTextureLoad* load)
+{
+    Semaphore::destroySemaphore(load->doneSemaphore);
+    delete load->bitmap;
+    delete[] load->data;
+    delete load;
+}
+
+GFXTextureObject* GFXTextureManager::getPlaceholderTexture()
+{
+    if (mPlaceholder.isNull())
+    {
+        const U32 size = 4;
+        GBitmap* bmp = new GBitmap(size, size, false, GFXFormatR8G8B8A8);
+
+        U8* bits = bmp->getWritableBits();
+        for (U32 i = 0; i < size * size; i++)
+        {
+            bits[i * 4 + 0] = 128;
+            bits[i * 4 + 1] = 128;
+            bits[i * 4 + 2] = 128;
+            bits[i * 4 + 3] = 255;
+        }
+
+        mPlaceholder.set(bmp, &GFXDefaultStaticDiffuseProfile, true);
+    }
+
+    return mPlaceholder;
+}
+
 //-----------------------------------------------------------------------------
 
 void GFXTextureManager::hashInsert(GFXTextureObject* object)
@@ -758,3 +1040,12 @@ ConsoleFunction(preloadTexture, void, 2, 2, "preloadTexture(filename)")
 
 
 
+
+ConsoleFunction(flushTextureLoads, S32, 1, 1, "flushTextureLoads()\n"
+    "Waits for the textures loading in the background and returns how many were finished.")
+{
+    if (!GFXDevice::devicePresent() || !GFX->getTextureManager())
+        return 0;
+
+    return GFX->getTextureManager()->updateAsyncLoads(true);
+}
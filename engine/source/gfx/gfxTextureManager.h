@@ -7,12 +7,15 @@
 #define GFX_Texture_Manager_H_
 
 #include "gfx/gfxTextureObject.h"
+#include "gfx/gfxTextureHandle.h"
 #include "gBitmap.h"
 #include "console/console.h"
 #include "gfx/ddsFile.h"
 
 typedef void (*GFXTexEventCallback)(GFXTexCallbackCode code, void* userData);
 
+struct GFXAsyncTextureLoad;
+
 class GFXTextureManager
 {
 private:
@@ -27,6 +30,18 @@ private:
 
     Vector <CallbackData> mEventCallbackList;
 
+    /// Texture files being decoded on the thread pool.
+    Vector<GFXAsyncTextureLoad*> mAsyncLoads;
+
+    /// The load whose callbacks are being made, so they can still be cancelled.
+    GFXAsyncTextureLoad* mFinishingLoad;
+
+    /// Stands in for textures which are still loading.
+    GFXTexHandle mPlaceholder;
+
+    void finishAsyncLoad(GFXAsyncTextureLoad* load);
+    void freeAsyncLoad(GFXAsyncTextureLoad* load);
+
 protected:
     //-----------------------------------------------------------------------
     // General texture management data
@@ -208,6 +223,40 @@ public:
     void unregisterTexCallback(S32 handle);
 
     /// @}
+
+    /// @name Asynchronous Loading
+    ///
+    /// createTextureAsync() reads the file and returns the placeholder texture
+    /// right away, while the decode and mip generation run on the thread pool.
+    /// Once the real texture has been created the callback is made with
+    /// GFXTexLoaded, and createTexture() on the same file returns it from the
+    /// cache.  If the texture is already loaded, or can't be loaded in the
+    /// background, it is returned at once and the callback is never made.
+    ///
+    /// Loads are finished by updateAsyncLoads(), which the device calls at the
+    /// start of every scene.
+    ///
+    /// @{
+
+    ///
+    GFXTextureObject* createTextureAsync(const char* filename,
+        GFXTextureProfile* profile,
+        GFXTexEventCallback callback,
+        void* userData);
+
+    /// Drops the pending callbacks made with userData.
+    void cancelAsyncLoads(void* userData);
+
+    /// Creates the textures which have been decoded, or with wait, all
+    /// of them.  Returns how many loads were finished.
+    U32 updateAsyncLoads(bool wait = false);
+
+    U32 getNumAsyncLoads() const { return mAsyncLoads.size(); }
+
+    /// A small grey texture shared by everything still loading.
+    GFXTextureObject* getPlaceholderTexture();
+
+    /// @}
 };
 
 //-----------------------------------------------------------------------------
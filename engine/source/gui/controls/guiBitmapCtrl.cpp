@@ -47,6 +47,14 @@ ConsoleMethod(GuiBitmapCtrl, setBitmap, void, 3, 4, "(string filename, bool resi
     object->setBitmap(fileName, argc > 3 ? dAtob(argv[3]) : false);
 }
 
+void GuiBitmapCtrl::onRemove()
+{
+    // A load still pending for a sleeping control would call back into us.
+    if (GFXDevice::devicePresent())
+        GFX->getTextureManager()->cancelAsyncLoads(this);
+    Parent::onRemove();
+}
+
 bool GuiBitmapCtrl::onWake()
 {
     if (!Parent::onWake())
@@ -58,9 +66,20 @@ bool GuiBitmapCtrl::onWake()
 
 void GuiBitmapCtrl::onSleep()
 {
+    GFX->getTextureManager()->cancelAsyncLoads(this);
     mTextureObject = NULL;
     Parent::onSleep();
 }
+void GuiBitmapCtrl::textureLoaded(GFXTexCallbackCode code, void* userData)
+{
+    if (code != GFXTexLoaded)
+        return;
+
+    // The texture is in the cache now.
+    GuiBitmapCtrl* ctrl = (GuiBitmapCtrl*)userData;
+    ctrl->mTextureObject.set(ctrl->mBitmapName, &GFXDefaultGUIProfile);
+    ctrl->setUpdate();
+}
 
 //-------------------------------------
 void GuiBitmapCtrl::inspectPostApply()
@@ -80,10 +99,19 @@ void GuiBitmapCtrl::setBitmap(const char* name, bool resize)
 {
     PROFILE_START(GuiBitmapCtrl_SetBitmap);
 
+    // A bitmap still loading for us is no longer wanted.
+    GFX->getTextureManager()->cancelAsyncLoads(this);
+
     mBitmapName = StringTable->insert(name);
     if (*mBitmapName)
     {
-        mTextureObject.set(mBitmapName, &GFXDefaultGUIProfile);
+        // Unless we need its size now, show a placeholder until the
+        // bitmap has loaded in the background.  Sleeping controls load
+        // synchronously, nothing would be drawn before onWake anyway.
+        if (resize || !isAwake())
+            mTextureObject.set(mBitmapName, &GFXDefaultGUIProfile);
+        else
+            mTextureObject = GFX->getTextureManager()->createTextureAsync(mBitmapName, &GFXDefaultGUIProfile, textureLoaded, this);
 
         // Resize the control to fit the bitmap
         if (mTextureObject && resize)
@@ -105,6 +133,7 @@ void GuiBitmapCtrl::setBitmap(const char* name, bool resize)
 
 void GuiBitmapCtrl::setBitmap(GFXTexHandle handle, bool resize)
 {
+    GFX->getTextureManager()->cancelAsyncLoads(this);
     mTextureObject = handle;
 
     // Resize the control to fit the bitmap
@@ -24,6 +24,9 @@ protected:
     bool mWrap;
     bool flipY;
 
+    /// Picks up the bitmap once it has loaded in the background.
+    static void textureLoaded(GFXTexCallbackCode code, void* userData);
+
 public:
     //creation methods
     DECLARE_CONOBJECT(GuiBitmapCtrl);
@@ -31,6 +34,7 @@ public:
     static void initPersistFields();
 
     //Parental methods
+    void onRemove();
     bool onWake();
     void onSleep();
     void inspectPostApply();
@@ -244,7 +244,6 @@ Interior::Interior()
     mNumTriggerableLights = 0;
 
     mPreppedForRender = false;;
-    mSearchTag = 0;
 
     mLightMapBorderSize = 0;
 
@@ -291,6 +290,8 @@ Interior::Interior()
     VECTOR_SET_ASSOCIATION(mPolyListPoints);
     VECTOR_SET_ASSOCIATION(mPolyListStrings);
     VECTOR_SET_ASSOCIATION(mCoordBinIndices);
+    VECTOR_SET_ASSOCIATION(mHullTree);
+    VECTOR_SET_ASSOCIATION(mHullTreeIndices);
 
     VECTOR_SET_ASSOCIATION(mVehicleConvexHulls);
     VECTOR_SET_ASSOCIATION(mVehicleConvexHullEmitStrings);
@@ -1223,6 +1224,8 @@ void Interior::purgeLODData()
     mHullEmitStringIndices.clear();
     mHullSurfaceIndices.clear();
     mCoordBinIndices.clear();
+    mHullTree.clear();
+    mHullTreeIndices.clear();
     mConvexHullEmitStrings.clear();
     for (U32 i = 0; i < NumCoordBins * NumCoordBins; i++)
     {
@@ -243,16 +243,54 @@ public:
     //-------------------------------------- Collision Interface and zone scans
 public:
     bool scanZones(const Box3F&, const MatrixF&, U16* zones, U32* numZones);
-    bool castRay(const Point3F&, const Point3F&, RayInfo*);
-    bool buildPolyList(AbstractPolyList*, const Box3F&, const MatrixF&, const Point3F&);
+
+    /// @name Reentrant queries
+    /// These only read the interior and keep all their state on the stack,
+    /// so any number of threads may run them on the same interior at once.
+    /// @{
+    bool castRay(const Point3F&, const Point3F&, RayInfo*) const;
+    bool buildPolyList(AbstractPolyList*, const Box3F&, const MatrixF&, const Point3F&) const;
+    /// @}
+
+    /// @name Hull export
+    /// buildPolyList() split into its steps, for callers that keep exported
+    /// hulls around and need to pick exactly the hulls, in the same order,
+    /// that a direct buildPolyList() would export.
+    /// @{
+    struct HullQuery
+    {
+        Box3F box;        ///< Interior space bounds of the query box
+        Point3F radii;    ///< Half extents of the oriented query box
+        MatrixF toItr;    ///< Oriented query box to interior space
+    };
+
+    void setupHullQuery(HullQuery& query, AbstractPolyList* list, const Box3F& box,
+        const MatrixF& transform, const Point3F& scale) const;
+    bool isHullInQuery(const HullQuery& query, U16 hullIndex) const;
+
+    /// Appends the hulls buildPolyList() would export for the query,
+    /// in export order.
+    void getQueryHulls(const HullQuery& query, Vector<U16>& hulls) const;
+    void exportHullPolys(AbstractPolyList* list, U16 hullIndex) const;
+    /// @}
+
     bool buildLightPolyList(U32* lightSurfaces, U32* numLightSurfaces,
         const Box3F&, const MatrixF&, const Point3F&);
 
-    bool getIntersectingHulls(const Box3F&, U16* hulls, U32* numHulls);
+    bool getIntersectingHulls(const Box3F&, U16* hulls, U32* numHulls) const;
     bool getIntersectingVehicleHulls(const Box3F&, U16* hulls, U32* numHulls);
 
 protected:
-    bool castRay_r(const U16, const U16, const Point3F&, const Point3F&, RayInfo*);
+    typedef void (*HullCallback)(const Interior* interior, U16 hullIndex, void* data);
+
+    /// Call callback for every hull whose bounds overlap the query box.
+    /// Returns the number of hulls found.
+    U32  findIntersectingHulls(const Box3F& query, HullCallback callback, void* data) const;
+    static void appendHull(const Interior* interior, U16 hullIndex, void* data);
+    static void exportHull(const Interior* interior, U16 hullIndex, void* data);
+    static void appendQueryHull(const Interior* interior, U16 hullIndex, void* data);
+
+    bool castRay_r(const U16, const U16, const Point3F&, const Point3F&, RayInfo*) const;
     void buildPolyList_r(InteriorPolytope& polytope,
         SurfaceHash& hash);
     void scanZone_r(const U16      node,
@@ -297,6 +335,9 @@ public:
     enum Constants {
         NumCoordBins = 16,
 
+        HullTreeLeafSize = 4,
+        HullTreeMaxDepth = 64,
+
         BinsXY = 0,
         BinsXZ = 1,
         BinsYZ = 2
@@ -327,6 +368,8 @@ private:
     bool writeLMapTexGen(Stream&, const PlaneF&, const PlaneF&) const;
     void setupTexCoords();
     void setupZonePlanes();
+    void buildHullTree();
+    U32  buildHullTree_r(U32 start, U32 count, U32 depth);
 
     //-------------------------------------- For morian only...
 public:
@@ -574,8 +617,9 @@ protected:
 
         U32   polyListPointStart;
         U32   polyListStringStart;
-        U16   searchTag;
         bool  staticMesh;
+
+        Box3F getBox() const { return Box3F(minX, minY, minZ, maxX, maxY, maxZ); }
     };
 
     struct CoordBin {
@@ -583,6 +627,15 @@ protected:
         U32   binCount;
     };
 
+    /// Node of the bounding volume hierarchy over mConvexHulls.  An interior
+    /// node's children are the next node and the node at start.  A leaf
+    /// covers count hulls listed from mHullTreeIndices[start].
+    struct HullTreeNode {
+        Box3F box;
+        U32   start;
+        U32   count;    ///< 0 for interior nodes
+    };
+
     struct RenderNode
     {
         bool  exterior;
@@ -767,6 +820,9 @@ private:
     Vector<U16>             mCoordBinIndices;
     U32                     mCoordBinMode;
 
+    Vector<HullTreeNode>    mHullTree;                    // Note: not persisted
+    Vector<U16>             mHullTreeIndices;
+
     Vector<ConvexHull>      mVehicleConvexHulls;
     Vector<U8>              mVehicleConvexHullEmitStrings;
     Vector<U32>             mVehicleHullIndices;
@@ -784,7 +840,6 @@ private:
 
     VectorPtr<InteriorSimpleMesh*> mStaticMeshes;
 
-    U16                     mSearchTag;
     Vector<MatInstance*>    mMatInstCleanupList;
 
     //-------------------------------------- Private interface
@@ -298,7 +298,7 @@ bool Interior::castRay_r(const U16      node,
     const U16      planeIndex,
     const Point3F& s,
     const Point3F& e,
-    RayInfo* info)
+    RayInfo* info) const
 {
     if (isBSPLeafIndex(node) == false)
     {
@@ -456,7 +456,7 @@ bool Interior::castRay_r(const U16      node,
     return false;
 }
 
-bool Interior::castRay(const Point3F& s, const Point3F& e, RayInfo* info)
+bool Interior::castRay(const Point3F& s, const Point3F& e, RayInfo* info) const
 {
     // DMM: Going to need normal here eventually.
     bool hit = castRay_r(0, U16(-1), s, e, info);
@@ -684,13 +684,83 @@ void Interior::buildPolyList_r(InteriorPolytope& polytope,
     AssertFatal(collPlanes.size() == 0, "Unbalanced stack!");
 }
 
-bool Interior::buildPolyList(AbstractPolyList* list,
-    const Box3F& box,
-    const MatrixF& transform,
-    const Point3F& scale)
+struct ExportHullData
+{
+    AbstractPolyList* list;
+    const Interior::HullQuery* query;
+};
+
+void Interior::exportHull(const Interior* interior, U16 hullIndex, void* data)
+{
+    const ExportHullData* exportData = (const ExportHullData*)data;
+
+    if (interior->isHullInQuery(*exportData->query, hullIndex))
+        interior->exportHullPolys(exportData->list, hullIndex);
+}
+
+void Interior::exportHullPolys(AbstractPolyList* list, U16 hullIndex) const
+{
+    const ConvexHull& hull = mConvexHulls[hullIndex];
+    for (S32 j = 0; j < hull.surfaceCount; j++)
+    {
+        U32 surfaceIndex = mHullSurfaceIndices[j + hull.surfaceStart];
+        if (isNullSurfaceIndex(surfaceIndex))
+        {
+            // Is a NULL surface
+            const Interior::NullSurface& rSurface = mNullSurfaces[getNullSurfaceIndex(surfaceIndex)];
+            U32 array[32];
+
+            list->begin(0, rSurface.planeIndex);
+            for (U32 k = 0; k < rSurface.windingCount; k++)
+            {
+                array[k] = list->addPoint(mPoints[mWindings[rSurface.windingStart + k]].point);
+                list->vertex(array[k]);
+            }
+
+            list->plane(getFlippedPlane(rSurface.planeIndex));
+            list->end();
+        }
+        else
+        {
+            const Interior::Surface& rSurface = mSurfaces[surfaceIndex];
+            U32 array[32];
+            U32 fanVerts[32];
+            U32 numVerts;
+
+            collisionFanFromSurface(rSurface, fanVerts, &numVerts);
+
+            // MarbleBlast: Texture index is needed for friction information
+            list->begin(rSurface.textureIndex, rSurface.planeIndex);
+            for (U32 k = 0; k < numVerts; k++)
+            {
+                array[k] = list->addPoint(mPoints[fanVerts[k]].point);
+                list->vertex(array[k]);
+            }
+            list->plane(getFlippedPlane(rSurface.planeIndex));
+            list->end();
+        }
+    }
+}
+
+struct QueryHullData
+{
+    const Interior::HullQuery* query;
+    Vector<U16>* hulls;
+};
+
+void Interior::appendQueryHull(const Interior* interior, U16 hullIndex, void* data)
+{
+    QueryHullData* queryData = (QueryHullData*)data;
+
+    if (interior->isHullInQuery(*queryData->query, hullIndex))
+        queryData->hulls->push_back(hullIndex);
+}
+
+void Interior::setupHullQuery(HullQuery& query, AbstractPolyList* list, const Box3F& box,
+    const MatrixF& transform, const Point3F& scale) const
 {
     Box3F testBox;
-    MatrixF toItr;
+    MatrixF& toItr = query.toItr;
     if (!list->getMapping(&toItr, &testBox))
     {
         // this list doesn't do this, use world space box and transform
@@ -721,7 +791,7 @@ bool Interior::buildPolyList(AbstractPolyList* list,
     F32 yrad = (xy * xlen + yy * ylen + zy * zlen) * invScaley;
     F32 zrad = (xz * xlen + yz * ylen + zz * zlen) * invScalez;
 
-    Box3F interiorBox;
+    Box3F& interiorBox = query.box;
     testBox.getCenter(&interiorBox.min);
     toItr.mulP(interiorBox.min);
 
@@ -739,23 +809,10 @@ bool Interior::buildPolyList(AbstractPolyList* list,
     interiorBox.max.y += yrad;
     interiorBox.max.z += zrad;
 
-    U32 waterMark = FrameAllocator::getWaterMark();
-
-    U16* hulls = (U16*)FrameAllocator::alloc(mConvexHulls.size() * sizeof(U16));
-    U32 numHulls = 0;
-
-    getIntersectingHulls(interiorBox, hulls, &numHulls);
-
-    if (numHulls == 0)
-    {
-        FrameAllocator::setWaterMark(waterMark);
-        return false;
-    }
-
-    // we've found all the hulls that intersect the lists interior space bounding box...
-    // now cull out those hulls which don't intersect the oriented bounding box...
-
-    Point3F radii = testBox.max - testBox.min;
+    // exportHull() culls the hulls that overlap the interior space box
+    // against the oriented box before exporting them...
+    Point3F& radii = query.radii;
+    radii = testBox.max - testBox.min;
     radii *= 0.5f;
     radii.x *= invScalex;
     radii.y *= invScaley;
@@ -766,57 +823,36 @@ bool Interior::buildPolyList(AbstractPolyList* list,
     Point3F center = interiorBox.min + interiorBox.max;
     center *= 0.5f;
     toItr.setColumn(3, center); // (0,0,0) now goes where box center used to...
+}
 
-    for (S32 i = 0; i < numHulls; i++)
-    {
-        const ConvexHull& hull = mConvexHulls[hulls[i]];
-        Box3F hullBox(hull.minX, hull.minY, hull.minZ, hull.maxX, hull.maxY, hull.maxZ);
-        if (!hullBox.collideOrientedBox(radii, toItr))
-            // oriented bounding boxes don't intersect...
-            continue;
-
-        for (S32 j = 0; j < hull.surfaceCount; j++)
-        {
-            U32 surfaceIndex = mHullSurfaceIndices[j + hull.surfaceStart];
-            if (isNullSurfaceIndex(surfaceIndex))
-            {
-                // Is a NULL surface
-                const Interior::NullSurface& rSurface = mNullSurfaces[getNullSurfaceIndex(surfaceIndex)];
-                U32 array[32];
-
-                list->begin(0, rSurface.planeIndex);
-                for (U32 k = 0; k < rSurface.windingCount; k++)
-                {
-                    array[k] = list->addPoint(mPoints[mWindings[rSurface.windingStart + k]].point);
-                    list->vertex(array[k]);
-                }
+bool Interior::isHullInQuery(const HullQuery& query, U16 hullIndex) const
+{
+    const Box3F& hullBox = mConvexHulls[hullIndex].getBox();
+    return query.box.isOverlapped(hullBox) && hullBox.collideOrientedBox(query.radii, query.toItr);
+}
 
-                list->plane(getFlippedPlane(rSurface.planeIndex));
-                list->end();
-            }
-            else
-            {
-                const Interior::Surface& rSurface = mSurfaces[surfaceIndex];
-                U32 array[32];
-                U32 fanVerts[32];
-                U32 numVerts;
+void Interior::getQueryHulls(const HullQuery& query, Vector<U16>& hulls) const
+{
+    QueryHullData queryData;
+    queryData.query = &query;
+    queryData.hulls = &hulls;
+    findIntersectingHulls(query.box, appendQueryHull, &queryData);
+}
 
-                collisionFanFromSurface(rSurface, fanVerts, &numVerts);
+bool Interior::buildPolyList(AbstractPolyList* list,
+    const Box3F& box,
+    const MatrixF& transform,
+    const Point3F& scale) const
+{
+    HullQuery query;
+    setupHullQuery(query, list, box, transform, scale);
 
-                // MarbleBlast: Texture index is needed for friction information
-                list->begin(rSurface.textureIndex, rSurface.planeIndex);
-                for (U32 k = 0; k < numVerts; k++)
-                {
-                    array[k] = list->addPoint(mPoints[fanVerts[k]].point);
-                    list->vertex(array[k]);
-                }
-                list->plane(getFlippedPlane(rSurface.planeIndex));
-                list->end();
-            }
-        }
-    }
+    ExportHullData exportData;
+    exportData.list = list;
+    exportData.query = &query;
+    if (findIntersectingHulls(query.box, exportHull, &exportData) == 0)
+        return false;
 
-    FrameAllocator::setWaterMark(waterMark);
     return !list->isEmpty();
 }
 
@@ -1190,74 +1226,159 @@ bool Interior::scanZones(const Box3F& box,
 }
 
 
-bool Interior::getIntersectingHulls(const Box3F& query, U16* hulls, U32* numHulls)
+//--------------------------------------------------------------------------
+// Hull tree
+//
+// getIntersectingHulls() used to walk the 16x16 XY coord bins stored in the
+// dif, which put every hull of a tall level into the same handful of bins.
+// The hulls are now kept in a bounding volume hierarchy built at load, so a
+// query only visits the parts of the interior it overlaps.  Once built, the
+// tree is never written to, so queries can run on several threads at once.
+
+void Interior::buildHullTree()
 {
-    AssertFatal(*numHulls == 0, "Error, some stuff in the hull vector already!");
+    mHullTree.clear();
+    mHullTreeIndices.setSize(mConvexHulls.size());
+    for (U32 i = 0; i < mConvexHulls.size(); i++)
+        mHullTreeIndices[i] = i;
+
+    if (mConvexHulls.empty())
+        return;
+
+    mHullTree.reserve(2 * (mConvexHulls.size() / HullTreeLeafSize) + 1);
+    buildHullTree_r(0, mConvexHulls.size(), 1);
+}
 
-    // This is paranoia, and I probably wouldn't do it if the tag was 32 bits, but
-    //  a possible collision every 65k searches is just a little too small for comfort
-    // DMM
-    if (mSearchTag == 0)
+U32 Interior::buildHullTree_r(U32 start, U32 count, U32 depth)
+{
+    U32 nodeIndex = mHullTree.size();
+    mHullTree.increment();
+
+    Box3F box = mConvexHulls[mHullTreeIndices[start]].getBox();
+    Point3F center;
+    box.getCenter(&center);
+    Box3F centers(center, center);
+    for (U32 i = start + 1; i < start + count; i++)
     {
-        for (U32 i = 0; i < mConvexHulls.size(); i++)
-            mConvexHulls[i].searchTag = 0;
-        mSearchTag = 1;
+        Box3F hullBox = mConvexHulls[mHullTreeIndices[i]].getBox();
+        box.min.setMin(hullBox.min);
+        box.max.setMax(hullBox.max);
+
+        hullBox.getCenter(&center);
+        centers.min.setMin(center);
+        centers.max.setMax(center);
     }
-    else
+
+    if (count <= HullTreeLeafSize)
     {
-        mSearchTag++;
+        HullTreeNode& rNode = mHullTree[nodeIndex];
+        rNode.box = box;
+        rNode.start = start;
+        rNode.count = count;
+        return nodeIndex;
     }
 
-    F32 xBinSize = mBoundingBox.len_x() / F32(NumCoordBins);
-    F32 yBinSize = mBoundingBox.len_y() / F32(NumCoordBins);
+    // Split the hulls at the middle of the longest axis of their centers.
+    // If they all land on one side, or the tree is getting too deep for
+    // the query stack, just split them in half.
+    U32 axis = 0;
+    Point3F extent = centers.max - centers.min;
+    if (extent.y > extent[axis])
+        axis = 1;
+    if (extent.z > extent[axis])
+        axis = 2;
+
+    U32 mid = start;
+    if (depth < HullTreeMaxDepth - 16)
+    {
+        F32 split = (centers.min[axis] + centers.max[axis]) * 0.5f;
+        for (U32 i = start; i < start + count; i++)
+        {
+            mConvexHulls[mHullTreeIndices[i]].getBox().getCenter(&center);
+            if (center[axis] < split)
+            {
+                U16 temp = mHullTreeIndices[i];
+                mHullTreeIndices[i] = mHullTreeIndices[mid];
+                mHullTreeIndices[mid++] = temp;
+            }
+        }
+    }
+    if (mid == start || mid == start + count)
+        mid = start + count / 2;
+
+    buildHullTree_r(start, mid - start, depth + 1);
+    U32 right = buildHullTree_r(mid, start + count - mid, depth + 1);
 
-    F32 queryMinX = getMax(mBoundingBox.min.x, query.min.x);
-    F32 queryMinY = getMax(mBoundingBox.min.y, query.min.y);
-    F32 queryMaxX = getMin(mBoundingBox.max.x, query.max.x);
-    F32 queryMaxY = getMin(mBoundingBox.max.y, query.max.y);
+    HullTreeNode& rNode = mHullTree[nodeIndex];
+    rNode.box = box;
+    rNode.start = right;
+    rNode.count = 0;
+    return nodeIndex;
+}
 
-    S32 startX = S32(mFloor((queryMinX - mBoundingBox.min.x) / xBinSize));
-    S32 endX = S32(mCeil((queryMaxX - mBoundingBox.min.x) / xBinSize));
-    S32 startY = S32(mFloor((queryMinY - mBoundingBox.min.y) / yBinSize));
-    S32 endY = S32(mCeil((queryMaxY - mBoundingBox.min.y) / yBinSize));
+U32 Interior::findIntersectingHulls(const Box3F& query, HullCallback callback, void* data) const
+{
+    if (mHullTree.empty())
+        return 0;
 
-    AssertFatal(startX >= 0, "Error, bad startx");
-    AssertFatal(startY >= 0, "Error, bad starty");
-    AssertFatal(endX <= NumCoordBins, "Error, bad endX");
-    AssertFatal(endY <= NumCoordBins, "Error, bad endY");
+    U32 numHulls = 0;
 
-    // Handle non-debug case
-    startX = getMax(startX, 0);
-    endX = getMin(endX, NumCoordBins);
-    startY = getMax(startY, 0);
-    endY = getMin(endY, NumCoordBins);
+    U32 stack[HullTreeMaxDepth];
+    U32 stackSize = 0;
+    U32 nodeIndex = 0;
 
-    for (S32 i = startX; i < endX; i++)
+    while (true)
     {
-        for (S32 j = startY; j < endY; j++)
+        const HullTreeNode& rNode = mHullTree[nodeIndex];
+        if (query.isOverlapped(rNode.box))
         {
-            const CoordBin& rBin = mCoordBins[i * NumCoordBins + j];
-            for (U32 k = rBin.binStart; k < rBin.binStart + rBin.binCount; k++)
+            if (rNode.count == 0)
             {
-                U16 hullIndex = mCoordBinIndices[k];
-                ConvexHull& rHull = mConvexHulls[hullIndex];
-
-                // Don't check twice! (We're not Santa Claus.)
-                if (rHull.searchTag == mSearchTag)
-                    continue;
-                rHull.searchTag = mSearchTag;
+                AssertFatal(stackSize < HullTreeMaxDepth, "Interior::findIntersectingHulls: hull tree too deep");
+                stack[stackSize++] = rNode.start;
+                nodeIndex++;
+                continue;
+            }
 
-                Box3F qb(rHull.minX, rHull.minY, rHull.minZ, rHull.maxX, rHull.maxY, rHull.maxZ);
-                if (query.isOverlapped(qb))
+            for (U32 i = rNode.start; i < rNode.start + rNode.count; i++)
+            {
+                U16 hullIndex = mHullTreeIndices[i];
+                if (query.isOverlapped(mConvexHulls[hullIndex].getBox()))
                 {
-                    hulls[*numHulls] = hullIndex;
-                    (*numHulls)++;
+                    callback(this, hullIndex, data);
+                    numHulls++;
                 }
             }
         }
+
+        if (stackSize == 0)
+            break;
+        nodeIndex = stack[--stackSize];
     }
 
-    return *numHulls != 0;
+    return numHulls;
+}
+
+struct AppendHullData
+{
+    U16* hulls;
+    U32* numHulls;
+};
+
+void Interior::appendHull(const Interior* interior, U16 hullIndex, void* data)
+{
+    AppendHullData* appendData = (AppendHullData*)data;
+    appendData->hulls[(*appendData->numHulls)++] = hullIndex;
+}
+
+bool Interior::getIntersectingHulls(const Box3F& query, U16* hulls, U32* numHulls) const
+{
+    AssertFatal(*numHulls == 0, "Error, some stuff in the hull vector already!");
+
+    AppendHullData appendData;
+    appendData.hulls = hulls;
+    appendData.numHulls = numHulls;
+    return findIntersectingHulls(query, appendHull, &appendData) != 0;
 }
 
 
@@ -845,6 +845,7 @@ bool Interior::read(Stream& stream)
     setupZonePlanes();
     truncateZoneTree();
     buildSurfaceZones();
+    buildHullTree();
 
     return(stream.getStatus() == Stream::Ok);
 }
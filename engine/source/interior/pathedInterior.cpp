@@ -101,6 +101,9 @@ PathedInterior::PathedInterior()
 
     mNextPathedInterior = NULL;
 
+    // Path updates are the same for every client.
+    mSharedPackMask = NewPositionMask | NewTargetMask;
+
 #ifndef MBU_TEMP_MP_DESYNC_FIX
     // TEMP: Temporary fix for Moving Platform jittering.
     // The following code was used on both MBU(X360) and MBO(PC)
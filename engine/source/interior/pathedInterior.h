@@ -133,6 +133,7 @@ public:
     static PathedInterior* getPathedInteriors(NetObject* obj);
 
     PathedInterior* getNext() { return mNextPathedInterior; }
+    Interior* getInterior() const { return mInterior; }
 
     PathManager* getPathManager() const;
 
@@ -47,10 +47,24 @@ bool SceneLighting::smUseVertexLighting = false;
 
 void SceneLighting::sgNewEvent(U32 light, S32 object, U32 event)
 {
+    if (sgSynchronous)
+    {
+        AssertFatal((!sgPendingEvent), "SceneLighting::sgNewEvent: only one event can be pending!");
+        sgPendingEvent = new sgSceneLightingProcessEvent(light, object, event);
+        return;
+    }
+
     Sim::postEvent(this, new sgSceneLightingProcessEvent(light, object, event),
         Sim::getTargetTime() + 1);
 }
 
+void SceneLighting::sgPaint()
+{
+    // nothing to show progress on when baking...
+    if (Canvas && !sgSynchronous)
+        Canvas->paint();
+}
+
 //-----------------------------------------------
 /*
 * Called once per scenelighting - entry point for event system
@@ -76,6 +90,10 @@ void SceneLighting::sgLightingStartEvent()
             continue;
         }
 
+        // reused lighting is already in place...
+        if ((*proxyItr)->sgCached)
+            continue;
+
         InteriorInstance* interior = dynamic_cast<InteriorInstance*>((*proxyItr)->getObject());
         if (!interior)
             continue;
@@ -87,7 +105,7 @@ void SceneLighting::sgLightingStartEvent()
         }
     }
 
-    Canvas->paint();
+    sgPaint();
     sgNewEvent(0, 0, sgSceneLightingProcessEvent::sgTGEPassSetupEventType);
     //sgNewEvent(0, 0, sgSceneLightingProcessEvent::sgSGPassSetupEventType);
 }
@@ -109,7 +127,7 @@ void SceneLighting::sgLightingCompleteEvent()
     Con::printf("Scene lighting complete (%3.3f seconds)", (Platform::getRealMilliseconds() - sgTimeTemp2) / 1000.f);
     Con::printf("//-----------------------------------------------");
     Con::printf("");
-    Canvas->paint();
+    sgPaint();
 
     completed(true);
     deleteObject();
@@ -124,7 +142,7 @@ void SceneLighting::sgTGEPassSetupEvent()
 {
     Con::printf("  Starting TGE based scene lighting...");
 
-    Canvas->paint();
+    sgPaint();
     sgNewEvent(0, 0, sgSceneLightingProcessEvent::sgTGELightStartEventType);
 }
 
@@ -185,7 +203,7 @@ void SceneLighting::sgTGELightStartEvent(U32 light)
     }
 
     // kick off lighting
-    Canvas->paint();
+    sgPaint();
     sgNewEvent(light, 0, sgSceneLightingProcessEvent::sgTGELightProcessEventType);
 }
 
@@ -207,7 +225,7 @@ void SceneLighting::sgTGELightProcessEvent(U32 light, S32 object)
         Con::printf("      Lighting interior object %d of %d (%s)...", (object + 1), mLitObjects.size(), interior->mInteriorFileName);
     else
         Con::printf("      Lighting object %d of %d...", (object + 1), mLitObjects.size());
-    Canvas->paint();
+    sgPaint();
 
     //process object and light
     S32 time = Platform::getRealMilliseconds();
@@ -220,7 +238,7 @@ void SceneLighting::sgTGELightProcessEvent(U32 light, S32 object)
     Con::printf("      Object lighting complete (%3.3f seconds)", (Platform::getRealMilliseconds() - time) / 1000.f);
 
     // kick off next object event
-    Canvas->paint();
+    sgPaint();
     sgNewEvent(light, (object + 1), sgSceneLightingProcessEvent::sgTGELightProcessEventType);
 }
 
@@ -234,7 +252,7 @@ void SceneLighting::sgTGELightCompleteEvent(U32 light)
     {
         sgTGESetProgress(mLights.size(), mLitObjects.size());
         Con::printf("  TGE based scene lighting complete (%3.3f seconds)", (Platform::getRealMilliseconds() - sgTimeTemp2) / 1000.f);
-        Canvas->paint();
+        sgPaint();
         sgNewEvent(0, 0, sgSceneLightingProcessEvent::sgSGPassSetupEventType);
         //sgNewEvent(0, 0, sgSceneLightingProcessEvent::sgLightingCompleteEventType);
         return;
@@ -250,7 +268,7 @@ void SceneLighting::sgTGELightCompleteEvent(U32 light)
     }*/
 
     // kick off next light event
-    Canvas->paint();
+    sgPaint();
     sgNewEvent((light + 1), 0, sgSceneLightingProcessEvent::sgTGELightStartEventType);
 }
 
@@ -291,6 +309,10 @@ void SceneLighting::sgSGPassSetupEvent()
             continue;
         }
 
+        // skip objects lit from the cache...
+        if ((*proxyItr)->sgCached)
+            continue;
+
         // add all lights
         mLitObjects.push_back(*proxyItr);
     }
@@ -301,7 +323,7 @@ void SceneLighting::sgSGPassSetupEvent()
     sgStatistics::sgInteriorObjectCount += mLitObjects.size();
 
 
-    Canvas->paint();
+    sgPaint();
     sgNewEvent(0, 0, sgSceneLightingProcessEvent::sgSGObjectStartEventType);
 }
 
@@ -348,7 +370,7 @@ void SceneLighting::sgSGObjectStartEvent(S32 object)
     sgTimeTemp = Platform::getRealMilliseconds();
 
     // kick off lighting
-    Canvas->paint();
+    sgPaint();
 
     // this is slow with multiple objects...
     //sgNewEvent(0, object, sgSceneLightingProcessEvent::sgSGObjectProcessEventType);
@@ -394,7 +416,7 @@ void SceneLighting::sgSGObjectProcessEvent(U32 light, S32 object)
     light--;
 
     // kick off next light event
-    Canvas->paint();
+    sgPaint();
     sgNewEvent((light + 1), object, sgSceneLightingProcessEvent::sgSGObjectProcessEventType);
 }
 
@@ -412,7 +434,7 @@ void SceneLighting::sgSGObjectCompleteEvent(S32 object)
         // stats...
         sgStatistics::sgPrint();
 
-        Canvas->paint();
+        sgPaint();
         sgNewEvent(0, 0, sgSceneLightingProcessEvent::sgLightingCompleteEventType);
         return;
     }
@@ -452,7 +474,7 @@ void SceneLighting::sgSGObjectCompleteEvent(S32 object)
     }*/
 
     // kick off next light event
-    Canvas->paint();
+    sgPaint();
 
     // this is slow with multiple objects...
     //sgNewEvent(0, (object+1), sgSceneLightingProcessEvent::sgSGObjectStartEventType);
@@ -493,6 +515,9 @@ SceneLighting::SceneLighting()
     mStartTime = 0;
     mFileName[0] = 0;
     smUseVertexLighting = Interior::smUseVertexLighting;
+    sgSynchronous = false;
+    sgPendingEvent = NULL;
+    sgCacheHit = false;
 
     static bool initialized = false;
     if (!initialized)
@@ -508,6 +533,8 @@ SceneLighting::~SceneLighting()
     gLighting = 0;
     gLightingProgress = 0.f;
 
+    delete sgPendingEvent;
+
     ObjectProxy** proxyItr;
     for (proxyItr = mSceneObjects.begin(); proxyItr != mSceneObjects.end(); proxyItr++)
         delete* proxyItr;
@@ -515,13 +542,16 @@ SceneLighting::~SceneLighting()
 
 bool SceneLighting::light(BitSet32 flags)
 {
-    if (!getCurrentClientSceneGraph())
+    // a bake lights the server's objects...
+    SceneGraph* sceneGraph = sgSynchronous ? getCurrentServerSceneGraph() : getCurrentClientSceneGraph();
+    Container* container = sgSynchronous ? getCurrentServerContainer() : getCurrentClientContainer();
+    if (!sceneGraph)
         return(false);
 
     mStartTime = Platform::getRealMilliseconds();
 
     // register static lights
-    LightManager* lManager = getCurrentClientSceneGraph()->getLightManager();
+    LightManager* lManager = sceneGraph->getLightManager();
     lManager->sgRegisterGlobalLights(true);
 
     // grab all the lights
@@ -535,7 +565,7 @@ bool SceneLighting::light(BitSet32 flags)
     // get all the objects and create proxy's for them
     Vector<SceneObject*>   objects;
     //gClientContainer.findObjects(InteriorObjectType | TerrainObjectType | AtlasObjectType, sgFindObjectsCallback, &objects);
-    getCurrentClientContainer()->findObjects(InteriorObjectType | TerrainObjectType, sgFindObjectsCallback, &objects);
+    container->findObjects(InteriorObjectType | TerrainObjectType, sgFindObjectsCallback, &objects);
 
     for (SceneObject** itr = objects.begin(); itr != objects.end(); itr++)
     {
@@ -601,7 +631,7 @@ bool SceneLighting::light(BitSet32 flags)
 
     // remove the '.mis' extension from the mission name
     char misName[256];
-    dSprintf(misName, sizeof(misName), "%s", Con::getVariable("$Client::MissionFile"));
+    dSprintf(misName, sizeof(misName), "%s", Con::getVariable(sgSynchronous ? "$Server::MissionFile" : "$Client::MissionFile"));
     char* dot = dStrstr((const char*)misName, ".mis");
     if (dot)
         *dot = '\0';
@@ -617,6 +647,12 @@ bool SceneLighting::light(BitSet32 flags)
         return(false);
     }
 
+    // key each object's lighting by its lights and shadow casters
+    Vector<SceneObject*> casters;
+    container->findObjects(ShadowCasterObjectType, sgFindObjectsCallback, &casters);
+    for (ObjectProxy** proxyItr = mSceneObjects.begin(); proxyItr != mSceneObjects.end(); proxyItr++)
+        (*proxyItr)->sgCalcLightingCRC(mLights, casters);
+
     // check for some persisted data, check if being forced..
     if (!flags.test(ForceAlways | ForceWritable))
     {
@@ -628,6 +664,7 @@ bool SceneLighting::light(BitSet32 flags)
             if (!dFileTouch(mFileName))
                 Con::warnf("  Failed to touch file '%s'.  File may be read only.", mFileName);
 
+            sgCacheHit = true;
             return(false);
         }
 
@@ -651,13 +688,28 @@ bool SceneLighting::light(BitSet32 flags)
         delete fileStream;
     }
 
+    // reuse what we can from the last lighting of this mission,
+    // unless asked to relight everything...
+    if (!flags.test(ForceAlways) && sgLoadCachedObjects(misName))
+    {
+        if (Con::getBoolVariable("$pref::sceneLighting::cacheLighting", true))
+        {
+            if (!savePersistInfo(mFileName))
+                Con::errorf(ConsoleLogEntry::General, "SceneLighting::light: unable to persist lighting!");
+            else
+                Con::printf(" Successfully saved mission lighting file: '%s'", mFileName);
+        }
+
+        sgCacheHit = true;
+        return(false);
+    }
+
     // initialize the objects for lighting
     for (ObjectProxy** proxyItr = mSceneObjects.begin(); proxyItr != mSceneObjects.end(); proxyItr++)
         (*proxyItr)->init();
 
     // get things started
-    Sim::postEvent(this, new sgSceneLightingProcessEvent(0, -1,
-        sgSceneLightingProcessEvent::sgLightingStartEventType), Sim::getTargetTime() + 1);
+    sgNewEvent(0, -1, sgSceneLightingProcessEvent::sgLightingStartEventType);
     return(true);
 }
 
@@ -735,6 +787,69 @@ bool SceneLighting::lightScene(const char* callback, BitSet32 flags)
     return(true);
 }
 
+bool SceneLighting::bakeScene(BitSet32 flags)
+{
+    if (gLighting)
+    {
+        Con::errorf(ConsoleLogEntry::General, "SceneLighting::bakeScene: scene lighting is already running!");
+        return(false);
+    }
+
+    // the cache is keyed on the same crc the server hands its clients...
+    U32 missionCRC;
+    const char* missionFile = Con::getVariable("$Server::MissionFile");
+    if (!missionFile[0] || !ResourceManager->getCrc(missionFile, missionCRC))
+    {
+        Con::errorf(ConsoleLogEntry::General, "SceneLighting::bakeScene: no mission loaded!");
+        return(false);
+    }
+
+    SceneLighting* lighting = new SceneLighting;
+    lighting->sgSynchronous = true;
+
+    if (!lighting->registerObject())
+    {
+        AssertFatal(0, "SceneLighting:: Unable to register SceneLighting object!");
+        Con::errorf(ConsoleLogEntry::General, "SceneLighting:: Unable to register SceneLighting object!");
+        delete lighting;
+        return(false);
+    }
+
+    // set the globals
+    gLighting = lighting;
+    gTerminateLighting = false;
+    gLightingProgress = 0.f;
+    gCompleteCallback = 0;
+    gConnectionMissionCRC = missionCRC;
+
+    if (!lighting->light(flags))
+    {
+        // nothing to do when the cache already has it all...
+        bool cacheHit = lighting->sgCacheHit;
+        lighting->completed(true);
+        lighting->deleteObject();
+        return(cacheHit);
+    }
+
+    // the complete event deletes the object...
+    while (gLighting == lighting)
+    {
+        SimEvent* event = lighting->sgPendingEvent;
+        AssertFatal((event), "SceneLighting::bakeScene: lighting stalled!");
+        if (!event)
+        {
+            lighting->deleteObject();
+            return(false);
+        }
+
+        lighting->sgPendingEvent = NULL;
+        event->process(lighting);
+        delete event;
+    }
+
+    return(true);
+}
+
 bool SceneLighting::isLighting()
 {
     return(bool(gLighting));
@@ -885,6 +1000,85 @@ bool SceneLighting::loadPersistInfo(const char* fileName)
     return(true);
 }
 
+bool SceneLighting::sgLoadCachedObjects(const char* missionName)
+{
+    if (!Con::getBoolVariable("$pref::sceneLighting::incremental", true))
+        return(false);
+
+    // find the newest lighting file for the mission in the same format
+    char pattern[1024];
+    dSprintf(pattern, sizeof(pattern), "%s_*.ml", missionName);
+    bool raw = !LightManager::sgAllowFullLightMaps();
+
+    char newestName[1024];
+    newestName[0] = 0;
+    FileTime newestTime;
+
+    const char* name;
+    ResourceObject* match = ResourceManager->findMatch(pattern, &name, NULL);
+    while (match)
+    {
+        if ((match->flags & ResourceObject::File) && ((dStrstr(name, "-raw.ml") != NULL) == raw))
+        {
+            char fileName[1024];
+            dSprintf(fileName, sizeof(fileName), "%s/%s", match->path, match->name);
+
+            FileTime createTime, modifyTime;
+            if (Platform::getFileTimes(fileName, &createTime, &modifyTime) &&
+                (!newestName[0] || (Platform::compareFileTimes(modifyTime, newestTime) > 0)))
+            {
+                dStrcpy(newestName, fileName);
+                newestTime = modifyTime;
+            }
+        }
+
+        match = ResourceManager->findMatch(pattern, &name, match);
+    }
+
+    if (!newestName[0])
+        return(false);
+
+    Stream* stream = ResourceManager->openStream(newestName);
+    if (!stream)
+        return(false);
+
+    PersistInfo persistInfo;
+    bool success = persistInfo.read(*stream);
+    ResourceManager->closeStream(stream);
+    if (!success)
+        return(false);
+
+    // hand each unchanged object the chunk lit with the same key,
+    // chunks are matched once so identical instances get their own...
+    U32 count = 0;
+    for (U32 i = 0; i < mSceneObjects.size(); i++)
+    {
+        ObjectProxy* proxy = mSceneObjects[i];
+        if (!proxy->sgLightingCRC)
+            continue;
+
+        for (U32 c = 1; c < persistInfo.mChunks.size(); c++)
+        {
+            PersistInfo::InteriorChunk* chunk = dynamic_cast<PersistInfo::InteriorChunk*>(persistInfo.mChunks[c]);
+            if ((!chunk) || (chunk->sgLightingCRC != proxy->sgLightingCRC) || (!proxy->isValidChunk(chunk)))
+                continue;
+
+            chunk->sgLightingCRC = 0;
+            if (proxy->setPersistInfo(chunk))
+            {
+                proxy->sgCached = true;
+                count++;
+            }
+            break;
+        }
+    }
+
+    if (count)
+        Con::printf(" Reused the lighting of %d of %d objects from '%s'", count, mSceneObjects.size(), newestName);
+
+    return(count == mSceneObjects.size());
+}
+
 bool SceneLighting::savePersistInfo(const char* fileName)
 {
     // open the file
@@ -1142,6 +1336,59 @@ U32 SceneLighting::calcMissionCRC()
     return(calculateCRC(crc.address(), sizeof(U32) * crc.size(), 0xffffffff));
 }
 
+U32 SceneLighting::sgCalcLightCRC(LightInfo* light)
+{
+    // everything the lighting models read from the light...
+    U32 crc = calculateCRC(&light->mType, sizeof(light->mType), 0xffffffff);
+    crc = calculateCRC(&light->mPos, sizeof(light->mPos), crc);
+    crc = calculateCRC(&light->mDirection, sizeof(light->mDirection), crc);
+    crc = calculateCRC(&light->mColor, sizeof(light->mColor), crc);
+    crc = calculateCRC(&light->mAmbient, sizeof(light->mAmbient), crc);
+    crc = calculateCRC(&light->mRadius, sizeof(light->mRadius), crc);
+    crc = calculateCRC(&light->sgSpotAngle, sizeof(light->sgSpotAngle), crc);
+    crc = calculateCRC(&light->sgZone, sizeof(light->sgZone), crc);
+    crc = calculateCRC(&light->sgLocalAmbientAmount, sizeof(light->sgLocalAmbientAmount), crc);
+    crc = calculateCRC(&light->sgLightingTransform, sizeof(light->sgLightingTransform), crc);
+    crc = calculateCRC(&light->sgSpotPlane, sizeof(light->sgSpotPlane), crc);
+
+    U8 flags[6];
+    flags[0] = light->sgCastsShadows;
+    flags[1] = light->sgDiffuseRestrictZone;
+    flags[2] = light->sgAmbientRestrictZone;
+    flags[3] = light->sgSmoothSpotLight;
+    flags[4] = light->sgDoubleSidedAmbient;
+    flags[5] = light->sgUseNormals;
+    crc = calculateCRC(flags, sizeof(flags), crc);
+
+    if (light->sgLightingModelName)
+        crc = calculateCRC(light->sgLightingModelName, dStrlen(light->sgLightingModelName), crc);
+
+    return(crc);
+}
+
+U32 SceneLighting::sgCalcCasterCRC(SceneObject* obj)
+{
+    const char* classname = obj->getClassName();
+    const MatrixF& transform = obj->getTransform();
+    const VectorF& scale = obj->getScale();
+    const Box3F& box = obj->getWorldBox();
+
+    U32 crc = calculateCRC(classname, dStrlen(classname), 0xffffffff);
+    crc = calculateCRC(&transform, sizeof(transform), crc);
+    crc = calculateCRC(&scale, sizeof(scale), crc);
+    crc = calculateCRC(&box, sizeof(box), crc);
+
+    // interiors can be rebuilt in place...
+    InteriorInstance* interior = dynamic_cast<InteriorInstance*>(obj);
+    if (interior)
+    {
+        U32 resourcecrc = interior->getCRC();
+        crc = calculateCRC(&resourcecrc, sizeof(resourcecrc), crc);
+    }
+
+    return(crc);
+}
+
 bool SceneLighting::ObjectProxy::calcValidation()
 {
     mChunkCRC = getResourceCRC();
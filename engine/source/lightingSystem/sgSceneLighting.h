@@ -38,6 +38,15 @@ public:
     S32 sgTimeTemp;
     S32 sgTimeTemp2;
     void sgNewEvent(U32 light, S32 object, U32 event);
+    void sgPaint();
+
+    /// Set by bakeScene, runs the lighting events back to back
+    /// without the Sim event queue or the canvas.
+    bool sgSynchronous;
+    /// The next event when running synchronously.
+    SimEvent* sgPendingEvent;
+    /// Set by light() when the lighting came from the cache.
+    bool sgCacheHit;
 
     void sgLightingStartEvent();
     void sgLightingCompleteEvent();
@@ -72,6 +81,15 @@ public:
     bool loadPersistInfo(const char*);
     bool savePersistInfo(const char*);
 
+    /// @name Incremental lighting
+    /// Objects whose lights and shadow casters are unchanged take their
+    /// lighting from the mission's newest cache file instead of being relit.
+    /// @{
+    bool sgLoadCachedObjects(const char* missionName);
+    static U32 sgCalcLightCRC(LightInfo* light);
+    static U32 sgCalcCasterCRC(SceneObject* obj);
+    /// @}
+
     class ObjectProxy;
     class TerrainProxy;
     class InteriorProxy;
@@ -90,8 +108,13 @@ public:
     public:
         SimObjectPtr<SceneObject>     mObj;
         U32                           mChunkCRC;
+        /// CRC of the object, its lights and its shadow casters.
+        /// Zero if the lighting can't be reused.
+        U32                           sgLightingCRC;
+        /// The lighting was reused from an older cache file.
+        bool                          sgCached;
 
-        ObjectProxy(SceneObject* obj) : mObj(obj) { mChunkCRC = 0; }
+        ObjectProxy(SceneObject* obj) : mObj(obj) { mChunkCRC = 0; sgLightingCRC = 0; sgCached = false; }
         virtual ~ObjectProxy() {}
         SceneObject* operator->() { return(mObj); }
         SceneObject* getObject() { return(mObj); }
@@ -103,6 +126,7 @@ public:
         virtual bool preLight(LightInfo*) { return(false); }
         virtual void light(LightInfo*) {}
         virtual void postLight(bool lastLight) {}
+        virtual void sgCalcLightingCRC(const LightInfoList& lights, const Vector<SceneObject*>& casters) {}
         /// @}
 
         /// @name Persistence
@@ -275,6 +299,7 @@ public:
         bool preLight(LightInfo*);
         void light(LightInfo*);
         void postLight(bool lastLight);
+        void sgCalcLightingCRC(const LightInfoList& lights, const Vector<SceneObject*>& casters);
 
         // persist
         U32 getResourceCRC();
@@ -350,6 +375,11 @@ public:
         LoadOnly = BIT(2),   ///< Just load cached lighting data.
     };
     static bool lightScene(const char*, BitSet32 flags = 0);
+    /// Lights the server's scene and writes the lighting cache before
+    /// returning.  Needs no client connection, canvas or GPU.  Objects
+    /// unchanged since the last cache file keep their lighting unless
+    /// ForceAlways is set.
+    static bool bakeScene(BitSet32 flags = ForceWritable);
     static bool isLighting();
 
     S32                        mStartTime;
@@ -85,6 +85,10 @@ void SceneLighting::InteriorProxy::sgAddLight(LightInfo* light, InteriorInstance
 
 void SceneLighting::InteriorProxy::light(LightInfo* light)
 {
+    // reused lighting is already complete, only here to cast shadows...
+    if (sgCached)
+        return;
+
     U32 i;
     U32 countthispass = 0;
 
@@ -1013,6 +1017,82 @@ void SceneLighting::InteriorProxy::postLight(bool lastLight)
         return;
 }
 
+static S32 QSORT_CALLBACK sgCompareCRC(const void* a, const void* b)
+{
+    U32 crca = *((const U32*)a);
+    U32 crcb = *((const U32*)b);
+    return (crca < crcb) ? -1 : ((crca > crcb) ? 1 : 0);
+}
+
+/// The bounds of everything that can shadow the interior are its box
+/// grown out to each light, the same boxes sgGetIntersectingObjects uses.
+void SceneLighting::InteriorProxy::sgCalcLightingCRC(const LightInfoList& lights, const Vector<SceneObject*>& casters)
+{
+    sgLightingCRC = 0;
+
+    InteriorInstance* interior = getObject();
+    if (!interior)
+        return;
+
+    // filtered objects are not lit at all...
+    const Box3F& worldbox = interior->getWorldBox();
+    if (!sgRelightFilter::sgAllowLighting(worldbox, false))
+        return;
+
+    Vector<U32> lightcrcs;
+    Box3F bounds = worldbox;
+    bool shadows = false;
+
+    for (U32 i = 0; i < lights.size(); i++)
+    {
+        // same test as sgAddLight...
+        LightInfo* light = lights[i];
+        sgLightingModel& model = sgLightingModelManager::sgGetLightingModel(
+            light->sgLightingModelName);
+        model.sgSetState(light);
+        bool canilluminate = model.sgCanIlluminate(worldbox);
+        model.sgResetState();
+
+        if (!canilluminate)
+            continue;
+
+        lightcrcs.push_back(SceneLighting::sgCalcLightCRC(light));
+        bounds.min.setMin(light->mPos);
+        bounds.max.setMax(light->mPos);
+        shadows |= light->sgCastsShadows;
+    }
+
+    Vector<U32> castercrcs;
+    if (shadows && LightManager::sgAllowShadows())
+    {
+        for (U32 i = 0; i < casters.size(); i++)
+        {
+            if ((casters[i] != interior) && bounds.isOverlapped(casters[i]->getWorldBox()))
+                castercrcs.push_back(SceneLighting::sgCalcCasterCRC(casters[i]));
+        }
+    }
+
+    // the light list order isn't stable between runs...
+    dQsort(lightcrcs.address(), lightcrcs.size(), sizeof(U32), sgCompareCRC);
+    dQsort(castercrcs.address(), castercrcs.size(), sizeof(U32), sgCompareCRC);
+
+    U32 lightcount = lightcrcs.size();
+    U32 castercount = castercrcs.size();
+    bool allowshadows = LightManager::sgAllowShadows();
+    U32 lmscale = LightManager::sgGetLightMapScale();
+
+    U32 crc = SceneLighting::sgCalcCasterCRC(interior);
+    crc = calculateCRC(&allowshadows, sizeof(allowshadows), crc);
+    crc = calculateCRC(&lmscale, sizeof(lmscale), crc);
+    crc = calculateCRC(&lightcount, sizeof(lightcount), crc);
+    crc = calculateCRC(lightcrcs.address(), lightcount * sizeof(U32), crc);
+    crc = calculateCRC(&castercount, sizeof(castercount), crc);
+    crc = calculateCRC(castercrcs.address(), castercount * sizeof(U32), crc);
+
+    // zero means unknown...
+    sgLightingCRC = crc ? crc : 1;
+}
+
 //------------------------------------------------------------------------------
 U32 SceneLighting::InteriorProxy::getResourceCRC()
 {
@@ -1118,6 +1198,8 @@ bool SceneLighting::InteriorProxy::getPersistInfo(PersistInfo::PersistChunk* inf
     if (!interior)
         return(false);
 
+    chunk->sgLightingCRC = sgLightingCRC;
+
     LM_HANDLE instanceHandle = interior->getLMHandle();
 
     AssertFatal(!chunk->mDetailLightmapCount.size(), "SceneLighting::InteriorProxy::getPersistInfo: invalid array!");
@@ -9,7 +9,7 @@
 //------------------------------------------------------------------------------
 // Class SceneLighting::PersistInfo
 //------------------------------------------------------------------------------
-U32 PersistInfo::smFileVersion = 0x11;
+U32 PersistInfo::smFileVersion = 0x12;
 
 PersistInfo::~PersistInfo()
 {
@@ -126,6 +126,7 @@ PersistInfo::MissionChunk::MissionChunk()
 PersistInfo::InteriorChunk::InteriorChunk()
 {
     mChunkType = PersistChunk::InteriorChunkType;
+    sgLightingCRC = 0;
 }
 
 PersistInfo::InteriorChunk::~InteriorChunk()
@@ -147,6 +148,9 @@ bool PersistInfo::InteriorChunk::read(Stream& stream)
     if (!Parent::read(stream))
         return(false);
 
+    if (!stream.read(&sgLightingCRC))
+        return(false);
+
     U32 size;
     U32 i;
 
@@ -222,6 +226,9 @@ bool PersistInfo::InteriorChunk::write(Stream& stream)
     if (!Parent::write(stream))
         return(false);
 
+    if (!stream.write(sgLightingCRC))
+        return(false);
+
     // lightmaps
     U32 startPos = stream.getPosition();
     if (!stream.write(U32(0)))
@@ -44,6 +44,9 @@ struct PersistInfo
         InteriorChunk();
         ~InteriorChunk();
 
+        /// See SceneLighting::ObjectProxy::sgLightingCRC.
+        U32                  sgLightingCRC;
+
         Vector<GBitmap*>     sgNormalLightMaps;
 
         Vector<U32>          mDetailLightmapCount;
@@ -375,6 +375,10 @@ public:
     static U32  getTime();
     static U32  getVirtualMilliseconds();
     static U32  getRealMilliseconds();
+    /// High resolution monotonic counter, for timing short intervals.
+    /// Ticks getPerformanceFrequency() times a second.
+    static U64  getPerformanceCounter();
+    static U64  getPerformanceFrequency();
     static void advanceTime(U32 delta);
 
     static S32 getBackgroundSleepTime();
@@ -391,6 +395,12 @@ public:
     static bool getFileTimes(const char* filePath, FileTime* createTime, FileTime* modifyTime);
     static bool isFile(const char* pFilePath);
     static S32  getFileSize(const char* pFilePath);
+    /// Map a whole file read only into memory.  Returns NULL if the file can't
+    /// be opened or mapped (empty files never are), in which case read it
+    /// through a File instead.  Safe to call from any thread.
+    static const U8* mapFile(const char* pFilePath, U32* size, void** mapping);
+    /// Release a view returned by mapFile().
+    static void unmapFile(const U8* data, U32 size, void* mapping);
     static bool isDirectory(const char* pDirPath);
     static bool isSubDirectory(const char* pParent, const char* pDir);
 
@@ -421,6 +431,7 @@ public:
             const char* name;
             U32         mhz;
             U32         properties;      // CPU type specific enum
+            U32         numLogicalProcessors;
         } processor;
     } SystemInfo;
 
@@ -610,6 +621,10 @@ namespace Memory
     dsize_t getMemoryUsed();
     dsize_t getMemoryAllocated();
     void validate();
+
+    /// Hands the calling thread's cached slab blocks back to the shared
+    /// lists.  Threads call this as they exit.
+    void flushThreadCache();
 } // namespace Memory
 
 template <class T>
@@ -714,6 +729,9 @@ enum DFILE_STATUS
 
 extern bool dFileDelete(const char* name);
 extern bool dFileTouch(const char* name);
+/// Renames a file, replacing newName if it exists.  Readers that already
+/// have newName open keep the old contents.
+extern bool dFileRename(const char* oldName, const char* newName);
 
 extern FILE_HANDLE dOpenFileRead(const char* name, DFILE_STATUS& error);
 extern FILE_HANDLE dOpenFileReadWrite(const char* name, bool append, DFILE_STATUS& error);
@@ -9,6 +9,10 @@
 #include "platform/profiler.h"
 #include "platform/platformMutex.h"
 
+#if defined(TORQUE_SLAB_ALLOCATOR) && !defined(TORQUE_OS_WIN32)
+#include <pthread.h>
+#endif
+
 
 #ifdef TORQUE_MULTITHREAD
 void* gMemMutex = NULL;
@@ -23,6 +27,7 @@ enum MemConstants : U32 {
     Allocated = BIT(0),
     Array = BIT(1),
     DebugFlag = BIT(2),
+    Slab = BIT(3),
     AllocatedGuard = 0xCEDEFEDE,
     FreeGuard = 0x5555FFFF,
     MaxAllocationAmount = 0xFFFFFFFF,
@@ -232,6 +237,162 @@ namespace Memory
         gTreeFreeList = tn;
     }
 
+#if defined(TORQUE_SLAB_ALLOCATOR) && !defined(TORQUE_DISABLE_MEMORY_MANAGER)
+
+    //---------------------------------------------------------------------------
+    // Size class slabs
+    //
+    // Allocations of up to SlabMaxSize bytes come out of fixed size blocks
+    // carved from SlabSpanSize spans, one set of spans per size class.  Each
+    // thread keeps its own free list per class and only takes gMemMutex to move
+    // a batch of blocks to or from the class's central free list, or to carve a
+    // new span.  Everything bigger still goes through the free block tree.
+    //
+    // Slab blocks carry an ordinary AllocatedHeader, flagged Slab, so free(),
+    // realloc() and the leak tracking treat them like any other block.  The
+    // header's next pointer holds the span the block was carved from, and a
+    // free block's payload holds the next block in its free list.
+
+#if defined(_MSC_VER)
+#define MEMORY_THREAD_LOCAL __declspec(thread)
+#else
+#define MEMORY_THREAD_LOCAL __thread
+#endif
+
+    enum SlabConstants : U32 {
+        SlabNumClasses = 20,
+        SlabMaxSize = 1024,
+        SlabSpanSize = 64 * 1024,
+        SlabBatch = 32,             ///< Blocks moved to or from a central list at a time.
+        SlabThreadMax = 2 * SlabBatch, ///< Blocks a thread may hold per class before returning a batch.
+    };
+
+    static const U32 gSlabClassSize[SlabNumClasses] = {
+        16, 32, 48, 64, 80, 96, 112, 128,
+        160, 192, 224, 256,
+        320, 384, 448, 512,
+        640, 768, 896, 1024
+    };
+
+    struct SlabSpan
+    {
+        SlabSpan* nextSpan;
+        U32 sizeClass;
+        U32 blockSize;  ///< Header and payload, rounded to 16 bytes.
+        U32 numBlocks;
+        U8* blocks;
+    };
+
+    struct SlabFreeBlock
+    {
+        SlabFreeBlock* next;
+    };
+
+    struct SlabClass
+    {
+        SlabSpan* spans;
+        SlabFreeBlock* freeList;
+        U32 numFree;
+    };
+
+    struct SlabThreadCache
+    {
+        SlabFreeBlock* freeList[SlabNumClasses];
+        U32 numFree[SlabNumClasses];
+        bool registered;    ///< Set up to be flushed when the thread exits
+    };
+
+    static SlabClass gSlabClasses[SlabNumClasses];
+    static MEMORY_THREAD_LOCAL SlabThreadCache gSlabCache;
+
+    static inline U32 slabClassFor(dsize_t size)
+    {
+        if (size <= 128)
+            return U32((size + 15) >> 4) - 1;
+        if (size <= 256)
+            return 8 + U32(size - 129) / 32;
+        if (size <= 512)
+            return 12 + U32(size - 257) / 64;
+        return 16 + U32(size - 513) / 128;
+    }
+
+    static inline AllocatedHeader* slabBlockHeader(SlabSpan* span, U32 block)
+    {
+        return (AllocatedHeader*)(span->blocks + block * span->blockSize);
+    }
+
+#endif
+
+    /// Steps through every allocated block, in the free block tree's pages
+    /// and (if enabled) the slabs.
+    struct AllocWalker
+    {
+        PageRecord* page;
+        Header* probe;
+#if defined(TORQUE_SLAB_ALLOCATOR) && !defined(TORQUE_DISABLE_MEMORY_MANAGER)
+        U32 sizeClass;
+        SlabSpan* span;
+        U32 block;
+#endif
+
+        AllocatedHeader* first()
+        {
+            page = gPageList;
+            probe = NULL;
+#if defined(TORQUE_SLAB_ALLOCATOR) && !defined(TORQUE_DISABLE_MEMORY_MANAGER)
+            sizeClass = 0;
+            span = NULL;
+            block = 0;
+#endif
+            return next();
+        }
+
+        AllocatedHeader* next()
+        {
+            // the tree's pages first...
+            while (page)
+            {
+                probe = probe ? probe->next : page->headerList;
+                if (!probe)
+                {
+                    page = page->prevPage;
+                    continue;
+                }
+                if (probe->flags & Allocated)
+                    return (AllocatedHeader*)probe;
+            }
+
+#if defined(TORQUE_SLAB_ALLOCATOR) && !defined(TORQUE_DISABLE_MEMORY_MANAGER)
+            // ...then the slabs
+            while (sizeClass < SlabNumClasses)
+            {
+                if (!span)
+                {
+                    span = gSlabClasses[sizeClass].spans;
+                    block = 0;
+                    if (!span)
+                    {
+                        sizeClass++;
+                        continue;
+                    }
+                }
+                if (block == span->numBlocks)
+                {
+                    span = span->nextSpan;
+                    block = 0;
+                    if (!span)
+                        sizeClass++;
+                    continue;
+                }
+                AllocatedHeader* hdr = slabBlockHeader(span, block++);
+                if (hdr->flags & Allocated)
+                    return hdr;
+            }
+#endif
+            return NULL;
+        }
+    };
+
 
     static U32 validateTreeRecurse(TreeNode* tree)
     {
@@ -339,6 +500,26 @@ namespace Memory
                     Platform::debugBreak();
             }
         }
+#if defined(TORQUE_SLAB_ALLOCATOR) && !defined(TORQUE_DISABLE_MEMORY_MANAGER)
+        // and the slab blocks
+        for (U32 i = 0; i < SlabNumClasses; i++)
+        {
+            for (SlabSpan* span = gSlabClasses[i].spans; span; span = span->nextSpan)
+            {
+                if (span->sizeClass != i)
+                    Platform::debugBreak();
+                for (U32 j = 0; j < span->numBlocks; j++)
+                {
+                    AllocatedHeader* hdr = slabBlockHeader(span, j);
+#ifdef TORQUE_DEBUG_GUARD
+                    checkGuard((Header*)hdr, true);
+#endif
+                    if (!(hdr->flags & Slab) || (SlabSpan*)hdr->next != span || hdr->size != gSlabClassSize[i])
+                        Platform::debugBreak();
+                }
+            }
+        }
+#endif
 
 #ifdef TORQUE_MULTITHREAD
         Mutex::unlockMutex(gMemMutex);
@@ -745,6 +926,22 @@ namespace Memory
         }
         Con::printf("Total free blocks: %d  Max Depth: %d  Min Depth: %d  Average Depth: %f",
             fullMem.count, fullMem.maxDepth, fullMem.minDepth, F32(fullMem.depthTotal) / F32(fullMem.count));
+
+#if defined(TORQUE_SLAB_ALLOCATOR) && !defined(TORQUE_DISABLE_MEMORY_MANAGER)
+        // blocks sitting in other threads' lists count as used here
+        for (i = 0; i < SlabNumClasses; i++)
+        {
+            U32 numSpans = 0, numBlocks = 0;
+            for (SlabSpan* span = gSlabClasses[i].spans; span; span = span->nextSpan)
+            {
+                numSpans++;
+                numBlocks += span->numBlocks;
+            }
+            if (numSpans)
+                Con::printf("Slab: %d - Spans: %d  Blocks: %d  Free (central): %d  Free (this thread): %d",
+                    gSlabClassSize[i], numSpans, numBlocks, gSlabClasses[i].numFree, gSlabCache.numFree[i]);
+        }
+#endif
     }
 
 #ifdef TORQUE_DEBUG_GUARD
@@ -759,14 +956,9 @@ namespace Memory
             gProfiler->dumpToConsole();
         }
 #endif
-        PageRecord* walk;
-        for (walk = gPageList; walk; walk = walk->prevPage) {
-            for (Header* probe = walk->headerList; probe; probe = probe->next)
-                if (probe->flags & Allocated) {
-                    AllocatedHeader* pah = (AllocatedHeader*)probe;
-                    pah->flags |= DebugFlag;
-                }
-        }
+        AllocWalker walker;
+        for (AllocatedHeader* pah = walker.first(); pah; pah = walker.next())
+            pah->flags |= DebugFlag;
     }
 
     ConsoleFunction(FlagCurrentAllocs, void, 1, 1, "FlagCurrentAllocs();")
@@ -783,47 +975,40 @@ namespace Memory
             useFile = fws.open(filename, FileStream::Write);
         char buffer[1024];
 
-        PageRecord* walk;
-        for (walk = gPageList; walk; walk = walk->prevPage)
+        AllocWalker walker;
+        for (AllocatedHeader* pah = walker.first(); pah; pah = walker.next())
         {
-            for (Header* probe = walk->headerList; probe; probe = probe->next)
+            if (!(pah->flags & DebugFlag))
             {
-                if (probe->flags & Allocated)
+                // If you want to extract further information from an unflagged
+                // memory allocation, do the following:
+                // U8 *foo = (U8 *)pah;
+                // foo += sizeof(Header);
+                // FooObject *obj = (FooObject *)foo;
+                dSprintf(buffer, 1023, "%s   %d   %d   %d",
+                    pah->fileName != NULL ? pah->fileName : "Undetermined",
+                    pah->line, pah->realSize, pah->allocNum);
+                if (useFile)
                 {
-                    AllocatedHeader* pah = (AllocatedHeader*)probe;
-                    if (!(pah->flags & DebugFlag))
-                    {
-                        // If you want to extract further information from an unflagged
-                        // memory allocation, do the following:
-                        // U8 *foo = (U8 *)pah;
-                        // foo += sizeof(Header);
-                        // FooObject *obj = (FooObject *)foo;
-                        dSprintf(buffer, 1023, "%s   %d   %d   %d",
-                            pah->fileName != NULL ? pah->fileName : "Undetermined",
-                            pah->line, pah->realSize, pah->allocNum);
-                        if (useFile)
-                        {
-                            fws.write(dStrlen(buffer), buffer);
-                            fws.write(2, "\r\n");
-                        }
-                        else
-                            Con::errorf("%s", buffer);
+                    fws.write(dStrlen(buffer), buffer);
+                    fws.write(2, "\r\n");
+                }
+                else
+                    Con::errorf("%s", buffer);
 #ifdef TORQUE_ENABLE_PROFILE_PATH
-                        static char line[4096];
-                        dSprintf(line, sizeof(line), "   %s\r\nreal size=%d",
-                            pah->profilePath ? pah->profilePath : "unknown",
-                            pah->realSize);
+                static char line[4096];
+                dSprintf(line, sizeof(line), "   %s\r\nreal size=%d",
+                    pah->profilePath ? pah->profilePath : "unknown",
+                    pah->realSize);
 
-                        if (useFile)
-                        {
-                            fws.write(dStrlen(line), line);
-                            fws.write(2, "\r\n");
-                        }
-                        else
-                            Con::errorf(line);
-#endif
-                    }
+                if (useFile)
+                {
+                    fws.write(dStrlen(line), line);
+                    fws.write(2, "\r\n");
                 }
+                else
+                    Con::errorf(line);
+#endif
             }
         }
 
@@ -1026,6 +1211,220 @@ namespace Memory
     static bool gReentrantGuard = false;
 #endif
 
+#if defined(TORQUE_SLAB_ALLOCATOR) && !defined(TORQUE_DISABLE_MEMORY_MANAGER)
+    // The slab functions below that touch gSlabClasses expect the caller to
+    // hold gMemMutex.  Only gSlabCache may be used without it.
+
+    static void slabCarveSpan(U32 sizeClass)
+    {
+        SlabClass& sc = gSlabClasses[sizeClass];
+        PageRecord* page = allocPage(SlabSpanSize);
+
+        SlabSpan* span = (SlabSpan*)page->basePtr;
+        span->sizeClass = sizeClass;
+        span->blockSize = (sizeof(AllocatedHeader) + gSlabClassSize[sizeClass] + 15) & ~0xF;
+        span->blocks = (U8*)(((dsize_t)(span + 1) + 15) & ~dsize_t(0xF));
+        span->numBlocks = U32(((U8*)page->basePtr + SlabSpanSize - span->blocks) / span->blockSize);
+        span->nextSpan = sc.spans;
+        sc.spans = span;
+
+        // push in reverse so the span hands out its blocks in address order
+        for (U32 i = span->numBlocks; i--; )
+        {
+            AllocatedHeader* hdr = slabBlockHeader(span, i);
+            hdr->next = (Header*)span;
+            hdr->prev = NULL;
+            hdr->size = gSlabClassSize[sizeClass];
+            hdr->flags = Slab;
+#ifdef TORQUE_DEBUG_GUARD
+            setGuard((Header*)hdr, true);
+#endif
+            SlabFreeBlock* block = (SlabFreeBlock*)(hdr + 1);
+            block->next = sc.freeList;
+            sc.freeList = block;
+        }
+        sc.numFree += span->numBlocks;
+    }
+
+#ifndef TORQUE_OS_WIN32
+    // Thread only exists on Win32 and X86UNIX, and some platform code starts
+    //  its own pthreads, so not every thread calls flushThreadCache() on its
+    //  way out.  A key destructor makes pthreads call it for them.
+    static pthread_key_t gSlabThreadKey;
+    static bool gSlabThreadKeyCreated = false;
+
+    static void slabThreadExit(void*)
+    {
+        flushThreadCache();
+    }
+#endif
+
+    /// Makes sure this thread's cache is handed back when the thread exits.
+    static void slabRegisterThread()
+    {
+        gSlabCache.registered = true;
+#ifndef TORQUE_OS_WIN32
+        if (!gSlabThreadKeyCreated)
+        {
+            pthread_key_create(&gSlabThreadKey, slabThreadExit);
+            gSlabThreadKeyCreated = true;
+        }
+        pthread_setspecific(gSlabThreadKey, &gSlabCache);
+#endif
+    }
+
+    /// Moves a batch of blocks from the central list to this thread's list.
+    static void slabFetch(U32 sizeClass)
+    {
+        if (!gSlabCache.registered)
+            slabRegisterThread();
+
+        SlabClass& sc = gSlabClasses[sizeClass];
+        if (!sc.freeList)
+            slabCarveSpan(sizeClass);
+
+        SlabFreeBlock*& list = gSlabCache.freeList[sizeClass];
+        for (U32 i = 0; i < SlabBatch && sc.freeList; i++)
+        {
+            SlabFreeBlock* block = sc.freeList;
+            sc.freeList = block->next;
+            block->next = list;
+            list = block;
+            sc.numFree--;
+            gSlabCache.numFree[sizeClass]++;
+        }
+    }
+
+    /// Moves up to count blocks from this thread's list to the central list.
+    static void slabRelease(U32 sizeClass, U32 count)
+    {
+        SlabClass& sc = gSlabClasses[sizeClass];
+        SlabFreeBlock*& list = gSlabCache.freeList[sizeClass];
+        for (U32 i = 0; i < count && list; i++)
+        {
+            SlabFreeBlock* block = list;
+            list = block->next;
+            block->next = sc.freeList;
+            sc.freeList = block;
+            sc.numFree++;
+            gSlabCache.numFree[sizeClass]--;
+        }
+    }
+
+    static void* slabAlloc(dsize_t size, bool array, const char* fileName, const U32 line)
+    {
+        if (size == 0)
+            size = 1;
+#ifdef TORQUE_DEBUG_GUARD
+        size = ((size + 3) & ~0x3);
+#endif
+        U32 sizeClass = slabClassFor(size);
+
+        if (!gSlabCache.freeList[sizeClass])
+        {
+#ifdef TORQUE_MULTITHREAD
+            Mutex::lockMutex(gMemMutex);
+#endif
+            slabFetch(sizeClass);
+#ifdef TORQUE_MULTITHREAD
+            Mutex::unlockMutex(gMemMutex);
+#endif
+        }
+
+        SlabFreeBlock* block = gSlabCache.freeList[sizeClass];
+        gSlabCache.freeList[sizeClass] = block->next;
+        gSlabCache.numFree[sizeClass]--;
+
+        AllocatedHeader* hdr = ((AllocatedHeader*)block) - 1;
+        AssertFatal((hdr->flags & (Slab | Allocated)) == Slab, "Bad slab block flags.");
+        hdr->flags = array ? (Slab | Allocated | Array) : (Slab | Allocated);
+
+#ifdef TORQUE_DEBUG_GUARD
+        // the allocation count and byte totals are shared with the tree, so
+        // guarded builds still take the lock for every slab allocation.
+#ifdef TORQUE_MULTITHREAD
+        Mutex::lockMutex(gMemMutex);
+#endif
+        hdr->line = line;
+        hdr->fileName = fileName;
+        hdr->allocNum = gCurrAlloc;
+        hdr->realSize = size;
+#ifdef TORQUE_ENABLE_PROFILE_PATH
+        hdr->profilePath = gProfiler ? gProfiler->getProfilePath() : "pre";
+#endif
+        gBytesAllocated += size;
+        if (gEnableLogging)
+            logAlloc(hdr, size);
+        if (gCurrAlloc == gBreakAlloc && gBreakAlloc != 0xFFFFFFFF)
+            Platform::debugBreak();
+        gCurrAlloc++;
+#ifdef TORQUE_MULTITHREAD
+        Mutex::unlockMutex(gMemMutex);
+#endif
+#else
+        fileName, line;
+#endif
+
+#ifdef TORQUE_DEBUG
+        dMemset(block, 0xCF, hdr->size);
+#endif
+        return block;
+    }
+
+    static void slabFree(AllocatedHeader* hdr, bool array)
+    {
+        AssertFatal(hdr->flags & Allocated, avar("Not an allocated block!"));
+        AssertFatal(((bool)((hdr->flags & Array) == Array)) == array, avar("Array alloc mismatch. "));
+
+#ifdef TORQUE_DEBUG_GUARD
+#ifdef TORQUE_MULTITHREAD
+        Mutex::lockMutex(gMemMutex);
+#endif
+        gBytesAllocated -= hdr->realSize;
+        if (gEnableLogging)
+            logFree(hdr);
+#ifdef TORQUE_MULTITHREAD
+        Mutex::unlockMutex(gMemMutex);
+#endif
+#endif
+
+        hdr->flags = Slab;
+
+        SlabFreeBlock* block = (SlabFreeBlock*)(hdr + 1);
+#ifdef TORQUE_DEBUG
+        dMemset(block, 0xCE, hdr->size);
+#endif
+
+        // blocks go back on the freeing thread's list, whichever thread
+        // allocated them.
+        if (!gSlabCache.registered)
+        {
+#ifdef TORQUE_MULTITHREAD
+            Mutex::lockMutex(gMemMutex);
+#endif
+            slabRegisterThread();
+#ifdef TORQUE_MULTITHREAD
+            Mutex::unlockMutex(gMemMutex);
+#endif
+        }
+
+        U32 sizeClass = ((SlabSpan*)hdr->next)->sizeClass;
+        block->next = gSlabCache.freeList[sizeClass];
+        gSlabCache.freeList[sizeClass] = block;
+
+        if (++gSlabCache.numFree[sizeClass] > SlabThreadMax)
+        {
+#ifdef TORQUE_MULTITHREAD
+            Mutex::lockMutex(gMemMutex);
+#endif
+            slabRelease(sizeClass, SlabBatch);
+#ifdef TORQUE_MULTITHREAD
+            Mutex::unlockMutex(gMemMutex);
+#endif
+        }
+    }
+#endif
+
 #if !defined(TORQUE_DISABLE_MEMORY_MANAGER)
     static void* alloc(dsize_t size, bool array, const char* fileName, const U32 line)
     {
@@ -1040,7 +1439,20 @@ namespace Memory
             gMemMutex = Mutex::createMutex();
             gReentrantGuard = false;
         }
+#endif
 
+#if defined(TORQUE_SLAB_ALLOCATOR)
+        // small blocks come from the slabs without taking the lock, unless
+        // we're here while the mutex they need is still being created.
+#ifdef TORQUE_MULTITHREAD
+        if (size <= SlabMaxSize && !gReentrantGuard)
+#else
+        if (size <= SlabMaxSize)
+#endif
+            return slabAlloc(size, array, fileName, line);
+#endif
+
+#ifdef TORQUE_MULTITHREAD
         if (!gReentrantGuard)
             Mutex::lockMutex(gMemMutex);
 #endif
@@ -1065,6 +1477,7 @@ namespace Memory
         // round up size to nearest 16 byte boundary (cache lines and all...)
         size = ((size + 15) & ~0xF);
 #endif
+
         FreeHeader* header = treeFindSmallestGreaterThan(size);
         if (header)
             treeRemove(header);
@@ -1134,6 +1547,15 @@ namespace Memory
         if (!mem)
             return;
 
+        AllocatedHeader* hdr = ((AllocatedHeader*)mem) - 1;
+#if defined(TORQUE_SLAB_ALLOCATOR)
+        if (hdr->flags & Slab)
+        {
+            slabFree(hdr, array);
+            return;
+        }
+#endif
+
 #ifdef TORQUE_MULTITHREAD
         if (!gMemMutex)
             gMemMutex = Mutex::createMutex();
@@ -1142,7 +1564,6 @@ namespace Memory
 #endif
 
         PROFILE_START(MemoryFree);
-        AllocatedHeader* hdr = ((AllocatedHeader*)mem) - 1;
 
         AssertFatal(hdr->flags & Allocated, avar("Not an allocated block!"));
         AssertFatal(((bool)((hdr->flags & Array) == Array)) == array, avar("Array alloc mismatch. "));
@@ -1205,6 +1626,38 @@ namespace Memory
     }
 #endif
 
+#if defined(TORQUE_SLAB_ALLOCATOR) && !defined(TORQUE_DISABLE_MEMORY_MANAGER)
+    static void* slabRealloc(AllocatedHeader* hdr, dsize_t size)
+    {
+        AssertFatal((hdr->flags & Allocated) == Allocated, "Bad block flags.");
+
+        void* mem = hdr + 1;
+        if (size <= hdr->size)
+        {
+            // still fits the block's size class
+#ifdef TORQUE_DEBUG_GUARD
+            size = ((size + 3) & ~0x3);
+#ifdef TORQUE_MULTITHREAD
+            Mutex::lockMutex(gMemMutex);
+#endif
+            gBytesAllocated += size - hdr->realSize;
+            hdr->realSize = size;
+            if (gEnableLogging)
+                logRealloc(hdr, size);
+#ifdef TORQUE_MULTITHREAD
+            Mutex::unlockMutex(gMemMutex);
+#endif
+#endif
+            return mem;
+        }
+
+        void* ret = alloc(size, false, NULL, 0);
+        dMemcpy(ret, mem, hdr->size);
+        free(mem, false);
+        return ret;
+    }
+#endif
+
 #if !defined(TORQUE_DISABLE_MEMORY_MANAGER)
     static void* realloc(void* mem, dsize_t size)
     {
@@ -1216,6 +1669,12 @@ namespace Memory
         if (!mem)
             return alloc(size, false, NULL, 0);
 
+        AllocatedHeader* hdr = ((AllocatedHeader*)mem) - 1;
+#if defined(TORQUE_SLAB_ALLOCATOR)
+        if (hdr->flags & Slab)
+            return slabRealloc(hdr, size);
+#endif
+
 #ifdef TORQUE_MULTITHREAD
         if (!gMemMutex)
             gMemMutex = Mutex::createMutex();
@@ -1223,8 +1682,6 @@ namespace Memory
         Mutex::lockMutex(gMemMutex);
 #endif
 
-        AllocatedHeader* hdr = ((AllocatedHeader*)mem) - 1;
-
         AssertFatal((hdr->flags & Allocated) == Allocated, "Bad block flags.");
 
         size = (size + 0xF) & ~0xF;
@@ -1294,13 +1751,9 @@ namespace Memory
     {
         U32 size = 0;
 
-        PageRecord* walk;
-        for (walk = gPageList; walk; walk = walk->prevPage) {
-            for (Header* probe = walk->headerList; probe; probe = probe->next)
-                if (probe->flags & Allocated) {
-                    size += probe->size;
-                }
-        }
+        AllocWalker walker;
+        for (AllocatedHeader* pah = walker.first(); pah; pah = walker.next())
+            size += pah->size;
 
         return size;
     }
@@ -1313,16 +1766,13 @@ namespace Memory
         fws.open(argv[1], FileStream::Write);
         char buffer[1024];
 
-        PageRecord* walk;
-        for (walk = gPageList; walk; walk = walk->prevPage) {
-            for (Header* probe = walk->headerList; probe; probe = probe->next)
-                if (probe->flags & Allocated) {
-                    AllocatedHeader* pah = (AllocatedHeader*)probe;
-                    dSprintf(buffer, 1023, "%s\t%d\t%d\t%d\r\n",
-                        pah->fileName != NULL ? pah->fileName : "Undetermined",
-                        pah->line, pah->realSize, pah->allocNum);
-                    fws.write(dStrlen(buffer), buffer);
-                }
+        AllocWalker walker;
+        for (AllocatedHeader* pah = walker.first(); pah; pah = walker.next())
+        {
+            dSprintf(buffer, 1023, "%s\t%d\t%d\t%d\r\n",
+                pah->fileName != NULL ? pah->fileName : "Undetermined",
+                pah->line, pah->realSize, pah->allocNum);
+            fws.write(dStrlen(buffer), buffer);
         }
 
         fws.close();
@@ -1334,6 +1784,23 @@ namespace Memory
         return 0;
     }
 
+    void flushThreadCache()
+    {
+#if defined(TORQUE_SLAB_ALLOCATOR) && !defined(TORQUE_DISABLE_MEMORY_MANAGER)
+#ifdef TORQUE_MULTITHREAD
+        if (!gMemMutex)
+            return;
+
+        Mutex::lockMutex(gMemMutex);
+#endif
+        for (U32 i = 0; i < SlabNumClasses; i++)
+            slabRelease(i, gSlabCache.numFree[i]);
+#ifdef TORQUE_MULTITHREAD
+        Mutex::unlockMutex(gMemMutex);
+#endif
+#endif
+    }
+
     void setBreakAlloc(U32 breakAlloc)
     {
         gBreakAlloc = breakAlloc;
@@ -11,6 +11,7 @@
 #include "core/tVector.h"
 #include "core/fileStream.h"
 #include "platform/platformThread.h"
+#include "platform/platformMutex.h"
 #include "core/frameAllocator.h"
 
 #ifdef TORQUE_ENABLE_PROFILER
@@ -124,6 +125,62 @@ U32 endHighResolutionTimer(U32 time[2])
 
 #endif
 
+//-----------------------------------------------------------------------------
+// Event tracing
+//
+// Each thread that hits a PROFILE_START or PROFILE_END while a trace is
+// running gets a ProfilerThreadTrace, found through a thread local pointer.
+// Only the owning thread ever writes to it, so recording an event takes no
+// locks; the profiler's trace mutex is only taken the first time a thread
+// records anything, to link it into mTraceList.  Traces are never freed
+// before the profiler is, so they outlive the threads that wrote them.
+
+#if defined(_MSC_VER)
+#define PROFILER_THREAD_LOCAL __declspec(thread)
+#else
+#define PROFILER_THREAD_LOCAL __thread
+#endif
+
+/// A PROFILE_START (mRoot set) or PROFILE_END (mRoot NULL).
+struct ProfilerTraceEvent
+{
+    U64 mTime;
+    ProfilerRootData* mRoot;
+};
+
+struct ProfilerThreadTrace
+{
+    enum {
+        MaxStackDepth = 256
+    };
+    U32 mThreadId;
+    U32 mThreadIndex;           ///< Order threads first recorded in, for naming them.
+    U32 mGeneration;            ///< Trace the ring belongs to.
+    ProfilerTraceEvent* mEvents;
+    U32 mCapacity;
+    U32 mCount;                 ///< Events written, including overwritten ones.
+    U32 mDepth;                 ///< PROFILE_START nesting since the trace started.
+    bool mRecorded[MaxStackDepth]; ///< Whether the PROFILE_START at each depth was recorded.
+    ProfilerThreadTrace* mNext;
+};
+
+static PROFILER_THREAD_LOCAL ProfilerThreadTrace* sThreadTrace = NULL;
+
+/// Set while a thread is inside the tracer, so the profiled allocations it
+/// makes don't recurse back into it.
+static PROFILER_THREAD_LOCAL bool sInTraceEvent = false;
+
+static void freeThreadTraces(ProfilerThreadTrace* list)
+{
+    while (list)
+    {
+        ProfilerThreadTrace* next = list->mNext;
+        dFree(list->mEvents);
+        dFree(list);
+        list = next;
+    }
+}
+
 Profiler::Profiler()
 {
     mMaxStackDepth = MaxStackDepth;
@@ -161,6 +218,13 @@ Profiler::Profiler()
     mDumpToFile = false;
     mDumpFileName[0] = '\0';
 
+    mTracing = false;
+    mTraceGeneration = 0;
+    mTraceCapacity = 0;
+    mTraceStart = 0;
+    mTraceMutex = NULL;
+    mTraceList = NULL;
+
 #ifdef TORQUE_MULTITHREAD
     gMainThread = Thread::getCurrentThreadId();
 #endif
@@ -170,6 +234,9 @@ Profiler::~Profiler()
 {
     reset();
     dFree(mRootProfilerData);
+    freeThreadTraces(mTraceList);
+    if (mTraceMutex)
+        Mutex::destroyMutex(mTraceMutex);
     gProfiler = NULL;
 }
 
@@ -276,6 +343,9 @@ const char* Profiler::constructProfilePath(ProfilerData* pd)
 #endif
 void Profiler::hashPush(ProfilerRootData* root)
 {
+    if (mTracing)
+        traceEvent(root);
+
 #ifdef TORQUE_MULTITHREAD
     // Ignore non-main-thread profiler activity.
     if (Thread::getCurrentThreadId() != gMainThread)
@@ -370,6 +440,9 @@ void Profiler::dumpToFile(const char* fileName)
 
 void Profiler::hashPop()
 {
+    if (mTracing)
+        traceEvent(NULL);
+
 #ifdef TORQUE_MULTITHREAD
     // Ignore non-main-thread profiler activity.
     if (Thread::getCurrentThreadId() != gMainThread)
@@ -608,6 +681,192 @@ void Profiler::enableMarker(const char* marker, bool enable)
     }
 }
 
+//-----------------------------------------------------------------------------
+
+ProfilerThreadTrace* Profiler::getThreadTrace()
+{
+    ProfilerThreadTrace* trace = sThreadTrace;
+    if (!trace)
+    {
+        trace = (ProfilerThreadTrace*)dMalloc(sizeof(ProfilerThreadTrace));
+        trace->mThreadId = Thread::getCurrentThreadId();
+        trace->mGeneration = 0;
+        trace->mEvents = NULL;
+        trace->mCapacity = 0;
+        trace->mCount = 0;
+        trace->mDepth = 0;
+
+        Mutex::lockMutex(mTraceMutex);
+        trace->mThreadIndex = mTraceList ? mTraceList->mThreadIndex + 1 : 0;
+        trace->mNext = mTraceList;
+        mTraceList = trace;
+        Mutex::unlockMutex(mTraceMutex);
+
+        sThreadTrace = trace;
+    }
+
+    if (trace->mGeneration != mTraceGeneration)
+    {
+        // First event of a new trace on this thread.  Anything still open
+        // from before it started is ignored when it ends.
+        if (trace->mCapacity != mTraceCapacity)
+        {
+            dFree(trace->mEvents);
+            trace->mEvents = (ProfilerTraceEvent*)dMalloc(sizeof(ProfilerTraceEvent) * mTraceCapacity);
+            trace->mCapacity = mTraceCapacity;
+        }
+        trace->mCount = 0;
+        trace->mDepth = 0;
+        trace->mGeneration = mTraceGeneration;
+    }
+    return trace;
+}
+
+void Profiler::traceEvent(ProfilerRootData* root)
+{
+    if (sInTraceEvent)
+        return;
+    sInTraceEvent = true;
+
+    ProfilerThreadTrace* trace = getThreadTrace();
+
+    bool record;
+    if (root)
+    {
+        record = root->mEnabled && trace->mDepth < ProfilerThreadTrace::MaxStackDepth;
+        if (trace->mDepth < ProfilerThreadTrace::MaxStackDepth)
+            trace->mRecorded[trace->mDepth] = record;
+        trace->mDepth++;
+    }
+    else if (trace->mDepth)
+    {
+        trace->mDepth--;
+        record = trace->mDepth < ProfilerThreadTrace::MaxStackDepth && trace->mRecorded[trace->mDepth];
+    }
+    else
+    {
+        // Matches a PROFILE_START from before the trace started.
+        record = false;
+    }
+
+    if (record)
+    {
+        ProfilerTraceEvent& event = trace->mEvents[trace->mCount % trace->mCapacity];
+        event.mTime = Platform::getPerformanceCounter();
+        event.mRoot = root;
+        trace->mCount++;
+    }
+
+    sInTraceEvent = false;
+}
+
+void Profiler::startTrace(U32 eventsPerThread)
+{
+    if (!mTraceMutex)
+        mTraceMutex = Mutex::createMutex();
+
+    mTracing = false;
+    mTraceCapacity = eventsPerThread > 16 ? eventsPerThread : 16;
+    mTraceGeneration++;
+    mTraceStart = Platform::getPerformanceCounter();
+    mTracing = true;
+}
+
+void Profiler::stopTrace()
+{
+    mTracing = false;
+}
+
+static void writeTraceEvent(FileStream& fws, bool& first, const char* event)
+{
+    if (!first)
+        fws.write(2, ",\n");
+    fws.write(dStrlen(event), event);
+    first = false;
+}
+
+bool Profiler::dumpTraceToFile(const char* fileName)
+{
+    stopTrace();
+
+    FileStream fws;
+    if (!fws.open(fileName, FileStream::Write))
+        return false;
+
+    // Chrome trace event format timestamps are in microseconds.
+    F64 toMicroseconds = 1000000.0 / F64(Platform::getPerformanceFrequency());
+
+    char buffer[512];
+    dStrcpy(buffer, "{\"traceEvents\":[\n");
+    fws.write(dStrlen(buffer), buffer);
+
+    bool first = true;
+    for (ProfilerThreadTrace* trace = mTraceList; trace; trace = trace->mNext)
+    {
+        if (trace->mGeneration != mTraceGeneration || !trace->mCount)
+            continue;
+
+#ifdef TORQUE_MULTITHREAD
+        bool mainThread = trace->mThreadId == gMainThread;
+#else
+        bool mainThread = true;
+#endif
+        char threadName[64];
+        if (mainThread)
+            dStrcpy(threadName, "Main");
+        else
+            dSprintf(threadName, sizeof(threadName), "Worker %d", trace->mThreadIndex);
+
+        dSprintf(buffer, sizeof(buffer),
+            "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+            trace->mThreadId, threadName);
+        writeTraceEvent(fws, first, buffer);
+
+        // Once the ring has wrapped its oldest events are gone, and with
+        // them the PROFILE_STARTs for some of the PROFILE_ENDs that are left.
+        U32 count = trace->mCount < trace->mCapacity ? trace->mCount : trace->mCapacity;
+        U32 depth = 0;
+        F64 time = 0;
+        for (U32 i = trace->mCount - count; i != trace->mCount; i++)
+        {
+            const ProfilerTraceEvent& event = trace->mEvents[i % trace->mCapacity];
+            if (!event.mRoot && !depth)
+                continue;
+
+            time = F64(S64(event.mTime - mTraceStart)) * toMicroseconds;
+            if (event.mRoot)
+            {
+                dSprintf(buffer, sizeof(buffer),
+                    "{\"name\":\"%s\",\"ph\":\"B\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+                    event.mRoot->mName, trace->mThreadId, time);
+                depth++;
+            }
+            else
+            {
+                dSprintf(buffer, sizeof(buffer),
+                    "{\"ph\":\"E\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+                    trace->mThreadId, time);
+                depth--;
+            }
+            writeTraceEvent(fws, first, buffer);
+        }
+
+        // Close whatever was still running when the trace stopped.
+        for (; depth; depth--)
+        {
+            dSprintf(buffer, sizeof(buffer),
+                "{\"ph\":\"E\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+                trace->mThreadId, time);
+            writeTraceEvent(fws, first, buffer);
+        }
+    }
+
+    dStrcpy(buffer, "\n]}\n");
+    fws.write(dStrlen(buffer), buffer);
+    fws.close();
+    return true;
+}
+
 ConsoleFunctionGroupBegin(Profiler, "Profiler functionality.");
 
 ConsoleFunction(profilerMarkerEnable, void, 3, 3, "(string markerName, bool enable)")
@@ -645,6 +904,36 @@ ConsoleFunction(profilerReset, void, 1, 1, "Resets the profiler, clearing all of
         gProfiler->reset();
 }
 
+ConsoleFunction(profilerTraceStart, void, 1, 2, "([int eventsPerThread=65536]) Start recording a timeline of profiler events on every thread.")
+{
+    if (gProfiler)
+        gProfiler->startTrace(argc > 1 ? dAtoi(argv[1]) : 65536);
+}
+
+ConsoleFunction(profilerTraceStop, void, 1, 1, "Stop recording the profiler timeline.")
+{
+    argc; argv;
+    if (gProfiler)
+        gProfiler->stopTrace();
+}
+
+ConsoleFunction(profilerTraceDump, bool, 2, 2, "(string filename) Write the profiler timeline to a file in Chrome trace format, "
+                "for chrome://tracing or ui.perfetto.dev.  Stops the trace if it is running.")
+{
+    argc;
+    if (!gProfiler)
+        return false;
+
+    char fileName[1024];
+    Con::expandScriptFilename(fileName, sizeof(fileName), argv[1]);
+    if (!gProfiler->dumpTraceToFile(fileName))
+    {
+        Con::errorf("profilerTraceDump: unable to write %s", fileName);
+        return false;
+    }
+    return true;
+}
+
 ConsoleFunctionGroupEnd(Profiler);
 
 #endif
@@ -12,6 +12,7 @@
 
 struct ProfilerData;
 struct ProfilerRootData;
+struct ProfilerThreadTrace;
 /// The Profiler is used to see how long a specific chunk of code takes to execute.
 /// All values outputted by the profiler are percentages of the time that it takes
 /// to run entire main loop.
@@ -25,6 +26,9 @@ struct ProfilerRootData;
 /// profilerDump();                                         //dumps all profiler data to the console
 /// profilerDumpToFile(string filename);                    //dumps all profiler data to a given file
 /// profilerMarkerEnable((string markerName, bool enable);  //enables or disables a given profile tag
+/// profilerTraceStart([int eventsPerThread]);               //starts recording a per-thread event timeline
+/// profilerTraceStop();                                    //stops recording the timeline
+/// profilerTraceDump(string filename);                     //writes the timeline as Chrome trace JSON
 /// @endcode
 ///
 /// The C++ code side of the profiler uses pairs of PROFILE_START() and PROFILE_END().
@@ -49,6 +53,12 @@ struct ProfilerRootData;
 /// //possibly some code here
 /// PROFILE_END();
 /// @endcode
+///
+/// The aggregated dump above only covers the main thread.  A trace instead
+/// records every PROFILE_START and PROFILE_END on every thread, with a
+/// timestamp, into a ring buffer owned by that thread.  The result can be
+/// loaded into chrome://tracing or ui.perfetto.dev to see individual frames
+/// and ticks rather than averages.
 class Profiler
 {
     enum {
@@ -68,6 +78,20 @@ class Profiler
     bool mDumpToConsole;
     bool mDumpToFile;
     char mDumpFileName[DumpFileNameLength];
+
+    /// @name Tracing
+    /// @{
+    volatile bool mTracing;
+    U32 mTraceGeneration;     ///< Bumped by every startTrace(), so threads know to reset their rings.
+    U32 mTraceCapacity;       ///< Events per thread ring.
+    U64 mTraceStart;
+    void* mTraceMutex;        ///< Guards mTraceList.
+    ProfilerThreadTrace* mTraceList;
+
+    ProfilerThreadTrace* getThreadTrace();
+    void traceEvent(ProfilerRootData* root);
+    /// @}
+
     void dump();
     void validate();
 public:
@@ -90,6 +114,20 @@ public:
     void hashPop();
     /// Enable a profiler marker
     void enableMarker(const char* marker, bool enabled);
+
+    /// Start recording a timeline of profiler events on every thread,
+    /// discarding any previous one.
+    /// @param eventsPerThread size of each thread's ring buffer; once full
+    ///        the oldest events are overwritten.
+    void startTrace(U32 eventsPerThread);
+    /// Stop recording the timeline.  The events recorded so far are kept
+    /// until the next startTrace().
+    void stopTrace();
+    bool isTracing() { return mTracing; }
+    /// Write the recorded timeline in Chrome trace event format.  Stops
+    /// tracing if it is still running.
+    /// @param fileName filename to write the trace to
+    bool dumpTraceToFile(const char* fileName);
 #ifdef TORQUE_ENABLE_PROFILE_PATH
     /// Get current profile path
     const char* getProfilePath();
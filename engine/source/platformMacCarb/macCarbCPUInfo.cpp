@@ -83,6 +83,7 @@ void Processor::init()
       }
    }
    Platform::SystemInfo.processor.mhz = mhzSpeed;
+   Platform::SystemInfo.processor.numLogicalProcessors = 1;
 
    Platform::SystemInfo.processor.type = CPU_PowerPC_Unknown;
    err = Gestalt(gestaltNativeCPUtype, &raw);
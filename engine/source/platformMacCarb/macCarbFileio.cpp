@@ -19,6 +19,8 @@
 #include <dirent.h>
 #include <unistd.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 
 #pragma message("todo: file io still needs some work...")
 
@@ -58,6 +60,17 @@ bool dFileTouch(const char *path)
 }
 
 
+//-----------------------------------------------------------------------------
+bool dFileRename(const char *oldName, const char *newName)
+{
+   if (!oldName || !*oldName || !newName || !*newName)
+      return false;
+
+   // mappings of the old newName keep its old inode
+   return( rename(oldName, newName) == 0); // rename returns 0 on success.
+}
+
+
 //-----------------------------------------------------------------------------
 // Constructors & Destructor
 //-----------------------------------------------------------------------------
@@ -612,6 +625,36 @@ S32 Platform::getFileSize(const char* pFilePath)
    return (S32)statData.st_size;
 }
 
+//-----------------------------------------------------------------------------
+const U8* Platform::mapFile(const char* pFilePath, U32* size, void** mapping)
+{
+   if (!pFilePath || !*pFilePath)
+      return NULL;
+
+   int fd = open(pFilePath, O_RDONLY);
+   if (fd == -1)
+      return NULL;
+
+   struct stat statData;
+   void* data = MAP_FAILED;
+   if (fstat(fd, &statData) != -1 && statData.st_size > 0)
+      data = mmap(NULL, statData.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+   // the mapping keeps the file open
+   close(fd);
+   if (data == MAP_FAILED)
+      return NULL;
+
+   *size = statData.st_size;
+   *mapping = NULL;
+   return (const U8*)data;
+}
+
+void Platform::unmapFile(const U8* data, U32 size, void* mapping)
+{
+   munmap((void*)data, size);
+}
+
 
 //-----------------------------------------------------------------------------
 bool Platform::isSubDirectory(const char *pathParent, const char *pathSub)
@@ -43,6 +43,18 @@ U32 Platform::getRealMilliseconds()
    return (time.hi*0x100000000LL)/1000 + (time.lo/1000);
 }   
 
+U64 Platform::getPerformanceCounter()
+{
+   UnsignedWide time;
+   Microseconds(&time);
+   return (U64(time.hi) << 32) | U64(time.lo);
+}
+
+U64 Platform::getPerformanceFrequency()
+{
+   return 1000000;
+}
+
 U32 Platform::getVirtualMilliseconds()
 {
    return platState.currentTime;   
@@ -321,13 +321,16 @@ void bitmapConvertRGB_to_5551_mmx(U8* src, U32 pixels)
 //--------------------------------------------------------------------------
 void PlatformBlitInit()
 {
+    // bitmapExtrudeRGB keeps its default, which is the SSE2 version when
+    // the compiler can use it.
     bitmapExtrude5551 = bitmapExtrude5551_asm;
-    bitmapExtrudeRGB = bitmapExtrudeRGB_c;
 
     if (Platform::SystemInfo.processor.properties & CPU_PROP_MMX)
     {
 #if defined(TORQUE_SUPPORTS_VC_INLINE_X86_ASM)
+#if !defined(TORQUE_BITMAP_SSE2)
         bitmapExtrudeRGB = bitmapExtrudeRGB_mmx;
+#endif
         bitmapConvertRGB_to_5551 = bitmapConvertRGB_to_5551_mmx;
 #endif
     }
@@ -62,6 +62,31 @@ bool dFileTouch(const char* name)
     return(utime(name, 0) != -1);
 }
 
+bool dFileRename(const char* oldName, const char* newName)
+{
+    if (!oldName || !newName || dStrlen(oldName) >= MAX_PATH || dStrlen(newName) >= MAX_PATH)
+        return(false);
+
+    char oldBuf[MAX_PATH];
+    char newBuf[MAX_PATH];
+    dStrcpy(oldBuf, oldName);
+    dStrcpy(newBuf, newName);
+    backslash(oldBuf);
+    backslash(newBuf);
+#ifdef UNICODE
+    UTF16 oldFile[MAX_PATH];
+    UTF16 newFile[MAX_PATH];
+    convertUTF8toUTF16((UTF8*)oldBuf, oldFile, sizeof(oldFile));
+    convertUTF8toUTF16((UTF8*)newBuf, newFile, sizeof(newFile));
+#else
+    char* oldFile = oldBuf;
+    char* newFile = newBuf;
+#endif
+
+    // Fails while newName is mapped, which leaves the mapping intact.
+    return(MoveFileEx(oldFile, newFile, MOVEFILE_REPLACE_EXISTING) != 0);
+}
+
 //-----------------------------------------------------------------------------
 // Constructors & Destructor
 //-----------------------------------------------------------------------------
@@ -102,8 +127,9 @@ File::~File()
 //-----------------------------------------------------------------------------
 File::Status File::open(const char* filename, const AccessMode openMode)
 {
-    static char filebuf[2048];
-    dStrcpy(filebuf, filename);
+    char filebuf[2048];
+    dStrncpy(filebuf, filename, sizeof(filebuf) - 1);
+    filebuf[sizeof(filebuf) - 1] = 0;
     backslash(filebuf);
 #ifdef UNICODE
     UTF16 fname[2048];
@@ -705,6 +731,56 @@ S32 Platform::getFileSize(const char* pFilePath)
     return findData.nFileSizeLow;;
 }
 
+//--------------------------------------
+const U8* Platform::mapFile(const char* pFilePath, U32* size, void** mapping)
+{
+    if (!pFilePath || !*pFilePath)
+        return NULL;
+
+    char filebuf[2048];
+    dStrncpy(filebuf, pFilePath, sizeof(filebuf) - 1);
+    filebuf[sizeof(filebuf) - 1] = 0;
+    backslash(filebuf);
+#ifdef UNICODE
+    UTF16 fname[2048];
+    convertUTF8toUTF16((UTF8*)filebuf, fname, sizeof(fname));
+#else
+    char* fname = filebuf;
+#endif
+
+    HANDLE file = CreateFile(fname, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return NULL;
+
+    DWORD fileSize = GetFileSize(file, NULL);
+    HANDLE map = NULL;
+    if (fileSize != 0 && fileSize != INVALID_FILE_SIZE)
+        map = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+    // The mapping keeps the file open.
+    CloseHandle(file);
+    if (map == NULL)
+        return NULL;
+
+    const U8* data = (const U8*)MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
+    if (!data)
+    {
+        CloseHandle(map);
+        return NULL;
+    }
+
+    *size = fileSize;
+    *mapping = (void*)map;
+    return data;
+}
+
+void Platform::unmapFile(const U8* data, U32 size, void* mapping)
+{
+    UnmapViewOfFile(data);
+    CloseHandle((HANDLE)mapping);
+}
+
 
 //--------------------------------------
 bool Platform::isDirectory(const char* pDirPath)
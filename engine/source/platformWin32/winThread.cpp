@@ -52,6 +52,7 @@ static DWORD WINAPI ThreadRunHandler(void* arg)
     WinThreadData* threadData = reinterpret_cast<WinThreadData*>(arg);
 
     threadData->mThread->run(threadData->mRunArg);
+    Memory::flushThreadCache();
     Semaphore::releaseSemaphore(threadData->mSemaphore);
 
     return(0);
@@ -81,6 +81,20 @@ U32 Platform::getRealMilliseconds()
     return GetTickCount();
 }
 
+U64 Platform::getPerformanceCounter()
+{
+    LARGE_INTEGER count;
+    QueryPerformanceCounter(&count);
+    return count.QuadPart;
+}
+
+U64 Platform::getPerformanceFrequency()
+{
+    LARGE_INTEGER freq;
+    QueryPerformanceFrequency(&freq);
+    return freq.QuadPart;
+}
+
 U32 Platform::getVirtualMilliseconds()
 {
     return winState.currentTime;
@@ -39,8 +39,9 @@ void bitmapExtrude5551_asm(const void *srcMip, void *mip, U32 height, U32 width)
 //--------------------------------------------------------------------------
 void PlatformBlitInit()
 {
+   // bitmapExtrudeRGB keeps its default, which is the SSE2 version when
+   // the compiler can use it.
    bitmapExtrude5551 = bitmapExtrude5551_asm;
-   bitmapExtrudeRGB  = bitmapExtrudeRGB_c;
 
    if (Platform::SystemInfo.processor.properties & CPU_PROP_MMX)
    {
@@ -10,6 +10,7 @@
 #include "console/console.h"
 #include "core/stringTable.h"
 #include <math.h>
+#include <unistd.h>
 
 Platform::SystemInfo_struct Platform::SystemInfo;
 
@@ -42,6 +43,9 @@ void Processor::init()
    Platform::SystemInfo.processor.mhz  = 0;
    Platform::SystemInfo.processor.properties = CPU_PROP_C;
 
+   long numCpus = sysconf(_SC_NPROCESSORS_ONLN);
+   Platform::SystemInfo.processor.numLogicalProcessors = numCpus > 0 ? U32(numCpus) : 1;
+
    clockticks = properties = processor = 0;
    dStrcpy(vendor, "");
 
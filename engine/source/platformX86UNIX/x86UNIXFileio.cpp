@@ -55,6 +55,7 @@
 #include <dirent.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
@@ -379,6 +380,22 @@ bool dFileTouch(const char * name)
    return ModifyFile(name, TOUCH);
 }
 
+//-----------------------------------------------------------------------------
+bool dFileRename(const char * oldName, const char * newName)
+{
+   if (!oldName || !newName || dStrstr(oldName, "../") != NULL || dStrstr(newName, "../") != NULL)
+      return(false);
+
+   // both live where File::open() writes them
+   char oldPathName[MaxPath];
+   char newPathName[MaxPath];
+   MungePath(oldPathName, MaxPath, oldName, GetPrefDir());
+   MungePath(newPathName, MaxPath, newName, GetPrefDir());
+
+   // mappings of the old newName keep its old inode
+   return (rename(oldPathName, newPathName) != -1);
+}
+
 //-----------------------------------------------------------------------------
 // Constructors & Destructor
 //-----------------------------------------------------------------------------
@@ -997,3 +1014,43 @@ S32 Platform::getFileSize(const char *pFilePath)
     // Must be something else or we can't read the file.
     return -1;
 }
+
+//-----------------------------------------------------------------------------
+const U8* Platform::mapFile(const char* pFilePath, U32* size, void** mapping)
+{
+   if (!pFilePath || !*pFilePath)
+      return NULL;
+
+   // same search order as File::open for reading
+   char prefPathName[MaxPath];
+   char gamePathName[MaxPath];
+   char cwd[MaxPath];
+   getcwd(cwd, MaxPath);
+   MungePath(prefPathName, MaxPath, pFilePath, GetPrefDir());
+   MungePath(gamePathName, MaxPath, pFilePath, cwd);
+
+   int fd = x86UNIXOpen(prefPathName, O_RDONLY);
+   if (fd == -1)
+      fd = x86UNIXOpen(gamePathName, O_RDONLY);
+   if (fd == -1)
+      return NULL;
+
+   struct stat filestat;
+   void* data = MAP_FAILED;
+   if (fstat(fd, &filestat) != -1 && filestat.st_size > 0)
+      data = mmap(NULL, filestat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+   // the mapping keeps the file open
+   x86UNIXClose(fd);
+   if (data == MAP_FAILED)
+      return NULL;
+
+   *size = filestat.st_size;
+   *mapping = NULL;
+   return (const U8*)data;
+}
+
+void Platform::unmapFile(const U8* data, U32 size, void* mapping)
+{
+   munmap((void*)data, size);
+}
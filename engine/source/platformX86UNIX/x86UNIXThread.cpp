@@ -55,6 +55,7 @@ static void *ThreadRunHandler(void * arg)
    x86UNIXThreadData * threadData = reinterpret_cast<x86UNIXThreadData*>(arg);
 
    threadData->mThread->run(threadData->mRunArg);
+   Memory::flushThreadCache();
    Semaphore::releaseSemaphore(threadData->mSemaphore);
    return NULL;
 }
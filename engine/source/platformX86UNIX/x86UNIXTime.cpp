@@ -50,6 +50,18 @@ U32 Platform::getRealMilliseconds()
    return x86UNIXGetTickCount();
 }
 
+U64 Platform::getPerformanceCounter()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return U64(ts.tv_sec) * 1000000000ULL + U64(ts.tv_nsec);
+}
+
+U64 Platform::getPerformanceFrequency()
+{
+   return 1000000000ULL;
+}
+
 U32 Platform::getVirtualMilliseconds()
 {
    return x86UNIXState->currentTime;
@@ -18,6 +18,9 @@ SFXDSBuffer* SFXDSBuffer::create(   IDirectSound8 *dsound,
    AssertFatal( dsound, "SFXDSBuffer::create() - Got null dsound!" );
    AssertFatal( profile, "SFXDSBuffer::create() - Got null profile!" );
 
+   // Decode the sample data now, we can't play a sound without it.
+   if ( !profile->getResource()->getData() )
+      return NULL;
 
    // Return the buffer.
    SFXDSBuffer* buffer = new SFXDSBuffer( dsound,
@@ -18,6 +18,10 @@ SFXFMODBuffer* SFXFMODBuffer::create( SFXProfile *profile )
    const SFXDescription *desc = profile->getDescription();
    const Resource<SFXResource> &res = profile->getResource();
 
+   // Decode the sample data now, we can't play a sound without it.
+   if ( !res->getData() )
+      return NULL;
+
    FMOD_SOUND *sound = NULL;
 
    // create new Sound
@@ -7,8 +7,11 @@
 #include "sfx/null/sfxNullBuffer.h"
 
 
-SFXNullBuffer::SFXNullBuffer()
+SFXNullBuffer::SFXNullBuffer( const Resource<SFXResource> &resource, bool streaming )
 {
+   mIsStreaming = streaming;
+   if ( streaming )
+      mResource = resource;
 }
 
 SFXNullBuffer::~SFXNullBuffer()
@@ -9,15 +9,22 @@
 #ifndef _SFXBUFFER_H_
    #include "sfx/sfxBuffer.h"
 #endif
+#ifndef _SFXRESOURCE_H_
+   #include "sfx/sfxResource.h"
+#endif
 
 
 class SFXNullBuffer : public SFXBuffer
 {
    friend class SFXNullDevice;
+   friend class SFXNullVoice;
 
    protected:
 
-      SFXNullBuffer();
+      SFXNullBuffer( const Resource<SFXResource> &resource, bool streaming );
+
+      /// Only kept for streaming buffers.
+      Resource<SFXResource> mResource;
 
    public:
 
@@ -8,6 +8,7 @@
 #include "sfx/null/sfxNullDevice.h"
 #include "sfx/null/sfxNullBuffer.h"
 #include "sfx/sfxListener.h"
+#include "sfx/sfxProfile.h"
 
 
 SFXNullDevice::SFXNullDevice( SFXProvider* provider, 
@@ -34,7 +35,8 @@ SFXBuffer* SFXNullDevice::createBuffer( SFXProfile *profile )
 {
    AssertFatal( profile, "SFXNullDevice::createBuffer() - Got null profile!" );
 
-   SFXNullBuffer* buffer = new SFXNullBuffer();
+   SFXNullBuffer* buffer = new SFXNullBuffer(   profile->getResource(),
+                                                profile->isStreaming() );
    if ( !buffer )
       return NULL;
 
@@ -54,7 +56,7 @@ SFXVoice* SFXNullDevice::createVoice( SFXBuffer *buffer )
    SFXNullBuffer* nullBuffer = dynamic_cast<SFXNullBuffer*>( buffer );
    AssertFatal( nullBuffer, "SFXNullDevice::createVoice() - Got bad buffer!" );
 
-   SFXNullVoice* voice = new SFXNullVoice();
+   SFXNullVoice* voice = new SFXNullVoice( nullBuffer );
    if ( !voice )
       return NULL;
 
@@ -79,4 +81,11 @@ void SFXNullDevice::deleteVoice( SFXVoice* voice )
 
 void SFXNullDevice::update( const SFXListener& listener )
 {
+   // Pretend to play the streaming voices so that
+   // streaming can be exercised without a sound card.
+   const U32 time = Platform::getRealMilliseconds();
+
+   SFXNullVoiceVector::iterator iter = mVoices.begin();
+   for ( ; iter != mVoices.end(); iter++ )
+      (*iter)->_updateStream( time );
 }
\ No newline at end of file
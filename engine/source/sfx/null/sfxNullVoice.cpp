@@ -7,21 +7,43 @@
 #include "sfx/null/sfxNullVoice.h"
 
 #include "sfx/null/sfxNullDevice.h"
+#include "sfx/null/sfxNullBuffer.h"
+#include "sfx/sfxStream.h"
 
 
-SFXNullVoice::SFXNullVoice() 
-   : mStatus( SFXStatusNull )
+SFXNullVoice::SFXNullVoice( SFXNullBuffer *buffer ) 
+   :  mStatus( SFXStatusNull ),
+      mStreamer( NULL ),
+      mSampleBytes( 1 ),
+      mFrequency( 0 ),
+      mLastUpdateTime( 0 ),
+      mPlayedBytes( 0 )
 {
+   if ( buffer->isStreaming() )
+   {
+      SFXStream *stream = buffer->mResource->openStream();
+      if ( stream )
+      {
+         mSampleBytes = buffer->mResource->getSampleBytes();
+         mFrequency = buffer->mResource->getFrequency();
+         mStreamer = new SFXStreamer( stream, mSampleBytes );
+         mStreamer->seek( 0 );
+      }
+   }
 }
 
 SFXNullVoice::~SFXNullVoice()
 {
-
+   delete mStreamer;
 }
 
 void SFXNullVoice::setPosition( U32 pos )
 {
+   if ( !mStreamer )
+      return;
 
+   mStreamer->seek( pos / mSampleBytes );
+   mPlayedBytes = 0;
 }
 
 void SFXNullVoice::setMinMaxDistance( F32 min, F32 max )
@@ -32,6 +54,12 @@ void SFXNullVoice::setMinMaxDistance( F32 min, F32 max )
 
 void SFXNullVoice::play( bool looping )
 {
+   if ( mStreamer )
+   {
+      mStreamer->setLooping( looping );
+      mLastUpdateTime = Platform::getRealMilliseconds();
+   }
+
    mStatus = SFXStatusPlaying;
 }
 
@@ -43,6 +71,48 @@ void SFXNullVoice::pause()
 void SFXNullVoice::stop()
 {
    mStatus = SFXStatusStopped;
+
+   if ( mStreamer )
+   {
+      mStreamer->seek( 0 );
+      mPlayedBytes = 0;
+   }
+}
+
+void SFXNullVoice::_updateStream( U32 time )
+{
+   if ( !mStreamer )
+      return;
+
+   const U32 elapsed = time - mLastUpdateTime;
+   mLastUpdateTime = time;
+
+   if ( mStatus != SFXStatusPlaying )
+      return;
+
+   mPlayedBytes += ( (U64)elapsed * mFrequency * mSampleBytes ) / 1000;
+
+   const U8 *data;
+   U32 size;
+   bool havePacket;
+   while ( ( havePacket = mStreamer->getPacket( &data, &size ) ) && mPlayedBytes >= size )
+   {
+      mPlayedBytes -= size;
+      mStreamer->releasePacket();
+   }
+
+   // An underrun is silence, not lost data.
+   if ( !havePacket )
+      mPlayedBytes = 0;
+
+   if ( mStreamer->isFinished() )
+   {
+      mStatus = SFXStatusStopped;
+      mStreamer->seek( 0 );
+      mPlayedBytes = 0;
+   }
+   else
+      mStreamer->update();
 }
 
 SFXStatus SFXNullVoice::getStatus() const
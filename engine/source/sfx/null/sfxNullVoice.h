@@ -13,6 +13,9 @@
    #include "sfx/sfxStatus.h"
 #endif
 
+class SFXNullBuffer;
+class SFXStreamer;
+
 
 class SFXNullVoice : public SFXVoice
 {
@@ -20,14 +23,35 @@ class SFXNullVoice : public SFXVoice
 
    protected:
 
-      SFXNullVoice();
+      SFXNullVoice( SFXNullBuffer *buffer );
 
       SFXStatus mStatus;
 
+      /// The streamer for a streaming buffer or NULL.
+      SFXStreamer *mStreamer;
+
+      /// The bytes in a sample of the stream.
+      U32 mSampleBytes;
+
+      /// The samples per second of the stream.
+      U32 mFrequency;
+
+      /// The last time _updateStream() was called.
+      U32 mLastUpdateTime;
+
+      /// The bytes which have played since the front
+      /// packet of the stream was reached.
+      U32 mPlayedBytes;
+
    public:
 
       virtual ~SFXNullVoice();
 
+      /// Releases the stream packets that would have 
+      /// played by now on a real device and stops the
+      /// voice once the stream runs out.
+      void _updateStream( U32 time );
+
       void setPosition( U32 pos );
 
       void setMinMaxDistance( F32 min, F32 max );
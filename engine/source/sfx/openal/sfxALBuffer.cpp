@@ -15,10 +15,16 @@ SFXALBuffer* SFXALBuffer::create(   const OPENALFNTABLE &oalft,
 {
    AssertFatal( profile, "SFXALBuffer::create() - Got null profile!" );
 
+   // Streams are decoded as they play, everything else
+   // needs its sample data now.
+   if ( !profile->isStreaming() && !profile->getResource()->getData() )
+      return NULL;
+
    SFXALBuffer *buffer = new SFXALBuffer( oalft,
                                           profile->getResource(),
                                           profile->getDescription()->mIs3D,
-                                          useHardware );
+                                          useHardware,
+                                          profile->isStreaming() );
 
    return buffer;
 }
@@ -26,12 +32,14 @@ SFXALBuffer* SFXALBuffer::create(   const OPENALFNTABLE &oalft,
 SFXALBuffer::SFXALBuffer(  const OPENALFNTABLE &oalft, 
                            const Resource<SFXResource> &resource,
                            bool is3d,
-                           bool useHardware )
+                           bool useHardware,
+                           bool streaming )
    :  mOpenAL( oalft ),
       mResource( resource ),
       mIs3d( is3d ),
       mUseHardware( useHardware )
 {
+   mIsStreaming = streaming;
 }
 
 SFXALBuffer::~SFXALBuffer()
@@ -42,10 +50,7 @@ bool SFXALBuffer::createVoice(   ALuint *bufferName,
                                  ALuint *sourceName,
                                  ALenum *bufferFormat ) const
 {
-   mOpenAL.alGenBuffers( 1, bufferName );
    mOpenAL.alGenSources( 1, sourceName );
-
-   AssertFatal( mOpenAL.alIsBuffer( *bufferName ), "AL Buffer Sanity Check Failed!" ); \
    AssertFatal( mOpenAL.alIsSource( *sourceName ), "AL Source Sanity Check Failed!" );
 
    // Stereo 16 == 32 bits per sample, 16 per channel
@@ -57,6 +62,15 @@ bool SFXALBuffer::createVoice(   ALuint *bufferName,
    // Is this 3d?
    mOpenAL.alSourcei( *sourceName, AL_SOURCE_RELATIVE, ( mIs3d ? AL_FALSE : AL_TRUE ) );
 
+   // The voice queues buffers of stream data itself.
+   if ( mIsStreaming )
+   {
+      *bufferName = 0;
+      return true;
+   }
+
+   mOpenAL.alGenBuffers( 1, bufferName );
+
    AssertFatal( mOpenAL.alIsBuffer( *bufferName ), "AL Buffer Sanity Check Failed!" ); \
    AssertFatal( mOpenAL.alIsSource( *sourceName ), "AL Source Sanity Check Failed!" );
 
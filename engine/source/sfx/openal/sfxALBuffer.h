@@ -30,7 +30,8 @@ class SFXALBuffer : public SFXBuffer
       SFXALBuffer(   const OPENALFNTABLE &oalft, 
                      const Resource<SFXResource> &resource,
                      bool is3d,
-                     bool useHardware );
+                     bool useHardware,
+                     bool streaming );
 
       ///
       Resource<SFXResource> mResource;
@@ -51,7 +52,8 @@ class SFXALBuffer : public SFXBuffer
 
       virtual ~SFXALBuffer();
 
-      ///
+      /// Creates the source for a new voice.  For a streaming
+      /// buffer no AL buffer is created and bufferName is zero.
       bool createVoice( ALuint *bufferName,
                         ALuint *sourceName,
                         ALenum *bufferFormat ) const;
@@ -8,10 +8,11 @@
 
 #include "sfx/openal/sfxALBuffer.h"
 #include "sfx/openal/sfxALDevice.h"
+#include "sfx/sfxStream.h"
 
 #ifdef TORQUE_DEBUG
 #  define AL_SANITY_CHECK() \
-   AssertFatal( mOpenAL.alIsBuffer( mBufferName ), "AL Buffer Sanity Check Failed!" ); \
+   AssertFatal( !mBufferName || mOpenAL.alIsBuffer( mBufferName ), "AL Buffer Sanity Check Failed!" ); \
    AssertFatal( mOpenAL.alIsSource( mSourceName ), "AL Source Sanity Check Failed!" );
 #else
 #  define AL_SANITY_CHECK() 
@@ -30,11 +31,33 @@ SFXALVoice* SFXALVoice::create( SFXALBuffer *buffer )
                               &bufferFormat ) )
       return NULL;
 
+   SFXStream *stream = NULL;
+   if ( buffer->isStreaming() )
+   {
+      stream = buffer->mResource->openStream();
+      if ( !stream )
+      {
+         buffer->mOpenAL.alDeleteSources( 1, &sourceName );
+         return NULL;
+      }
+   }
+
    SFXALVoice *voice = new SFXALVoice( buffer->mOpenAL,
                                        buffer,
                                        bufferName,
                                        sourceName );
 
+   if ( stream )
+   {
+      voice->mStreamFormat = bufferFormat;
+      voice->mStreamFrequency = buffer->mResource->getFrequency();
+      voice->mStreamSampleBytes = buffer->mResource->getSampleBytes();
+      voice->mStreamer = new SFXStreamer( stream, voice->mStreamSampleBytes );
+
+      voice->mOpenAL.alGenBuffers( NumStreamBuffers, voice->mStreamBuffers );
+      voice->_resetStream( 0 );
+   }
+
    return voice;
 }
 
@@ -48,7 +71,12 @@ SFXALVoice::SFXALVoice( const OPENALFNTABLE &oalft,
       mIsPlaying( false ), 
       mBufferName( bufferName ), 
       mSourceName( sourceName ),
-      mIs3D(buffer->mIs3d)
+      mIs3D(buffer->mIs3d),
+      mStreamer( NULL ),
+      mNumFreeBuffers( 0 ),
+      mStreamFormat( 0 ),
+      mStreamFrequency( 0 ),
+      mStreamSampleBytes( 1 )
 {
    AL_SANITY_CHECK();
 }
@@ -56,12 +84,94 @@ SFXALVoice::SFXALVoice( const OPENALFNTABLE &oalft,
 SFXALVoice::~SFXALVoice()
 {
    mOpenAL.alDeleteSources( 1, &mSourceName );
-   mOpenAL.alDeleteBuffers( 1, &mBufferName );
+
+   if ( mStreamer )
+   {
+      mOpenAL.alDeleteBuffers( NumStreamBuffers, mStreamBuffers );
+      delete mStreamer;
+   }
+   else
+      mOpenAL.alDeleteBuffers( 1, &mBufferName );
+}
+
+void SFXALVoice::_queueStream()
+{
+   ALint processed = 0;
+   mOpenAL.alGetSourcei( mSourceName, AL_BUFFERS_PROCESSED, &processed );
+   while ( processed-- > 0 )
+   {
+      ALuint buffer;
+      mOpenAL.alSourceUnqueueBuffers( mSourceName, 1, &buffer );
+      mFreeBuffers[ mNumFreeBuffers++ ] = buffer;
+   }
+
+   const U8 *data;
+   U32 size;
+   while ( mNumFreeBuffers > 0 && mStreamer->getPacket( &data, &size ) )
+   {
+      ALuint buffer = mFreeBuffers[ --mNumFreeBuffers ];
+      mOpenAL.alBufferData( buffer, mStreamFormat, data, size, mStreamFrequency );
+      mOpenAL.alSourceQueueBuffers( mSourceName, 1, &buffer );
+      mStreamer->releasePacket();
+   }
+
+   mStreamer->update();
+}
+
+void SFXALVoice::_resetStream( U32 sample )
+{
+   // Stopping marks every queued buffer as processed
+   // and detaching the buffer empties the queue.
+   mOpenAL.alSourceStop( mSourceName );
+   mOpenAL.alSourcei( mSourceName, AL_BUFFER, 0 );
+
+   mNumFreeBuffers = NumStreamBuffers;
+   for ( U32 i = 0; i < NumStreamBuffers; i++ )
+      mFreeBuffers[i] = mStreamBuffers[i];
+
+   mStreamer->seek( sample );
+   _queueStream();
+}
+
+void SFXALVoice::_updateStream()
+{
+   if ( !mStreamer )
+      return;
+
+   _queueStream();
+
+   if ( !mIsPlaying )
+      return;
+
+   ALint state, queued;
+   mOpenAL.alGetSourcei( mSourceName, AL_SOURCE_STATE, &state );
+   if ( state == AL_PLAYING || state == AL_PAUSED )
+      return;
+
+   // The source ran dry.  Either the decode fell behind
+   // and we pick up again, or the stream is done.
+   mOpenAL.alGetSourcei( mSourceName, AL_BUFFERS_QUEUED, &queued );
+   if ( queued > 0 )
+      mOpenAL.alSourcePlay( mSourceName );
+   else if ( mStreamer->isFinished() )
+   {
+      mIsPlaying = false;
+      _resetStream( 0 );
+   }
 }
 
 void SFXALVoice::setPosition( U32 pos )
 {
    AL_SANITY_CHECK();
+
+   if ( mStreamer )
+   {
+      _resetStream( pos / mStreamSampleBytes );
+      if ( mIsPlaying )
+         mOpenAL.alSourcePlay( mSourceName );
+      return;
+   }
+
    mOpenAL.alSourcei( mSourceName, AL_SAMPLE_OFFSET, pos );
 }
 
@@ -79,6 +189,11 @@ SFXStatus SFXALVoice::getStatus() const
 
    ALint state;
    mOpenAL.alGetSourcei( mSourceName, AL_SOURCE_STATE, &state );
+
+   // A streaming source stops on an underrun, so
+   // go by our own flag instead.
+   if ( mStreamer && state != AL_PAUSED )
+      return mIsPlaying ? SFXStatusPlaying : SFXStatusStopped;
    
    if ( state == AL_PLAYING )
       return SFXStatusPlaying;
@@ -93,6 +208,17 @@ void SFXALVoice::play( bool looping )
 {
    AL_SANITY_CHECK();
 
+   if ( mStreamer )
+   {
+      // The streamer does the looping.
+      mStreamer->setLooping( looping );
+      mOpenAL.alSourcei( mSourceName, AL_LOOPING, AL_FALSE );
+      _queueStream();
+      mOpenAL.alSourcePlay( mSourceName );
+      mIsPlaying = true;
+      return;
+   }
+
    mOpenAL.alSourceStop( mSourceName );
    mOpenAL.alSourcei( mSourceName, AL_LOOPING, ( looping ? AL_TRUE : AL_FALSE ) );
    mOpenAL.alSourcePlay( mSourceName );
@@ -127,6 +253,13 @@ void SFXALVoice::stop()
 {
    AL_SANITY_CHECK();
 
+   if ( mStreamer )
+   {
+      mIsPlaying = false;
+      _resetStream( 0 );
+      return;
+   }
+
    mOpenAL.alSourceStop( mSourceName );
    
    mResumeAtSampleOffset = -1.0f;
@@ -15,6 +15,7 @@
 #endif
 
 class SFXALBuffer;
+class SFXStreamer;
 
 
 class SFXALVoice : public SFXVoice
@@ -28,8 +29,42 @@ class SFXALVoice : public SFXVoice
                   ALuint bufferName,
                   ALuint sourceName );
 
+      enum
+      {
+         /// The number of AL buffers queued on a streaming source.
+         NumStreamBuffers = 3,
+      };
+
+      /// For streaming voices, true from play() until
+      /// the stream runs out or the voice is stopped.  The
+      /// AL source itself stops whenever the queue underruns.
       bool mIsPlaying;
 
+      /// The streamer for a streaming buffer or NULL.
+      SFXStreamer *mStreamer;
+
+      /// The AL buffers cycled through the source's queue.
+      ALuint mStreamBuffers[ NumStreamBuffers ];
+
+      /// The stream buffers not currently queued.
+      ALuint mFreeBuffers[ NumStreamBuffers ];
+
+      ///
+      U32 mNumFreeBuffers;
+
+      /// The format, frequency and sample size of the stream.
+      ALenum mStreamFormat;
+      U32 mStreamFrequency;
+      U32 mStreamSampleBytes;
+
+      /// Takes back the processed buffers and queues 
+      /// whatever stream packets are ready.
+      void _queueStream();
+
+      /// Empties the source's queue and restarts the 
+      /// stream at the sample.
+      void _resetStream( U32 sample );
+
       ALuint mBufferName;
 
       ALuint mSourceName;
@@ -68,6 +103,10 @@ class SFXALVoice : public SFXVoice
       void setPitch( F32 pitch );
 
       bool is3D() { return mIs3D; }
+
+      /// Keeps a streaming voice's queue full.  Called 
+      /// from SFXALDevice::update().
+      void _updateStream();
 };
 
 
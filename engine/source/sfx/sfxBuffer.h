@@ -13,16 +13,26 @@
 
 /// The buffer interface hides the details of how
 /// the device holds sound data for playback.
+///
+/// A streaming buffer holds no sound data at all.  Each
+/// voice created from it decodes its own data a piece at
+/// a time through an SFXStreamer.
 class SFXBuffer : public RefBase
 {
    protected:
 
-      SFXBuffer() {}
+      SFXBuffer() : mIsStreaming( false ) {}
+
+      /// True if voices stream their data.
+      bool mIsStreaming;
 
    public:
 
       /// The destructor.
       virtual ~SFXBuffer() {}
+
+      /// Returns true if this is a streaming buffer.
+      bool isStreaming() const { return mIsStreaming; }
    
 };
 
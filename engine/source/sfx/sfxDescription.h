@@ -30,6 +30,9 @@ class SFXDescription : public SimDataBlock
 
       bool mIsLooping;
 
+      /// If set, sounds which support it are decoded a piece
+      /// at a time while they play instead of all at once.
+      /// Devices that can't stream play them fully decoded.
       bool mIsStreaming;
 
       bool mIs3D;
@@ -31,11 +31,12 @@ S32 QSORT_CALLBACK SFXListener::sourceCompare( const void* item1, const void* it
    const SFXSource* source2 = *((SFXSource**)item2);
 
 	// Sounds that are playing are always sorted 
-	// closer than non-playing sounds.
-	if ( !source1->isPlaying() )
-		return 1;
-	if ( !source2->isPlaying() )
-		return -1;
+	// closer than non-playing sounds.  We use the
+   // last status as the system has just updated it.
+   const bool playing1 = source1->getLastStatus() == SFXStatusPlaying;
+   const bool playing2 = source2->getLastStatus() == SFXStatusPlaying;
+   if ( playing1 != playing2 )
+      return playing1 ? -1 : 1;
 
    // The sources with louder attenuated 
    // volume are higher priority.
@@ -61,15 +62,17 @@ void SFXListener::sortSources( SFXSourceVector& sources )
 {
    PROFILE_SCOPE( SFXListener_SortSources );
 
-   // First have the sources update the attenuated
-   // volume for each source.
-   SFXSourceVector::iterator iter = sources.begin();  
-   for ( ; iter != sources.end(); iter++ )
-      (*iter)->_updateVolume( mTransform );
+   // The volumes change only a little between updates so
+   // the sources are mostly still in order from the last
+   // sort.  An insertion sort is close to linear for that.
+   for ( S32 i = 1; i < sources.size(); i++ )
+   {
+      SFXSource* source = sources[i];
 
-   // Now sort the source vector by the attenuated 
-   // volume and channel priorities.  This leaves us
-   // with the loudest and highest priority sounds 
-   // at the front of the vector.
-   dQsort( (void *)sources.address(), sources.size(), sizeof(SFXSource*), sourceCompare );
+      S32 j = i - 1;
+      for ( ; j >= 0 && sourceCompare( &sources[j], &source ) > 0; j-- )
+         sources[j+1] = sources[j];
+
+      sources[j+1] = source;
+   }
 }
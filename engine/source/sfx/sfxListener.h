@@ -55,7 +55,8 @@ class SFXListener
       ///
       const VectorF& getVelocity() const { return mVelocity; }
 
-      ///
+      /// Sorts the sources by priority with the loudest first.
+      /// The attenuated volumes must already be up to date.
       void sortSources( SFXSourceVector& sources );
 };
 
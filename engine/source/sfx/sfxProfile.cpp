@@ -183,6 +183,14 @@ bool SFXProfile::_preloadBuffer()
    return mBuffer;
 }
 
+bool SFXProfile::isStreaming() const
+{
+   return   mDescription && 
+            mDescription->mIsStreaming &&
+            mResource &&
+            mResource->canStream();
+}
+
 SFXBuffer* SFXProfile::getBuffer()
 {
    if ( mBuffer )
@@ -100,6 +100,10 @@ class SFXProfile : public SimDataBlock
       /// 
       const Resource<SFXResource>& getResource() const { return mResource; }
 
+      /// Returns true if the description asks for streaming
+      /// and the loaded resource supports it.
+      bool isStreaming() const;
+
       /// Returns the device buffer for this for this 
       /// sound.  It will load it from disk if it has
       /// not been created already.
@@ -40,7 +40,13 @@ Resource<SFXResource> SFXResource::load( const char* filename )
    // load directly without us futzing with the extension.
    Resource<SFXResource> buffer = ResourceManager->load( filename );
    if ( (bool)buffer )
+   {
+      // Keep the path found by the first load, this may
+      // just be the extensionless name of a cached resource.
+      if ( !buffer->mFilePath )
+         buffer->mFilePath = StringTable->insert( filename );
       return buffer;
+   }
 
    // TODO: Fix the resource manager to deal with loading
    // resources by extensionless name and type using a 
@@ -60,7 +66,10 @@ Resource<SFXResource> SFXResource::load( const char* filename )
    {
       ResourceManager->add( filename, SFXWavResource::create( *stream ) );
       ResourceManager->closeStream( stream );
-      return ResourceManager->load( filename );
+      buffer = ResourceManager->load( filename );
+      if ( (bool)buffer )
+         buffer->mFilePath = StringTable->insert( temp );
+      return buffer;
    }
    else
    {
@@ -74,7 +83,10 @@ Resource<SFXResource> SFXResource::load( const char* filename )
          {
             ResourceManager->add( filename, SFXOggResource::create( *stream ) );
             ResourceManager->closeStream( stream );
-            return ResourceManager->load( filename );
+            buffer = ResourceManager->load( filename );
+            if ( (bool)buffer )
+               buffer->mFilePath = StringTable->insert( temp );
+            return buffer;
          }
 
       #endif
@@ -113,6 +125,7 @@ bool SFXResource::exists( const char* filename )
 SFXResource::SFXResource()
    :  mFormat( SFX_FORMAT_MONO16 ),
       mData( NULL ),
+      mFilePath( NULL ),
       mSize( 0 ),
       mFrequency( 22050 ),
       mLength( 0 )
@@ -125,6 +138,14 @@ SFXResource::~SFXResource()
    delete [] mData;
 }
 
+const U8* SFXResource::getData() const
+{
+   if ( !mData && mSize )
+      const_cast<SFXResource*>( this )->_loadData();
+
+   return mData;
+}
+
 U32 SFXResource::getChannels() const
 {
    switch( mFormat )
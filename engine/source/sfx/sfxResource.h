@@ -11,6 +11,8 @@
 #include "core/resManager.h"
 #endif
 
+class SFXStream;
+
 
 /// The various types of sound data that may be
 /// returned from SFXResource::getData().
@@ -58,6 +60,15 @@ class SFXResource : public ResourceInstance
       /// The loaded sample data.
       U8* mData;
 
+      /// The path of the sound file, including the extension,
+      /// for resources which load their sample data on demand.
+      StringTableEntry mFilePath;
+
+      /// Called by getData() when mData has not been loaded.
+      /// Resources which don't read all their sample data up 
+      /// front override this.
+      virtual void _loadData() {}
+
       /// The length of the mData array in bytes.
       U32 mSize;
 
@@ -84,8 +95,17 @@ class SFXResource : public ResourceInstance
       ///
       static bool exists( const char* filename );
 
-      /// Returns the sample data array.
-      const U8* getData() const { return mData; }
+      /// Returns the sample data array, loading it
+      /// first if it hasn't been already.
+      const U8* getData() const;
+
+      /// Returns true if openStream() is supported.
+      virtual bool canStream() const { return false; }
+
+      /// Returns a new decoder for reading the sample data
+      /// a piece at a time, or NULL if the resource cannot
+      /// be streamed.  The caller owns the stream.
+      virtual SFXStream* openStream() const { return NULL; }
 
       /// The length of the data buffer in bytes.
       U32 getSize() const { return mSize; }
@@ -13,7 +13,10 @@
 
 
 SFXSource::SFXSource()
-   : mVoice( NULL )
+   :  mVoice( NULL ),
+      mIsActive( false ),
+      mIsAudible( false ),
+      mIsBinned( false )
 {
    // NOTE: This should never be used directly 
    // and is only here to satisfy satisfy the
@@ -36,7 +39,16 @@ SFXSource::SFXSource( const SFXProfile *profile )
       // This sucks... but it works.
       mProfile( const_cast<SFXProfile*>( profile ) ),
 
-      mStatusCallback( NULL )
+      mStatusCallback( NULL ),
+      mIsActive( false ),
+      mIsAudible( false ),
+      mAudiblePass( 0 ),
+      mIsBinned( false ),
+      mIsGlobal( false ),
+      mBinMinX( 0 ),
+      mBinMinY( 0 ),
+      mBinMaxX( 0 ),
+      mBinMaxY( 0 )
 {
    const SFXDescription* desc = mProfile->getDescription();
 
@@ -259,6 +271,11 @@ bool SFXSource::_setStatus( SFXStatus status )
 
    mStatus = status;
 
+   // The system only polls the sources it
+   // knows to be playing.
+   if ( mStatus == SFXStatusPlaying )
+      SFX->_onSourcePlaying( this );
+
    // Convert the status to a string.
    const char* statusString;
    switch ( mStatus )
@@ -388,6 +405,8 @@ void SFXSource::setTransform( const MatrixF& transform )
 {
    mTransform = transform;
 
+   SFX->_onSourceMoved( this );
+
    if ( mVoice )
       mVoice->setTransform( mTransform );      
 }
@@ -423,6 +442,8 @@ void SFXSource::setMinMaxDistance( F32 min, F32 max )
    mMinDistance = min;
    mMaxDistance = max;
 
+   SFX->_onSourceMoved( this );
+
    if ( mVoice )
       mVoice->setMinMaxDistance( mMinDistance, mMaxDistance );
 }
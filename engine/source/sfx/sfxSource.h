@@ -37,6 +37,7 @@ class SFXSource : public SimObject
 {
    friend class SFXSystem;
    friend class SFXListener;
+   friend class SFXSourceGrid;
 
    typedef SimObject Parent;
    
@@ -122,6 +123,33 @@ class SFXSource : public SimObject
 
       StringTableEntry mStatusCallback;
 
+      /// @name System bookkeeping
+      /// Maintained by SFXSystem and SFXSourceGrid.
+      /// @{
+
+      /// True while the source is in the system's
+      /// list of playing sources.
+      bool mIsActive;
+
+      /// True while the source is in the system's
+      /// list of audible sources.
+      bool mIsAudible;
+
+      /// The system update which last found this
+      /// source to be audible.
+      U32 mAudiblePass;
+
+      bool mIsBinned;
+
+      /// True if the source is in the grid's global
+      /// list instead of the bins.
+      bool mIsGlobal;
+
+      /// The grid cells which the source is binned in.
+      S32 mBinMinX, mBinMinY, mBinMaxX, mBinMaxY;
+
+      /// @}
+
       /// We overload this to disable creation of 
       /// a source via script 'new'.
       bool processArguments( S32 argc, const char **argv );
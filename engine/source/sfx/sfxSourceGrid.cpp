@@ -0,0 +1,117 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine Advanced
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "sfx/sfxSourceGrid.h"
+
+
+const F32 SFXSourceGrid::BinSize = 64.0f;
+
+
+bool SFXSourceGrid::_getCellRange( const SFXSource* source, S32* minX, S32* minY, S32* maxX, S32* maxY )
+{
+   if ( !source->is3d() )
+      return false;
+
+   // If the source can be heard across more than the
+   // grid then every bin would hold it anyway.
+   const F32 radius = source->mMaxDistance;
+   if ( radius * 2.0f >= ( NumBins - 1 ) * BinSize )
+      return false;
+
+   Point3F pos;
+   source->getTransform().getColumn( 3, &pos );
+
+   *minX = (S32)mFloor( ( pos.x - radius ) / BinSize );
+   *minY = (S32)mFloor( ( pos.y - radius ) / BinSize );
+   *maxX = (S32)mFloor( ( pos.x + radius ) / BinSize );
+   *maxY = (S32)mFloor( ( pos.y + radius ) / BinSize );
+
+   return true;
+}
+
+void SFXSourceGrid::_insert( SFXSource* source, bool global, S32 minX, S32 minY, S32 maxX, S32 maxY )
+{
+   source->mIsBinned = true;
+   source->mIsGlobal = global;
+   source->mBinMinX = minX;
+   source->mBinMinY = minY;
+   source->mBinMaxX = maxX;
+   source->mBinMaxY = maxY;
+
+   if ( global )
+   {
+      mGlobalSources.push_back( source );
+      return;
+   }
+
+   // The range is never wider than the grid, so
+   // each cell lands in a different bin.
+   for ( S32 y = minY; y <= maxY; y++ )
+      for ( S32 x = minX; x <= maxX; x++ )
+         mBins[ _getBin( x, y ) ].push_back( source );
+}
+
+void SFXSourceGrid::insertSource( SFXSource* source )
+{
+   AssertFatal( !source->mIsBinned, "SFXSourceGrid::insertSource() - The source is already binned!" );
+
+   S32 minX = 0, minY = 0, maxX = 0, maxY = 0;
+   bool global = !_getCellRange( source, &minX, &minY, &maxX, &maxY );
+   _insert( source, global, minX, minY, maxX, maxY );
+}
+
+void SFXSourceGrid::removeSource( SFXSource* source )
+{
+   if ( !source->mIsBinned )
+      return;
+
+   source->mIsBinned = false;
+
+   if ( source->mIsGlobal )
+   {
+      SFXSourceVector::iterator iter = find( mGlobalSources.begin(), mGlobalSources.end(), source );
+      AssertFatal( iter != mGlobalSources.end(), "SFXSourceGrid::removeSource() - Source not found!" );
+      mGlobalSources.erase_fast( iter );
+      return;
+   }
+
+   for ( S32 y = source->mBinMinY; y <= source->mBinMaxY; y++ )
+   {
+      for ( S32 x = source->mBinMinX; x <= source->mBinMaxX; x++ )
+      {
+         SFXSourceVector& bin = mBins[ _getBin( x, y ) ];
+         SFXSourceVector::iterator iter = find( bin.begin(), bin.end(), source );
+         AssertFatal( iter != bin.end(), "SFXSourceGrid::removeSource() - Source not found!" );
+         bin.erase_fast( iter );
+      }
+   }
+}
+
+void SFXSourceGrid::updateSource( SFXSource* source )
+{
+   if ( !source->mIsBinned )
+      return;
+
+   S32 minX = 0, minY = 0, maxX = 0, maxY = 0;
+   bool global = !_getCellRange( source, &minX, &minY, &maxX, &maxY );
+
+   // Most moves stay within the same cells.
+   if ( global == source->mIsGlobal &&
+        ( global ||
+          ( minX == source->mBinMinX && minY == source->mBinMinY &&
+            maxX == source->mBinMaxX && maxY == source->mBinMaxY ) ) )
+      return;
+
+   removeSource( source );
+   _insert( source, global, minX, minY, maxX, maxY );
+}
+
+const SFXSourceVector& SFXSourceGrid::getSources( const Point3F& pos ) const
+{
+   const S32 x = (S32)mFloor( pos.x / BinSize );
+   const S32 y = (S32)mFloor( pos.y / BinSize );
+   return mBins[ _getBin( x, y ) ];
+}
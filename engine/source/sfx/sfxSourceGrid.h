@@ -0,0 +1,76 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine Advanced
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#ifndef _SFXSOURCEGRID_H_
+#define _SFXSOURCEGRID_H_
+
+#ifndef _SFXSOURCE_H_
+   #include "sfx/sfxSource.h"
+#endif
+
+
+/// A coarse grid over the xy plane which bins every 3D source
+/// by the area it can be heard in, so that the system only has
+/// to look at the sources binned under the listener.
+///
+/// Like the scene Container the grid wraps around, so a bin can
+/// hold sources which are far away from the listener.  Those are
+/// culled when the system computes their volume.  Sources which
+/// are 2D or cover the whole grid are kept in a global list that
+/// is checked on every update.
+class SFXSourceGrid
+{
+   public:
+
+      enum
+      {
+         /// The number of bins along each axis.  This
+         /// must be a power of two.
+         NumBins = 16
+      };
+
+      /// The size of a bin in meters.
+      static const F32 BinSize;
+
+   protected:
+
+      SFXSourceVector mBins[ NumBins * NumBins ];
+
+      /// The sources which aren't binned.
+      SFXSourceVector mGlobalSources;
+
+      /// Returns the bin for the unwrapped cell coordinates.
+      static U32 _getBin( S32 x, S32 y )
+      {
+         return ( x & ( NumBins - 1 ) ) + ( y & ( NumBins - 1 ) ) * NumBins;
+      }
+
+      /// Calculates the cells covered by the source.  Returns
+      /// false if the source belongs in the global list.
+      static bool _getCellRange( const SFXSource* source, S32* minX, S32* minY, S32* maxX, S32* maxY );
+
+      void _insert( SFXSource* source, bool global, S32 minX, S32 minY, S32 maxX, S32 maxY );
+
+   public:
+
+      /// Adds a new source to the grid.
+      void insertSource( SFXSource* source );
+
+      /// Removes the source from the grid.
+      void removeSource( SFXSource* source );
+
+      /// Rebins the source after its position or
+      /// maximum distance has changed.
+      void updateSource( SFXSource* source );
+
+      /// Returns the sources binned at the position.
+      const SFXSourceVector& getSources( const Point3F& pos ) const;
+
+      /// Returns the sources which may be heard anywhere.
+      const SFXSourceVector& getGlobalSources() const { return mGlobalSources; }
+};
+
+
+#endif // _SFXSOURCEGRID_H_
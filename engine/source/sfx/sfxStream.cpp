@@ -0,0 +1,193 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine Advanced
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "sfx/sfxStream.h"
+
+#include "platform/platformMutex.h"
+#include "platform/platformSemaphore.h"
+#include "platform/profiler.h"
+#include "core/threadPool.h"
+
+
+SFXStreamer::SFXStreamer( SFXStream* stream, U32 sampleBytes )
+   :  mStream( stream ),
+      mSampleBytes( getMax( sampleBytes, (U32)1 ) ),
+      mReadPacket( 0 ),
+      mNumReady( 0 ),
+      mEndOfStream( false ),
+      mLooping( false )
+{
+   AssertFatal( stream, "SFXStreamer::SFXStreamer() - Got null stream!" );
+
+   mData = new U8[ NumPackets * PacketSize ];
+   mMutex = Mutex::createMutex();
+   mIdleSemaphore = Semaphore::createSemaphore( 1 );
+}
+
+SFXStreamer::~SFXStreamer()
+{
+   _waitForIdle();
+
+   delete mStream;
+   delete [] mData;
+
+   Semaphore::destroySemaphore( mIdleSemaphore );
+   Mutex::destroyMutex( mMutex );
+}
+
+void SFXStreamer::_waitForIdle()
+{
+   Semaphore::acquireSemaphore( mIdleSemaphore );
+   Semaphore::releaseSemaphore( mIdleSemaphore );
+}
+
+bool SFXStreamer::_decodePacket()
+{
+   U32 packet;
+   {
+      MutexHandle handle;
+      handle.lock( mMutex );
+
+      if ( mEndOfStream || mNumReady == NumPackets )
+         return false;
+
+      packet = ( mReadPacket + mNumReady ) % NumPackets;
+   }
+
+   PROFILE_START( SFXStreamer_decodePacket );
+
+   // Nothing else touches a packet past the ready ones,
+   // so we can decode without holding the lock.
+   U8* buffer = mData + packet * PacketSize;
+   const U32 length = PacketSize - ( PacketSize % mSampleBytes );
+   U32 bytes = 0;
+   bool rewound = false;
+
+   while ( bytes < length )
+   {
+      U32 read = mStream->read( buffer + bytes, length - bytes );
+      if ( read == 0 )
+      {
+         // A looping stream starts over, unless it just
+         // did and still didn't produce anything.
+         if ( !mLooping || rewound || !mStream->seek( 0 ) )
+            break;
+
+         rewound = true;
+         continue;
+      }
+
+      rewound = false;
+      bytes += read;
+   }
+
+   PROFILE_END();
+
+   MutexHandle handle;
+   handle.lock( mMutex );
+
+   if ( bytes > 0 )
+   {
+      mPacketBytes[ packet ] = bytes;
+      mNumReady++;
+   }
+
+   if ( bytes < length )
+      mEndOfStream = true;
+
+   return !mEndOfStream;
+}
+
+void SFXStreamer::_decodeJob( void* streamer )
+{
+   SFXStreamer* self = reinterpret_cast<SFXStreamer*>( streamer );
+
+   while ( self->_decodePacket() )
+      ;
+
+   Semaphore::releaseSemaphore( self->mIdleSemaphore );
+}
+
+void SFXStreamer::setLooping( bool looping )
+{
+   if ( mLooping == looping )
+      return;
+
+   _waitForIdle();
+   mLooping = looping;
+}
+
+void SFXStreamer::seek( U32 sample )
+{
+   _waitForIdle();
+
+   Mutex::lockMutex( mMutex );
+   mReadPacket = 0;
+   mNumReady = 0;
+   mEndOfStream = false;
+   Mutex::unlockMutex( mMutex );
+
+   mStream->seek( sample );
+
+   // Get the first packet out now so that
+   // playback can begin right away.
+   _decodePacket();
+   update();
+}
+
+void SFXStreamer::update()
+{
+   Mutex::lockMutex( mMutex );
+   bool needsData = !mEndOfStream && mNumReady < NumPackets;
+   Mutex::unlockMutex( mMutex );
+
+   if ( !needsData )
+      return;
+
+   ThreadPool* pool = ThreadPool::getGlobal();
+   if ( !pool || pool->getNumThreads() == 0 )
+   {
+      while ( _decodePacket() )
+         ;
+      return;
+   }
+
+   // If we can't get the semaphore then a decode
+   // is already queued and will fill the ring.
+   if ( Semaphore::acquireSemaphore( mIdleSemaphore, false ) )
+      pool->queueJob( _decodeJob, this );
+}
+
+bool SFXStreamer::getPacket( const U8** data, U32* size )
+{
+   MutexHandle handle;
+   handle.lock( mMutex );
+
+   if ( mNumReady == 0 )
+      return false;
+
+   *data = mData + mReadPacket * PacketSize;
+   *size = mPacketBytes[ mReadPacket ];
+   return true;
+}
+
+void SFXStreamer::releasePacket()
+{
+   MutexHandle handle;
+   handle.lock( mMutex );
+
+   AssertFatal( mNumReady > 0, "SFXStreamer::releasePacket() - No packet to release!" );
+   mReadPacket = ( mReadPacket + 1 ) % NumPackets;
+   mNumReady--;
+}
+
+bool SFXStreamer::isFinished()
+{
+   MutexHandle handle;
+   handle.lock( mMutex );
+
+   return mEndOfStream && mNumReady == 0;
+}
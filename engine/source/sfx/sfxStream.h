@@ -0,0 +1,141 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine Advanced
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#ifndef _SFXSTREAM_H_
+#define _SFXSTREAM_H_
+
+#ifndef _PLATFORM_H_
+   #include "platform/platform.h"
+#endif
+
+
+/// A decoder which produces the PCM data of a sound file
+/// a piece at a time.
+///
+/// Streams are created by SFXResource::openStream() and are
+/// read by an SFXStreamer, which may call read() and seek()
+/// from a worker thread.
+class SFXStream
+{
+   public:
+
+      virtual ~SFXStream() {}
+
+      /// Decodes up to length bytes of PCM data into buffer and
+      /// returns the number of bytes written.  Returns zero once
+      /// the end of the sound has been reached.
+      virtual U32 read( U8* buffer, U32 length ) = 0;
+
+      /// Moves the decode position to the sample ( a sample
+      /// includes all channels ).
+      virtual bool seek( U32 sample ) = 0;
+};
+
+
+/// Keeps a small ring of decoded packets ahead of a voice
+/// which is playing a streaming buffer.
+///
+/// The device voice takes packets from the front of the ring
+/// with getPacket() and hands them back with releasePacket()
+/// once it has copied them to the hardware.  update() queues
+/// a job on the global ThreadPool which decodes into the free
+/// packets, so only the first packet after a seek() is ever
+/// decoded on the calling thread.
+///
+/// Looping is handled here by rewinding the stream when it
+/// runs out, so the device voice never loops on its own.
+class SFXStreamer
+{
+   public:
+
+      enum
+      {
+         /// The number of packets in the ring.
+         NumPackets = 4,
+
+         /// The size of a packet in bytes.
+         PacketSize = 32 * 1024,
+      };
+
+   protected:
+
+      /// The decoder.
+      SFXStream* mStream;
+
+      /// The bytes in a sample, used to keep packets
+      /// from splitting a sample.
+      U32 mSampleBytes;
+
+      /// The packet data, NumPackets * PacketSize bytes.
+      U8* mData;
+
+      /// The number of valid bytes in each packet.
+      U32 mPacketBytes[NumPackets];
+
+      /// @name Ring state
+      /// Guarded by mMutex.
+      /// @{
+
+      ///
+      U32 mReadPacket;
+
+      ///
+      U32 mNumReady;
+
+      /// Set once the stream has run out and will not
+      /// produce any more packets until the next seek().
+      bool mEndOfStream;
+
+      /// @}
+
+      ///
+      bool mLooping;
+
+      void* mMutex;
+
+      /// Held while a decode job is queued or running.
+      void* mIdleSemaphore;
+
+      /// Decodes into the packet after the last ready one.  Returns
+      /// false if the ring is full or the stream has run out.
+      bool _decodePacket();
+
+      /// Blocks until any queued decode job has finished.
+      void _waitForIdle();
+
+      static void _decodeJob( void* streamer );
+
+   public:
+
+      /// Takes ownership of the stream.
+      SFXStreamer( SFXStream* stream, U32 sampleBytes );
+
+      ~SFXStreamer();
+
+      /// Sets whether the stream rewinds when it runs out.
+      void setLooping( bool looping );
+
+      /// Restarts decoding at the sample.  The first packet
+      /// is decoded before this returns.
+      void seek( U32 sample );
+
+      /// Queues a decode of any free packets.  Call this
+      /// regularly from the device's update.
+      void update();
+
+      /// Returns the packet at the front of the ring or false
+      /// if no packet is ready.
+      bool getPacket( const U8** data, U32* size );
+
+      /// Frees the packet returned by getPacket().
+      void releasePacket();
+
+      /// Returns true if the stream has run out and every
+      /// decoded packet has been released.
+      bool isFinished();
+};
+
+
+#endif // _SFXSTREAM_H_
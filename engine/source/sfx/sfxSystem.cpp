@@ -53,10 +53,14 @@ SFXSystem::SFXSystem()
    :  mDevice( NULL ),
       mLastTime( 0 ),
       mMasterVolume( 1 ),
+      mAudiblePass( 0 ),
       mStatNumSources( 0 ),
       mStatNumPlaying( 0 ),
       mStatNumCulled( 0 ),
-      mStatNumVoices( 0 )
+      mStatNumVoices( 0 ),
+      mStatNumAudible( 0 ),
+      mStatNumCandidates( 0 ),
+      mStatNumReprioritized( 0 )
 {
    // Setup the default channel volumes.
    for ( S32 i=0; i < NumChannels; i++ )
@@ -66,6 +70,9 @@ SFXSystem::SFXSystem()
    Con::addVariable( "SFX::numPlaying", TypeS32, &mStatNumPlaying );
    Con::addVariable( "SFX::numCulled", TypeS32, &mStatNumCulled );
    Con::addVariable( "SFX::numVoices", TypeS32, &mStatNumVoices );
+   Con::addVariable( "SFX::numAudible", TypeS32, &mStatNumAudible );
+   Con::addVariable( "SFX::numCandidates", TypeS32, &mStatNumCandidates );
+   Con::addVariable( "SFX::numReprioritized", TypeS32, &mStatNumReprioritized );
 }
 
 SFXSystem::~SFXSystem()
@@ -73,7 +80,10 @@ SFXSystem::~SFXSystem()
    Con::removeVariable( "SFX::numSources" );
    Con::removeVariable( "SFX::numPlaying" );
    Con::removeVariable( "SFX::numCulled" );
-   Con::removeVariable( "SFX::numBuffers" );
+   Con::removeVariable( "SFX::numVoices" );
+   Con::removeVariable( "SFX::numAudible" );
+   Con::removeVariable( "SFX::numCandidates" );
+   Con::removeVariable( "SFX::numReprioritized" );
 
    // Cleanup any remaining sources!
    while ( !mSources.empty() )
@@ -81,6 +91,8 @@ SFXSystem::~SFXSystem()
 
    mSources.clear();
    mPlayOnceSources.clear();
+   mPlayingSources.clear();
+   mAudibleSources.clear();
 
    // If we still have a device... delete it.
    deleteDevice();
@@ -173,6 +185,7 @@ SFXSource* SFXSystem::createSource( const SFXProfile* profile,
    }
 
    mSources.push_back( source );
+   mSourceGrid.insertSource( source );
 
    if ( transform )
       source->setTransform( *transform );
@@ -201,6 +214,22 @@ void SFXSystem::_onRemoveSource( SFXSource* source )
    if ( iter != mPlayOnceSources.end() )
       mPlayOnceSources.erase( iter );
 
+   if ( source->mIsActive )
+   {
+      iter = find( mPlayingSources.begin(), mPlayingSources.end(), source );
+      mPlayingSources.erase_fast( iter );
+      source->mIsActive = false;
+   }
+
+   if ( source->mIsAudible )
+   {
+      iter = find( mAudibleSources.begin(), mAudibleSources.end(), source );
+      mAudibleSources.erase( iter );
+      source->mIsAudible = false;
+   }
+
+   mSourceGrid.removeSource( source );
+
    // Free the hardware buffer.
    source->_freeVoice( mDevice );
 
@@ -208,6 +237,15 @@ void SFXSystem::_onRemoveSource( SFXSource* source )
    mStatNumSources = mSources.size();
 }
 
+void SFXSystem::_onSourcePlaying( SFXSource* source )
+{
+   if ( source->mIsActive )
+      return;
+
+   source->mIsActive = true;
+   mPlayingSources.push_back( source );
+}
+
 SFXBuffer* SFXSystem::_createBuffer( SFXProfile* profile )
 {
    // The buffers are created by the active
@@ -319,18 +357,33 @@ void SFXSystem::_updateSources( const U32 time )
 {
    PROFILE_SCOPE( SFXSystem_UpdateSources );
 
-   // Check the status of the sources here once.
-   mStatNumPlaying = 0;
-   SFXSourceVector::iterator iter = mSources.begin();
-   for ( ; iter != mSources.end(); ++iter )
+   // Stopped and paused sources only start playing again
+   // thru SFXSource::play(), so we only need to check the
+   // status of the ones we know are playing.
+   for ( S32 i = mPlayingSources.size() - 1; i >= 0; i-- )
    {
-      if ( (*iter)->getStatus() == SFXStatusPlaying )
-         ++mStatNumPlaying;
+      if ( i >= mPlayingSources.size() )
+         continue;
+
+      SFXSource* source = mPlayingSources[i];
+      if ( source->getStatus() == SFXStatusPlaying )
+         continue;
+
+      // The status callback may have changed the list
+      // or even deleted the source, so look it up again.
+      SFXSourceVector::iterator iter = find( mPlayingSources.begin(), mPlayingSources.end(), source );
+      if ( iter != mPlayingSources.end() )
+      {
+         mPlayingSources.erase_fast( iter );
+         source->mIsActive = false;
+      }
    }
 
+   mStatNumPlaying = mPlayingSources.size();
+
    // First check to see if any play once sources have
    // finished playback... delete them.
-   iter = mPlayOnceSources.begin();
+   SFXSourceVector::iterator iter = mPlayOnceSources.begin();
    for ( ; iter != mPlayOnceSources.end();  )
    {
       SFXSource* source = *iter;
@@ -355,6 +408,77 @@ void SFXSystem::_updateSources( const U32 time )
    _assignVoices();
 }
 
+void SFXSystem::_updateAudible( const SFXSourceVector& sources, const MatrixF& listener )
+{
+   SFXSourceVector::const_iterator iter = sources.begin();
+   for ( ; iter != sources.end(); ++iter )
+   {
+      SFXSource* source = *iter;
+
+      if ( source->getLastStatus() != SFXStatusPlaying )
+         continue;
+
+      mStatNumCandidates++;
+      source->_updateVolume( listener );
+
+      if ( source->getAttenuatedVolume() <= 0.0f )
+         continue;
+
+      source->mAudiblePass = mAudiblePass;
+
+      // Only sources which just became audible need
+      // to be added... the rest are already sorted.
+      if ( !source->mIsAudible )
+      {
+         source->mIsAudible = true;
+         mAudibleSources.push_back( source );
+         mStatNumReprioritized++;
+      }
+   }
+}
+
+void SFXSystem::_updateAudibleSources()
+{
+   PROFILE_SCOPE( SFXSystem_UpdateAudibleSources );
+
+   const MatrixF& listener = mListener.getTransform();
+   Point3F pos;
+   listener.getColumn( 3, &pos );
+
+   mAudiblePass++;
+   mStatNumCandidates = 0;
+   mStatNumReprioritized = 0;
+
+   // A 3D source can only be heard if the listener is
+   // in one of the cells it was binned in.
+   _updateAudible( mSourceGrid.getSources( pos ), listener );
+   _updateAudible( mSourceGrid.getGlobalSources(), listener );
+
+   // Drop the sources we didn't hear this time while
+   // keeping the order of the rest.
+   U32 count = 0;
+   for ( U32 i = 0; i < mAudibleSources.size(); i++ )
+   {
+      SFXSource* source = mAudibleSources[i];
+      if ( source->mAudiblePass != mAudiblePass )
+      {
+         source->mIsAudible = false;
+         source->mAttenuatedVolume = 0;
+         mStatNumReprioritized++;
+         continue;
+      }
+
+      mAudibleSources[count++] = source;
+   }
+   mAudibleSources.setSize( count );
+
+   // Now let the listener prioritize the sounds for us 
+   // before we go off and assign buffers.
+   mListener.sortSources( mAudibleSources );
+
+   mStatNumAudible = mAudibleSources.size();
+}
+
 void SFXSystem::_assignVoices()
 {
    PROFILE_SCOPE( SFXSystem_AssignVoices );
@@ -367,33 +491,22 @@ void SFXSystem::_assignVoices()
    if ( !mDevice )
       return;
 
-   // Now let the listener prioritize the sounds for us 
-   // before we go off and assign buffers.
-   mListener.sortSources( mSources );
+   _updateAudibleSources();
+
+   // The sources we can't hear are culled.
+   mStatNumCulled = getMax( (S32)mPlayingSources.size() - (S32)mAudibleSources.size(), 0 );
+
+   // The sources holding a voice which they can't use.  We
+   // only gather these once we run out of voices.
+   SFXSourceVector idleSources;
+   bool gatheredIdle = false;
 
    // We now make sure that the sources closest to the 
-   // listener, the ones at the top of the source list,
+   // listener, the ones at the top of the audible list,
    // have a device buffer to play thru.
-   mStatNumCulled = 0;
-   SFXSourceVector::iterator iter = mSources.begin(); 
-   for ( ; iter != mSources.end(); ++iter )
+   for ( S32 i = 0; i < mAudibleSources.size(); i++ )
    {
-      SFXSource* source = *iter;
-
-      // Non playing sources (paused or stopped) are at the
-      // end of the vector, so when i encounter one i know 
-      // that nothing else in the vector needs buffer assignment.
-		if ( !source->isPlaying() )
-         break;
-
-      // If the source is outside it's max range we can
-      // skip it as well, so that we don't waste cycles
-      // setting up a buffer for something we won't hear.
-      if ( source->getAttenuatedVolume() <= 0.0f )
-      {
-         mStatNumCulled++;
-         continue;
-      }
+      SFXSource* source = mAudibleSources[i];
 
       // If the source has a voice then we can skip it.
       if ( source->hasVoice() )
@@ -404,17 +517,38 @@ void SFXSystem::_assignVoices()
       if ( source->_allocVoice( mDevice ) )
          continue;
 
-      // The device couldn't assign a new voice, so we look for
-      // the last source in the list with a voice and free it.
-      SFXSourceVector::iterator hijack = mSources.end() - 1;
-      for ( ; hijack != iter; hijack-- )
+      if ( !gatheredIdle )
       {
-         if ( (*hijack)->hasVoice() && !(*hijack)->mIsStreaming )
+         SFXSourceVector::iterator iter = mSources.begin();
+         for ( ; iter != mSources.end(); ++iter )
          {
-            (*hijack)->_freeVoice( mDevice );
-            break;
+            if ( (*iter)->hasVoice() && !(*iter)->mIsAudible && !(*iter)->mIsStreaming )
+               idleSources.push_back( *iter );
          }
-		}
+
+         gatheredIdle = true;
+      }
+
+      // The device couldn't assign a new voice, so we take it
+      // from a source which can't be heard or else from the 
+      // last source in the list with a voice.
+      if ( !idleSources.empty() )
+      {
+         idleSources.last()->_freeVoice( mDevice );
+         idleSources.pop_back();
+      }
+      else
+      {
+         for ( S32 hijack = mAudibleSources.size() - 1; hijack > i; hijack-- )
+         {
+            SFXSource* victim = mAudibleSources[hijack];
+            if ( victim->hasVoice() && !victim->mIsStreaming )
+            {
+               victim->_freeVoice( mDevice );
+               break;
+            }
+         }
+      }
 
       // Ok try to assign a voice once again!
       if ( source->_allocVoice( mDevice ) )
@@ -424,7 +558,7 @@ void SFXSystem::_assignVoices()
       // tough cookies.  It just cannot be heard yet, maybe
       // it can in the next update.
       mStatNumCulled++;
-	}
+   }
 
    // Update the buffer count stat.
    mStatNumVoices = mDevice->getVoiceCount();
@@ -19,6 +19,9 @@
 #ifndef _SFXLISTENER_H_
    #include "sfx/sfxListener.h"
 #endif
+#ifndef _SFXSOURCEGRID_H_
+   #include "sfx/sfxSourceGrid.h"
+#endif
 #ifndef _SIGNAL_H_
    #include "util/tSignal.h"
 #endif
@@ -41,7 +44,7 @@
 ///
 class SFXSystem
 {
-   friend class SFXSource;    // for _onRemoveSource.
+   friend class SFXSource;    // for _onRemoveSource, _onSourcePlaying, and _onSourceMoved.
    friend class SFXProfile;   // for _createBuffer.
 
    public:
@@ -77,6 +80,23 @@ class SFXSystem
       /// that must be released when they stop playing.
       SFXSourceVector mPlayOnceSources;
 
+      /// The sources which were playing at the last update
+      /// or have been played since.  These are the only ones
+      /// that need to be polled for status changes.
+      SFXSourceVector mPlayingSources;
+
+      /// The playing sources which could be heard at the last
+      /// voice assignment in order of priority.
+      SFXSourceVector mAudibleSources;
+
+      /// Bins the sources by where they can be heard so that
+      /// we only update the volumes of those near the listener.
+      SFXSourceGrid mSourceGrid;
+
+      /// Incremented on every voice assignment to find
+      /// the sources which are no longer audible.
+      U32 mAudiblePass;
+
       /// The position and orientation of the listener.
       SFXListener mListener;
 
@@ -96,6 +116,9 @@ class SFXSystem
       S32 mStatNumPlaying;
       S32 mStatNumCulled;
       S32 mStatNumVoices;
+      S32 mStatNumAudible;
+      S32 mStatNumCandidates;
+      S32 mStatNumReprioritized;
 
       /// Called to reprioritize and reassign buffers as
       /// sources change state, volumes are adjusted, and 
@@ -111,6 +134,21 @@ class SFXSystem
       /// voices to sources.
       void _assignVoices();
 
+      /// Updates the volume of the playing sources near the
+      /// listener and the list of audible sources from them.
+      void _updateAudibleSources();
+
+      /// Used by _updateAudibleSources() to check a set
+      /// of sources which could be audible.
+      void _updateAudible( const SFXSourceVector& sources, const MatrixF& listener );
+
+      /// Called from the source when it starts playing.
+      void _onSourcePlaying( SFXSource* source );
+
+      /// Called from the source when its position or
+      /// maximum distance changes.
+      void _onSourceMoved( SFXSource* source ) { mSourceGrid.updateSource( source ); }
+
       /// This is called from the source to 
       /// properly clean itself up.
       ///
@@ -6,7 +6,10 @@
 #include "platform/platform.h"
 
 #include "sfxOggResource.h"
+#include "sfxOggStream.h"
 #include "vorbisStream.h"
+#include "console/console.h"
+#include "platform/profiler.h"
 
 
 ResourceInstance* SFXOggResource::create( Stream &stream )
@@ -56,16 +59,6 @@ bool SFXOggResource::load( Stream& stream )
       mSize = 4 * samples;
    }
 
-   #ifdef TORQUE_BIG_ENDIAN
-      bool endian = true;
-   #else
-      bool endian = false;
-   #endif
-
-   mData = new U8[ mSize ];
-   S32 current_section = 0;
-   read( &vf, mData, mSize, endian, &current_section );
-
    vf.ov_clear();
 
    // Calculate the sample length being careful
@@ -75,6 +68,37 @@ bool SFXOggResource::load( Stream& stream )
    return true;
 }
 
+void SFXOggResource::_loadData()
+{
+   SFXOggStream* stream = SFXOggStream::create( mFilePath );
+   if ( !stream )
+   {
+      Con::errorf( "SFXOggResource::_loadData() - Unable to open '%s'!", mFilePath ? mFilePath : "" );
+
+      // There is no data, so don't let the buffers copy any.
+      mSize = 0;
+      return;
+   }
+
+   PROFILE_START( SFXOggResource_loadData );
+
+   mData = new U8[ mSize ];
+   U32 bytes = stream->read( mData, mSize );
+
+   // Pad out a short file with silence.
+   if ( bytes < mSize )
+      dMemset( mData + bytes, 0, mSize - bytes );
+
+   PROFILE_END();
+
+   delete stream;
+}
+
+SFXStream* SFXOggResource::openStream() const
+{
+   return SFXOggStream::create( mFilePath );
+}
+
 S32 SFXOggResource::read( OggVorbisFile* vf, U8* buffer, U32 length, bool bigendianp, S32* bitstream )
 {
    const U32 CHUNKSIZE = 4096;
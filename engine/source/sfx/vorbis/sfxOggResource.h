@@ -16,8 +16,14 @@ class OggVorbisFile;
 
 /// The concrete sound resource for loading 
 /// Ogg Vorbis audio data.
+///
+/// Only the Vorbis headers are read at load time.  The
+/// sample data is decoded in full the first time getData()
+/// is called, which streaming profiles never do.
 class SFXOggResource : public SFXResource
 {
+   friend class SFXOggStream;
+
    protected:
 
       /// The constructor is protected. 
@@ -31,9 +37,12 @@ class SFXOggResource : public SFXResource
       virtual ~SFXOggResource();
 
       /// This does the real work of loading the 
-      /// data from the stream.
+      /// header from the stream.
       bool load( Stream& stream );
 
+      /// Decodes the whole file into mData.
+      void _loadData();
+
       /// Helper function reads one buffer length of data.
       static S32 read( OggVorbisFile* vf, U8* buffer, U32 length, bool bigendianp, S32* bitstream );
 
@@ -46,6 +55,10 @@ class SFXOggResource : public SFXResource
       ///
       static ResourceInstance* create( Stream &stream );
 
+      // SFXResource
+      bool canStream() const { return mFilePath != NULL; }
+      SFXStream* openStream() const;
+
 };
 
 
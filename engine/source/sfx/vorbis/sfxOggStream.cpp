@@ -0,0 +1,63 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine Advanced
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+
+#include "sfx/vorbis/sfxOggStream.h"
+#include "sfx/vorbis/sfxOggResource.h"
+#include "sfx/vorbis/vorbisStream.h"
+
+
+SFXOggStream* SFXOggStream::create( const char* filePath )
+{
+   if ( !filePath )
+      return NULL;
+
+   Stream* stream = ResourceManager->openStream( filePath );
+   if ( !stream )
+      return NULL;
+
+   SFXOggStream* ogg = new SFXOggStream;
+   ogg->mStream = stream;
+   if ( ogg->mVorbisFile->ov_open( stream, NULL, 0 ) < 0 )
+   {
+      delete ogg;
+      return NULL;
+   }
+
+   return ogg;
+}
+
+SFXOggStream::SFXOggStream()
+   :  mStream( NULL ),
+      mVorbisFile( new OggVorbisFile ),
+      mBitstream( 0 )
+{
+}
+
+SFXOggStream::~SFXOggStream()
+{
+   mVorbisFile->ov_clear();
+   delete mVorbisFile;
+
+   if ( mStream )
+      ResourceManager->closeStream( mStream );
+}
+
+U32 SFXOggStream::read( U8* buffer, U32 length )
+{
+   #ifdef TORQUE_BIG_ENDIAN
+      bool endian = true;
+   #else
+      bool endian = false;
+   #endif
+
+   return SFXOggResource::read( mVorbisFile, buffer, length, endian, &mBitstream );
+}
+
+bool SFXOggStream::seek( U32 sample )
+{
+   return mVorbisFile->ov_pcm_seek( sample ) == 0;
+}
@@ -0,0 +1,47 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine Advanced
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#ifndef _SFXOGGSTREAM_H_
+#define _SFXOGGSTREAM_H_
+
+#ifndef _SFXSTREAM_H_
+   #include "sfx/sfxStream.h"
+#endif
+
+class Stream;
+class OggVorbisFile;
+
+
+/// Decodes an Ogg Vorbis file for streaming playback.
+class SFXOggStream : public SFXStream
+{
+   protected:
+
+      /// The open file.
+      Stream* mStream;
+
+      ///
+      OggVorbisFile* mVorbisFile;
+
+      ///
+      S32 mBitstream;
+
+      SFXOggStream();
+
+   public:
+
+      /// Opens the file and reads the Vorbis headers.  Returns
+      /// NULL if the file cannot be opened.
+      static SFXOggStream* create( const char* filePath );
+
+      virtual ~SFXOggStream();
+
+      // SFXStream
+      U32 read( U8* buffer, U32 length );
+      bool seek( U32 sample );
+};
+
+
+#endif // _SFXOGGSTREAM_H_
@@ -14,7 +14,7 @@ SFXXAudioBuffer* SFXXAudioBuffer::create( SFXProfile *profile )
    AssertFatal( profile,  "SFXXAudioBuffer::create - Got null profile!" );
 
    const Resource<SFXResource> &resource = profile->getResource();
-   if ( resource.isNull() )
+   if ( resource.isNull() || !resource->getData() )
       return NULL;
 
    SFXXAudioBuffer *buffer = new SFXXAudioBuffer( resource, profile->getDescription()->mIs3D );
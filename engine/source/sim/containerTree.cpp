@@ -0,0 +1,438 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#include "sim/containerTree.h"
+#include "math/mMath.h"
+
+const F32 ContainerTree::Margin = 2.0f;
+
+//----------------------------------------------------------------------------
+
+static inline F32 getSurfaceArea(const Box3F& box)
+{
+    F32 x = box.max.x - box.min.x;
+    F32 y = box.max.y - box.min.y;
+    F32 z = box.max.z - box.min.z;
+    return 2.0f * (x * y + y * z + z * x);
+}
+
+static inline Box3F getUnion(const Box3F& a, const Box3F& b)
+{
+    Box3F result = a;
+    result.intersect(b);
+    return result;
+}
+
+/// Slab test of the part of the ray up to maxT against the box.
+static inline bool overlapsRay(const Box3F& box, const Point3F& start, const Point3F& dir, F32 maxT)
+{
+    const F32* pStart = &start.x;
+    const F32* pDir = &dir.x;
+    const F32* pMin = &box.min.x;
+    const F32* pMax = &box.max.x;
+
+    F32 enter = 0.0f;
+    F32 exit = maxT;
+    for (U32 i = 0; i < 3; i++)
+    {
+        if (mFabs(pDir[i]) < 1e-7f)
+        {
+            if (pStart[i] < pMin[i] || pStart[i] > pMax[i])
+                return false;
+            continue;
+        }
+
+        F32 inv = 1.0f / pDir[i];
+        F32 t1 = (pMin[i] - pStart[i]) * inv;
+        F32 t2 = (pMax[i] - pStart[i]) * inv;
+        if (t1 > t2)
+        {
+            F32 temp = t1;
+            t1 = t2;
+            t2 = temp;
+        }
+
+        enter = getMax(enter, t1);
+        exit = getMin(exit, t2);
+        if (enter > exit)
+            return false;
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+ContainerTree::ContainerTree()
+{
+    VECTOR_SET_ASSOCIATION(mNodes);
+
+    mRoot = NullNode;
+    mFreeList = NullNode;
+}
+
+S32 ContainerTree::allocateNode()
+{
+    S32 node;
+    if (mFreeList != NullNode)
+    {
+        node = mFreeList;
+        mFreeList = mNodes[node].parent;
+    }
+    else
+    {
+        mNodes.increment();
+        node = mNodes.size() - 1;
+    }
+
+    Node& n = mNodes[node];
+    n.object = NULL;
+    n.parent = NullNode;
+    n.child1 = NullNode;
+    n.child2 = NullNode;
+    n.height = 0;
+    return node;
+}
+
+void ContainerTree::freeNode(S32 node)
+{
+    AssertFatal(node >= 0 && node < mNodes.size(), "ContainerTree::freeNode: bad node!");
+
+    mNodes[node].object = NULL;
+    mNodes[node].height = -1;
+    mNodes[node].parent = mFreeList;
+    mFreeList = node;
+}
+
+//----------------------------------------------------------------------------
+
+S32 ContainerTree::insert(SceneObject* obj, const Box3F& box)
+{
+    S32 leaf = allocateNode();
+
+    Node& n = mNodes[leaf];
+    n.object = obj;
+    n.box = box;
+    n.box.min -= Point3F(Margin, Margin, Margin);
+    n.box.max += Point3F(Margin, Margin, Margin);
+
+    insertLeaf(leaf);
+    return leaf;
+}
+
+void ContainerTree::remove(S32 leaf)
+{
+    AssertFatal(leaf >= 0 && leaf < mNodes.size() && mNodes[leaf].isLeaf(), "ContainerTree::remove: bad leaf!");
+
+    removeLeaf(leaf);
+    freeNode(leaf);
+}
+
+bool ContainerTree::update(S32 leaf, const Box3F& box)
+{
+    AssertFatal(leaf >= 0 && leaf < mNodes.size() && mNodes[leaf].isLeaf(), "ContainerTree::update: bad leaf!");
+
+    if (mNodes[leaf].box.isContained(box))
+        return false;
+
+    removeLeaf(leaf);
+
+    Node& n = mNodes[leaf];
+    n.box = box;
+    n.box.min -= Point3F(Margin, Margin, Margin);
+    n.box.max += Point3F(Margin, Margin, Margin);
+
+    insertLeaf(leaf);
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+void ContainerTree::insertLeaf(S32 leaf)
+{
+    if (mRoot == NullNode)
+    {
+        mRoot = leaf;
+        mNodes[mRoot].parent = NullNode;
+        return;
+    }
+
+    // Walk down to the sibling which grows the tree the least.  Putting the
+    //  leaf next to a node costs the area of their union, and every node
+    //  above it has to grow to hold the leaf as well...
+    const Box3F leafBox = mNodes[leaf].box;
+    S32 index = mRoot;
+    while (!mNodes[index].isLeaf())
+    {
+        const Node& n = mNodes[index];
+
+        F32 area = getSurfaceArea(n.box);
+        F32 combinedArea = getSurfaceArea(getUnion(n.box, leafBox));
+
+        F32 cost = 2.0f * combinedArea;
+        F32 inheritanceCost = 2.0f * (combinedArea - area);
+
+        const Node& c1 = mNodes[n.child1];
+        F32 cost1 = getSurfaceArea(getUnion(c1.box, leafBox)) + inheritanceCost;
+        if (!c1.isLeaf())
+            cost1 -= getSurfaceArea(c1.box);
+
+        const Node& c2 = mNodes[n.child2];
+        F32 cost2 = getSurfaceArea(getUnion(c2.box, leafBox)) + inheritanceCost;
+        if (!c2.isLeaf())
+            cost2 -= getSurfaceArea(c2.box);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+
+        index = (cost1 < cost2) ? n.child1 : n.child2;
+    }
+
+    // Pair the leaf with the sibling under a new parent.  Careful, the
+    //  allocation can move the nodes...
+    S32 sibling = index;
+    S32 oldParent = mNodes[sibling].parent;
+    S32 newParent = allocateNode();
+
+    mNodes[newParent].parent = oldParent;
+    mNodes[newParent].box = getUnion(leafBox, mNodes[sibling].box);
+    mNodes[newParent].height = mNodes[sibling].height + 1;
+    mNodes[newParent].child1 = sibling;
+    mNodes[newParent].child2 = leaf;
+    mNodes[sibling].parent = newParent;
+    mNodes[leaf].parent = newParent;
+
+    if (oldParent != NullNode)
+    {
+        if (mNodes[oldParent].child1 == sibling)
+            mNodes[oldParent].child1 = newParent;
+        else
+            mNodes[oldParent].child2 = newParent;
+    }
+    else
+        mRoot = newParent;
+
+    // Fix up the boxes and heights on the way back to the root
+    index = mNodes[leaf].parent;
+    while (index != NullNode)
+    {
+        index = balance(index);
+
+        Node& n = mNodes[index];
+        n.height = 1 + getMax(mNodes[n.child1].height, mNodes[n.child2].height);
+        n.box = getUnion(mNodes[n.child1].box, mNodes[n.child2].box);
+
+        index = n.parent;
+    }
+}
+
+void ContainerTree::removeLeaf(S32 leaf)
+{
+    if (leaf == mRoot)
+    {
+        mRoot = NullNode;
+        return;
+    }
+
+    // The sibling takes the place of the parent
+    S32 parent = mNodes[leaf].parent;
+    S32 grandParent = mNodes[parent].parent;
+    S32 sibling = (mNodes[parent].child1 == leaf) ? mNodes[parent].child2 : mNodes[parent].child1;
+
+    freeNode(parent);
+
+    if (grandParent == NullNode)
+    {
+        mRoot = sibling;
+        mNodes[sibling].parent = NullNode;
+        return;
+    }
+
+    if (mNodes[grandParent].child1 == parent)
+        mNodes[grandParent].child1 = sibling;
+    else
+        mNodes[grandParent].child2 = sibling;
+    mNodes[sibling].parent = grandParent;
+
+    S32 index = grandParent;
+    while (index != NullNode)
+    {
+        index = balance(index);
+
+        Node& n = mNodes[index];
+        n.height = 1 + getMax(mNodes[n.child1].height, mNodes[n.child2].height);
+        n.box = getUnion(mNodes[n.child1].box, mNodes[n.child2].box);
+
+        index = n.parent;
+    }
+}
+
+S32 ContainerTree::balance(S32 iA)
+{
+    Node& A = mNodes[iA];
+    if (A.isLeaf() || A.height < 2)
+        return iA;
+
+    S32 iB = A.child1;
+    S32 iC = A.child2;
+    Node& B = mNodes[iB];
+    Node& C = mNodes[iC];
+
+    S32 diff = C.height - B.height;
+
+    // Rotate C up
+    if (diff > 1)
+    {
+        S32 iF = C.child1;
+        S32 iG = C.child2;
+        Node& F = mNodes[iF];
+        Node& G = mNodes[iG];
+
+        C.child1 = iA;
+        C.parent = A.parent;
+        A.parent = iC;
+
+        if (C.parent != NullNode)
+        {
+            if (mNodes[C.parent].child1 == iA)
+                mNodes[C.parent].child1 = iC;
+            else
+                mNodes[C.parent].child2 = iC;
+        }
+        else
+            mRoot = iC;
+
+        if (F.height > G.height)
+        {
+            C.child2 = iF;
+            A.child2 = iG;
+            G.parent = iA;
+            A.box = getUnion(B.box, G.box);
+            C.box = getUnion(A.box, F.box);
+            A.height = 1 + getMax(B.height, G.height);
+            C.height = 1 + getMax(A.height, F.height);
+        }
+        else
+        {
+            C.child2 = iG;
+            A.child2 = iF;
+            F.parent = iA;
+            A.box = getUnion(B.box, F.box);
+            C.box = getUnion(A.box, G.box);
+            A.height = 1 + getMax(B.height, F.height);
+            C.height = 1 + getMax(A.height, G.height);
+        }
+
+        return iC;
+    }
+
+    // Rotate B up
+    if (diff < -1)
+    {
+        S32 iD = B.child1;
+        S32 iE = B.child2;
+        Node& D = mNodes[iD];
+        Node& E = mNodes[iE];
+
+        B.child1 = iA;
+        B.parent = A.parent;
+        A.parent = iB;
+
+        if (B.parent != NullNode)
+        {
+            if (mNodes[B.parent].child1 == iA)
+                mNodes[B.parent].child1 = iB;
+            else
+                mNodes[B.parent].child2 = iB;
+        }
+        else
+            mRoot = iB;
+
+        if (D.height > E.height)
+        {
+            B.child2 = iD;
+            A.child1 = iE;
+            E.parent = iA;
+            A.box = getUnion(C.box, E.box);
+            B.box = getUnion(A.box, D.box);
+            A.height = 1 + getMax(C.height, E.height);
+            B.height = 1 + getMax(A.height, D.height);
+        }
+        else
+        {
+            B.child2 = iE;
+            A.child1 = iD;
+            D.parent = iA;
+            A.box = getUnion(C.box, D.box);
+            B.box = getUnion(A.box, E.box);
+            A.height = 1 + getMax(C.height, D.height);
+            B.height = 1 + getMax(A.height, E.height);
+        }
+
+        return iB;
+    }
+
+    return iA;
+}
+
+//----------------------------------------------------------------------------
+
+void ContainerTree::findObjects(const Box3F& box, LeafCallback callback, void* key) const
+{
+    if (mRoot == NullNode)
+        return;
+
+    S32 stack[MaxStackDepth];
+    S32 count = 0;
+    stack[count++] = mRoot;
+
+    while (count)
+    {
+        const Node& n = mNodes[stack[--count]];
+        if (!n.box.isOverlapped(box))
+            continue;
+
+        if (n.isLeaf())
+        {
+            (*callback)(n.object, key);
+        }
+        else
+        {
+            AssertFatal(count + 2 <= MaxStackDepth, "ContainerTree::findObjects: tree is too deep!");
+            stack[count++] = n.child1;
+            stack[count++] = n.child2;
+        }
+    }
+}
+
+void ContainerTree::castRay(const Point3F& start, const Point3F& end, RayCallback callback, void* key) const
+{
+    if (mRoot == NullNode)
+        return;
+
+    Point3F dir = end - start;
+    F32 maxT = 1.0f;
+
+    S32 stack[MaxStackDepth];
+    S32 count = 0;
+    stack[count++] = mRoot;
+
+    while (count)
+    {
+        const Node& n = mNodes[stack[--count]];
+        if (!overlapsRay(n.box, start, dir, maxT))
+            continue;
+
+        if (n.isLeaf())
+        {
+            maxT = getMin(maxT, (*callback)(n.object, key));
+        }
+        else
+        {
+            AssertFatal(count + 2 <= MaxStackDepth, "ContainerTree::castRay: tree is too deep!");
+            stack[count++] = n.child1;
+            stack[count++] = n.child2;
+        }
+    }
+}
@@ -0,0 +1,109 @@
+//-----------------------------------------------------------------------------
+// Torque Game Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#ifndef _CONTAINERTREE_H_
+#define _CONTAINERTREE_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _MBOX_H_
+#include "math/mBox.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/tVector.h"
+#endif
+
+class SceneObject;
+
+//----------------------------------------------------------------------------
+/// A dynamic bounding volume tree over the objects of a Container.
+///
+/// Each object is a leaf holding its world box grown by Margin, so an
+/// object only has to be reinserted once it moves out of that box.  The
+/// tree is kept balanced with rotations as leaves come and go, and new
+/// leaves are placed by the smallest growth in surface area.  Unlike the
+/// container bins nothing wraps around, so objects which are far apart
+/// never share a node and huge objects don't need an overflow list.
+///
+/// Nodes live in a single array and refer to each other by index.
+class ContainerTree
+{
+public:
+    enum
+    {
+        NullNode = -1,
+
+        /// The deepest tree a query can walk.  A balanced tree
+        /// this deep holds far more objects than we ever will.
+        MaxStackDepth = 256
+    };
+
+    /// How far the leaf boxes extend past the world boxes.
+    static const F32 Margin;
+
+    typedef void (*LeafCallback)(SceneObject*, void* key);
+
+    /// Called for each leaf along a ray.  Returns the fraction of the
+    /// ray which still needs to be searched, so the walk can skip
+    /// everything past the closest hit so far.
+    typedef F32(*RayCallback)(SceneObject*, void* key);
+
+private:
+    struct Node
+    {
+        Box3F box;
+        SceneObject* object;
+
+        /// The next free node when this node is unused.
+        S32 parent;
+        S32 child1;
+        S32 child2;
+
+        /// Leaves are at height zero, unused nodes at -1.
+        S32 height;
+
+        bool isLeaf() const { return child1 == NullNode; }
+    };
+
+    Vector<Node> mNodes;
+    S32 mRoot;
+    S32 mFreeList;
+
+    S32  allocateNode();
+    void freeNode(S32 node);
+
+    void insertLeaf(S32 leaf);
+    void removeLeaf(S32 leaf);
+
+    /// Rotates the subtree at the node if it is out of balance and
+    /// returns the new root of the subtree.
+    S32  balance(S32 node);
+
+public:
+    ContainerTree();
+
+    /// Adds a leaf for the object and returns it.
+    S32  insert(SceneObject* obj, const Box3F& box);
+
+    /// Removes a leaf returned by insert().
+    void remove(S32 leaf);
+
+    /// Moves the leaf if the box has left its fat box.  Returns
+    /// true if the leaf was reinserted.
+    bool update(S32 leaf, const Box3F& box);
+
+    /// Calls back with each object whose fat box overlaps the box.
+    void findObjects(const Box3F& box, LeafCallback callback, void* key) const;
+
+    /// Calls back with each object whose fat box is crossed by the
+    /// ray, in no particular order.
+    void castRay(const Point3F& start, const Point3F& end, RayCallback callback, void* key) const;
+
+    /// Returns the height of the tree, zero when it has a single leaf.
+    S32  getHeight() const { return mRoot == NullNode ? 0 : mNodes[mRoot].height; }
+};
+
+#endif  // _CONTAINERTREE_H_
@@ -19,6 +19,7 @@
 S32 gNetBitsSent = 0;
 extern S32 gNetBitsReceived;
 U32 gGhostUpdates = 0;
+U32 gSharedPackUpdates = 0;
 
 enum NetConnectionConstants {
     PingTimeout = 4500, ///< milliseconds
@@ -154,6 +155,8 @@ void NetConnection::consoleInit()
     Con::addVariable("Stats::netBitsSent", TypeS32, &gNetBitsSent);
     Con::addVariable("Stats::netBitsReceived", TypeS32, &gNetBitsReceived);
     Con::addVariable("Stats::netGhostUpdates", TypeS32, &gGhostUpdates);
+    Con::addVariable("Stats::netSharedPackUpdates", TypeS32, &gSharedPackUpdates);
+    Con::addVariable("pref::Net::SharedPackUpdates", TypeBool, &NetObject::smSharedPackUpdates);
 #ifdef TORQUE_FAST_FILE_TRANSFER
     fastFileTransferInit();
 #endif
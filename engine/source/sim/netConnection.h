@@ -25,6 +25,9 @@
 #ifndef _H_CONNECTIONSTRINGTABLE
 #include "sim/connectionStringTable.h"
 #endif
+#ifndef _DATACHUNKER_H_
+#include "core/dataChunker.h"
+#endif
 
 class NetConnection;
 class NetObject;
@@ -819,6 +822,19 @@ protected:
     GhostInfo* mGhostRefs;           ///< Allocated array of ghostInfos. Null if ghostFrom is false.
     GhostInfo** mGhostLookupTable;   ///< Table indexed by object id to GhostInfo. Null if ghostFrom is false.
 
+    /// @name GhostRef pool
+    ///
+    /// Every ghost update sent needs a GhostRef until the packet is acked or
+    /// dropped, so they are recycled through a free list instead of the heap.
+    /// @{
+    FreeListChunker<GhostRef> mGhostRefChunker;
+    /// @}
+
+    /// Scratch max-heap of ghosts to update, ordered by priority.  Only the
+    /// ghosts that fit in the packet ever get popped off it, so a packet costs
+    /// O(n + k log n) rather than a full sort of every dirty ghost.
+    Vector<GhostInfo*> mGhostUpdateHeap;
+
     /// The object around which we are scoping this connection.
     ///
     /// This is usually the player object, or a related object, like a vehicle
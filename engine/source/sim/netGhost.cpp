@@ -225,7 +225,7 @@ void NetConnection::ghostPacketDropped(PacketNotify* notify)
             packRef->ghost->flags &= ~GhostInfo::KillingGhost;
         }
 
-        delete packRef;
+        mGhostRefChunker.free(packRef);
         packRef = temp;
     }
 }
@@ -261,29 +261,48 @@ void NetConnection::ghostPacketReceived(PacketNotify* notify)
         else if (packRef->ghostInfoFlags & GhostInfo::KillingGhost)
             freeGhostInfo(packRef->ghost);
 
-        delete packRef;
+        mGhostRefChunker.free(packRef);
         packRef = temp;
     }
 }
 
-struct UpdateQueueEntry
-{
-    F32 priority;
-    GhostInfo* obj;
+// Max-heap on GhostInfo::priority, used to hand out ghosts highest
+// priority first without sorting the ones that won't fit in the packet.
 
-    UpdateQueueEntry(F32 in_priority, GhostInfo* in_obj)
+static void ghostHeapSiftDown(GhostInfo** heap, S32 size, S32 i)
+{
+    GhostInfo* item = heap[i];
+    while (true)
     {
-        priority = in_priority; obj = in_obj;
+        S32 child = i * 2 + 1;
+        if (child >= size)
+            break;
+        if (child + 1 < size && heap[child + 1]->priority > heap[child]->priority)
+            child++;
+        if (heap[child]->priority <= item->priority)
+            break;
+        heap[i] = heap[child];
+        i = child;
     }
-};
+    heap[i] = item;
+}
 
-static S32 QSORT_CALLBACK UQECompare(const void* a, const void* b)
+static void ghostHeapBuild(GhostInfo** heap, S32 size)
 {
-    GhostInfo* ga = *((GhostInfo**)a);
-    GhostInfo* gb = *((GhostInfo**)b);
+    for (S32 i = size / 2 - 1; i >= 0; i--)
+        ghostHeapSiftDown(heap, size, i);
+}
 
-    F32 ret = ga->priority - gb->priority;
-    return (ret < 0) ? -1 : ((ret > 0) ? 1 : 0);
+static GhostInfo* ghostHeapPop(GhostInfo** heap, S32& size)
+{
+    GhostInfo* top = heap[0];
+    size--;
+    if (size > 0)
+    {
+        heap[0] = heap[size];
+        ghostHeapSiftDown(heap, size, 0);
+    }
+    return top;
 }
 
 void NetConnection::ghostWritePacket(BitStream* bstream, PacketNotify* notify)
@@ -364,16 +383,15 @@ void NetConnection::ghostWritePacket(BitStream* bstream, PacketNotify* notify)
                 walk->priority = 10000;
             else
                 walk->priority = walk->obj->getUpdatePriority(&camInfo, walk->updateMask, walk->updateSkipCount);
+            mGhostUpdateHeap.push_back(walk);
         }
         else
             walk->priority = 0;
     }
     GhostRef* updateList = NULL;
-    dQsort(mGhostArray, mGhostZeroUpdateIndex, sizeof(GhostInfo*), UQECompare);
 
-    // reset the array indices...
-    for (i = mGhostZeroUpdateIndex - 1; i >= 0; i--)
-        mGhostArray[i]->arrayIndex = i;
+    S32 heapSize = mGhostUpdateHeap.size();
+    ghostHeapBuild(mGhostUpdateHeap.address(), heapSize);
 
     S32 sendSize = 1;
     while (maxIndex >>= 1)
@@ -386,18 +404,16 @@ void NetConnection::ghostWritePacket(BitStream* bstream, PacketNotify* notify)
 
     U32 count = 0;
     //
-    for (i = mGhostZeroUpdateIndex - 1; i >= 0 && !bstream->isFull(); i--)
+    while (heapSize > 0 && !bstream->isFull())
     {
-        GhostInfo* walk = mGhostArray[i];
-        if (walk->flags & (GhostInfo::KillingGhost | GhostInfo::Ghosting))
-            continue;
+        GhostInfo* walk = ghostHeapPop(mGhostUpdateHeap.address(), heapSize);
 
         bstream->writeFlag(true);
 
         bstream->writeInt(walk->index, sendSize);
         U32 updateMask = walk->updateMask;
 
-        GhostRef* upd = new GhostRef;
+        GhostRef* upd = mGhostRefChunker.alloc();
 
         upd->nextRef = updateList;
         updateList = upd;
@@ -446,7 +462,11 @@ void NetConnection::ghostWritePacket(BitStream* bstream, PacketNotify* notify)
 #ifdef TORQUE_NET_STATS
             U32 beginSize = bstream->getCurPos();
 #endif
-            U32 retMask = walk->obj->packUpdate(this, updateMask, bstream);
+            U32 retMask;
+            if (NetObject::smSharedPackUpdates && walk->obj->canShareUpdate(updateMask))
+                retMask = walk->obj->packSharedUpdate(this, updateMask, bstream);
+            else
+                retMask = walk->obj->packUpdate(this, updateMask, bstream);
 #ifdef TORQUE_NET_STATS
             walk->obj->getClassRep()->updateNetStatPack(updateMask, bstream->getCurPos() - beginSize);
 #endif
@@ -472,6 +492,8 @@ void NetConnection::ghostWritePacket(BitStream* bstream, PacketNotify* notify)
         walk->updateSkipCount = 0;
         count++;
     }
+    mGhostUpdateHeap.clear();
+
     //Con::printf("Ghosts updated: %d (%d remain)", count, mGhostZeroUpdateIndex);
     // no more objects...
     bstream->writeFlag(false);
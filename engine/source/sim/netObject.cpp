@@ -10,11 +10,26 @@
 #include "sim/netObject.h"
 #include "console/consoleTypes.h"
 #include "game/game.h"
+#include "core/bitStream.h"
+#include "platform/event.h"
+
+extern U32 gSharedPackUpdates;
 
 IMPLEMENT_CONOBJECT(NetObject);
 
 //----------------------------------------------------------------------------
 NetObject* NetObject::mDirtyList = NULL;
+bool NetObject::smSharedPackUpdates = true;
+
+struct NetObject::SharedPackUpdate
+{
+    bool valid;
+    SimTime time;
+    U32 mask;
+    U32 retMask;
+    U32 bitCount;
+    Vector<U8> data;
+};
 
 NetObject::NetObject()
 {
@@ -25,10 +40,14 @@ NetObject::NetObject()
     mNextDirtyList = NULL;
     mDirtyMaskBits = 0;
     mSPModeObject = false;
+    mSharedPackMask = 0;
+    mSharedPackUpdate = NULL;
 }
 
 NetObject::~NetObject()
 {
+    delete mSharedPackUpdate;
+
     if (mDirtyMaskBits)
     {
         if (mPrevDirtyList)
@@ -43,6 +62,11 @@ NetObject::~NetObject()
 void NetObject::setMaskBits(U32 orMask)
 {
     AssertFatal(orMask != 0, "Invalid net mask bits set.");
+
+    // Whatever changed has to be packed again.
+    if (mSharedPackUpdate)
+        mSharedPackUpdate->valid = false;
+
     AssertFatal(mDirtyMaskBits == 0 || (mPrevDirtyList != NULL || mNextDirtyList != NULL || mDirtyList == this), "Invalid dirty list state.");
     if (!mDirtyMaskBits)
     {
@@ -246,6 +270,40 @@ void NetObject::unpackUpdate(NetConnection*, BitStream*)
 {
 }
 
+U32 NetObject::packSharedUpdate(NetConnection* conn, U32 mask, BitStream* stream)
+{
+    AssertFatal(canShareUpdate(mask), "NetObject::packSharedUpdate: mask has connection dependent bits");
+
+    if (!mSharedPackUpdate)
+    {
+        mSharedPackUpdate = new SharedPackUpdate;
+        mSharedPackUpdate->valid = false;
+    }
+
+    SharedPackUpdate* shared = mSharedPackUpdate;
+    SimTime time = Sim::getCurrentTime();
+
+    if (!shared->valid || shared->mask != mask || shared->time != time)
+    {
+        static U8 sPackBuffer[MaxPacketDataSize];
+        BitStream packStream(sPackBuffer, sizeof(sPackBuffer));
+
+        shared->retMask = packUpdate(conn, mask, &packStream);
+        shared->bitCount = packStream.getCurPos();
+        shared->data.setSize((shared->bitCount + 7) >> 3);
+        dMemcpy(shared->data.address(), sPackBuffer, shared->data.size());
+
+        shared->mask = mask;
+        shared->time = time;
+        shared->valid = true;
+    }
+    else
+        gSharedPackUpdates++;
+
+    stream->writeBits(shared->bitCount, shared->data.address());
+    return shared->retMask;
+}
+
 void NetObject::onCameraScopeQuery(NetConnection* cr, CameraScopeQuery* /*camInfo*/)
 {
     // default behavior -
@@ -236,6 +236,10 @@ private:
     NetObject* mNextDirtyList;
 
     /// @}
+
+    /// The last update packed by packSharedUpdate(), allocated on first use.
+    struct SharedPackUpdate;
+    SharedPackUpdate* mSharedPackUpdate;
 protected:
 
     /// Pointer to the server object; used only when we are doing "short-circuited" networking.
@@ -269,6 +273,16 @@ protected:
 
     bool mSPModeObject; ///< Is this object part of the preview system
 
+    /// Mask bits whose packUpdate() output does not depend on the connection
+    /// it is written for.
+    ///
+    /// When every bit of a ghost's update mask is in here, the update is packed
+    /// once per tick and the same bits are copied to each client.  Only add bits
+    /// whose packing (including the parent classes' handling of the same mask)
+    /// never touches the connection, its string table, ghost indices or the
+    /// stream's compression point.  Subclasses set this in their constructor.
+    U32 mSharedPackMask;
+
 public:
     NetObject();
     ~NetObject();
@@ -337,6 +351,18 @@ public:
     /// @param   stream  stream to read from
     virtual void unpackUpdate(NetConnection* conn, BitStream* stream);
 
+    /// Returns true if an update with this mask may be shared between connections.
+    bool canShareUpdate(U32 mask) const { return mSharedPackMask && !(mask & ~mSharedPackMask); }
+
+    /// Write the same bits packUpdate() would, reusing the bits packed for an
+    /// earlier connection if the mask and the object are unchanged this tick.
+    ///
+    /// @see mSharedPackMask
+    U32 packSharedUpdate(NetConnection* conn, U32 mask, BitStream* stream);
+
+    /// Set to false to pack every update separately for each connection.
+    static bool smSharedPackUpdates;
+
     /// Queries the object about information used to determine scope.
     ///
     /// Something that is 'in scope' is somehow interesting to the client.
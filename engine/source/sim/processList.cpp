@@ -15,10 +15,12 @@
 #include "game/gameProcess.h"
 #include "math/mathUtils.h"
 #include "game/tickCache.h"
+#include "core/threadPool.h"
 
 //----------------------------------------------------------------------------
 
 bool ProcessList::mDebugControlSync = false;
+bool ProcessList::smParallelTick = false;
 U32 gNetOrderNextId = 0;
 F32 gMaxHiFiVelSq = 100 * 100;
 
@@ -427,6 +429,31 @@ void ProcessList::dumpToConsole()
 
 //----------------------------------------------------------------------------
 
+void ProcessList::prepareObjectParallel(void* data, U32 index)
+{
+    GameBase** objects = reinterpret_cast<GameBase**>(data);
+    objects[index]->prepareTickParallel();
+}
+
+void ProcessList::prepareObjectsParallel()
+{
+    PROFILE_START(PrepareObjectsParallel);
+
+    static Vector<GameBase*> sPrepareList;
+    sPrepareList.clear();
+
+    for (ProcessObject* pobj = mHead.mProcessLink.next; pobj != &mHead; pobj = pobj->mProcessLink.next)
+    {
+        GameBase* gb = getGameBase(pobj);
+        if (gb->mProcessTick && gb->hasParallelTickWork())
+            sPrepareList.push_back(gb);
+    }
+
+    ThreadPool::getGlobal()->parallelFor(sPrepareList.size(), prepareObjectParallel, sPrepareList.address());
+
+    PROFILE_END();
+}
+
 void ProcessList::advanceObjects()
 {
     PROFILE_START(AdvanceObjects);
@@ -434,6 +461,9 @@ void ProcessList::advanceObjects()
     if (!mIsServer)
         gMaxHiFiVelSq = 0.0f;
 
+    if (mIsServer && smParallelTick && ThreadPool::getGlobal())
+        prepareObjectsParallel();
+
     // A little link list shuffling is done here to avoid problems
     // with objects being deleted from within the process method.
     ProcessObject list;
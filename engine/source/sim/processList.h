@@ -52,9 +52,18 @@ class ProcessList
     static bool mDebugControlSync;
 
     void orderList();
+    void prepareObjectsParallel();
     void advanceObjects();
 
+    static void prepareObjectParallel(void* data, U32 index);
+
 public:
+    /// When set, server process lists let objects do their read-only tick
+    /// preparation on the global ThreadPool before ticking them in order.
+    ///
+    /// @see GameBase::prepareTickParallel
+    static bool smParallelTick;
+
     SimTime getLastTime() { return mLastTime; }
     ProcessList(bool isServer);
     void markDirty() { mDirty = true; }
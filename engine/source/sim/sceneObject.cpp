@@ -11,6 +11,7 @@
 #include "platform/profiler.h"
 
 #include "platform/profiler.h"
+#include "math/mRandom.h"
 #include "interior/interior.h"
 #include "interior/interiorInstance.h"
 #ifdef TORQUE_TERRAIN
@@ -27,6 +28,7 @@ const U32 Container::csmNumBins = 16;
 const F32 Container::csmBinSize = 64;
 const F32 Container::csmTotalBinSize = Container::csmBinSize * Container::csmNumBins;
 U32       Container::smCurrSeqKey = 1;
+U32       Container::smBatchSeqKey = 1;
 const U32 Container::csmRefPoolBlockSize = 4096;
 
 // Statics used by buildPolyList methods
@@ -247,6 +249,121 @@ ConsoleFunction(containerRayCast, const char*, 4, 5, "( Point3F start, Point3F e
     return(returnBuffer);
 }
 
+ConsoleFunction(setContainerDatabase, void, 2, 2, "(string database)"
+    "Switches the containers over to the \"bins\" or the \"tree\" database.\n\n"
+    "The bins are a grid which wraps every 1024 units, so levels bigger than that "
+    "are better off with the tree.")
+{
+    Container::Database database;
+    if (!dStricmp(argv[1], "bins"))
+        database = Container::BinDatabase;
+    else if (!dStricmp(argv[1], "tree"))
+        database = Container::TreeDatabase;
+    else
+    {
+        Con::errorf("setContainerDatabase: unknown database '%s'.", argv[1]);
+        return;
+    }
+
+    gServerContainer.setDatabase(database);
+    gClientContainer.setDatabase(database);
+    gSPModeContainer.setDatabase(database);
+}
+
+ConsoleFunction(getContainerDatabase, const char*, 1, 1, "Returns the database the containers use, \"bins\" or \"tree\".")
+{
+    return gServerContainer.getDatabase() == Container::TreeDatabase ? "tree" : "bins";
+}
+
+ConsoleFunction(containerBenchmark, void, 1, 3, "(int queries=1000, bitset mask=-1)"
+    "Runs the same random box queries and ray casts over the mission against each "
+    "of the server container's databases, and prints how long they took and how "
+    "many objects they had to look at.")
+{
+    U32 numQueries = argc > 1 ? dAtoi(argv[1]) : 1000;
+    U32 mask = argc > 2 ? dAtoi(argv[2]) : 0xFFFFFFFF;
+    Container* container = getCurrentServerContainer();
+
+    // Keep the queries to where the objects are
+    SimpleQueryList queryList;
+    container->findObjects(0xFFFFFFFF, SimpleQueryList::insertionCallback, &queryList);
+
+    Box3F bounds(Point3F(1e10, 1e10, 1e10), Point3F(-1e10, -1e10, -1e10), true);
+    for (U32 i = 0; i < queryList.mList.size(); i++)
+    {
+        if (!queryList.mList[i]->isGlobalBounds())
+            bounds.intersect(queryList.mList[i]->getWorldBox());
+    }
+
+    if (!bounds.isValidBox())
+    {
+        Con::errorf("containerBenchmark: there are no objects to query.");
+        return;
+    }
+
+    MRandomLCG random(1376312589);
+    Vector<Box3F> boxes;
+    Vector<Point3F> rayStarts;
+    Vector<Point3F> rayEnds;
+    for (U32 i = 0; i < numQueries; i++)
+    {
+        Point3F center(random.randF(bounds.min.x, bounds.max.x),
+            random.randF(bounds.min.y, bounds.max.y),
+            random.randF(bounds.min.z, bounds.max.z));
+        Point3F extent(random.randF(1, 32), random.randF(1, 32), random.randF(1, 32));
+        boxes.push_back(Box3F(center - extent, center + extent, true));
+
+        Point3F start(random.randF(bounds.min.x, bounds.max.x),
+            random.randF(bounds.min.y, bounds.max.y),
+            random.randF(bounds.min.z, bounds.max.z));
+        VectorF dir(random.randF(-1, 1), random.randF(-1, 1), random.randF(-1, 1));
+        if (dir.isZero())
+            dir.set(0, 0, -1);
+        dir.normalize(random.randF(10, 250));
+        rayStarts.push_back(start);
+        rayEnds.push_back(start + dir);
+    }
+
+    Container::Database oldDatabase = container->getDatabase();
+    Con::printf("Container benchmark, %d objects:", queryList.mList.size());
+
+    for (U32 d = Container::BinDatabase; d <= Container::TreeDatabase; d++)
+    {
+        container->setDatabase((Container::Database)d);
+
+        container->resetNumObjectTests();
+        U32 found = 0;
+        U32 time = Platform::getRealMilliseconds();
+        for (U32 i = 0; i < boxes.size(); i++)
+        {
+            queryList.mList.clear();
+            container->findObjects(boxes[i], mask, SimpleQueryList::insertionCallback, &queryList);
+            found += queryList.mList.size();
+        }
+        U32 boxTime = Platform::getRealMilliseconds() - time;
+        U32 boxTests = container->getNumObjectTests();
+
+        container->resetNumObjectTests();
+        U32 hits = 0;
+        time = Platform::getRealMilliseconds();
+        for (U32 i = 0; i < rayStarts.size(); i++)
+        {
+            RayInfo info;
+            if (container->castRay(rayStarts[i], rayEnds[i], mask, &info))
+                hits++;
+        }
+        U32 rayTime = Platform::getRealMilliseconds() - time;
+        U32 rayTests = container->getNumObjectTests();
+
+        Con::printf("   %s: %d boxes found %d objects in %d ms (%d object tests), %d rays hit %d in %d ms (%d object tests)",
+            d == Container::TreeDatabase ? "tree" : "bins",
+            boxes.size(), found, boxTime, boxTests,
+            rayStarts.size(), hits, rayTime, rayTests);
+    }
+
+    container->setDatabase(oldDatabase);
+}
+
 ConsoleFunctionGroupEnd(Containers);
 
 // Utility method for bin insertion
@@ -356,8 +473,10 @@ SceneObject::SceneObject()
     mRenderWorldSphere = SphereF(Point3F(0, 0, 0), 0);
 
     mContainerSeqKey = 0;
+    mContainerBatchKey = 0;
 
     mBinRefHead = NULL;
+    mTreeNode = ContainerTree::NullNode;
 
     mSceneManager = NULL;
     mZoneRangeStart = 0xFFFFFFFF;
@@ -867,6 +986,9 @@ Container::Container()
     mFreeRefPool = NULL;
     addRefPoolBlock();
 
+    mDatabase = BinDatabase;
+    mNumObjectTests = 0;
+
     cleanupSearchVectors();
 }
 
@@ -939,6 +1061,15 @@ void Container::insertIntoBins(SceneObject* obj)
 {
     AssertFatal(obj != NULL, "No object?");
     AssertFatal(obj->mBinRefHead == NULL, "Error, already have a bin chain!");
+    AssertFatal(obj->mTreeNode == ContainerTree::NullNode, "Error, already in the tree!");
+
+    // Global bounds objects overlap everything, so the tree
+    //  would only be slower for them...
+    if (mDatabase == TreeDatabase && !obj->isGlobalBounds())
+    {
+        obj->mTreeNode = mTree.insert(obj, obj->getWorldBox());
+        return;
+    }
 
     // The first thing we do is find which bins are covered in x and y...
     const Box3F* pWBox = &obj->getWorldBox();
@@ -1067,6 +1198,12 @@ void Container::removeFromBins(SceneObject* obj)
     PROFILE_START(RemoveFromBins);
     AssertFatal(obj != NULL, "No object?");
 
+    if (obj->mTreeNode != ContainerTree::NullNode)
+    {
+        mTree.remove(obj->mTreeNode);
+        obj->mTreeNode = ContainerTree::NullNode;
+    }
+
     SceneObjectRef* chain = obj->mBinRefHead;
     obj->mBinRefHead = NULL;
 
@@ -1091,6 +1228,13 @@ void Container::checkBins(SceneObject* obj)
     AssertFatal(obj != NULL, "No object?");
 
     PROFILE_START(CheckBins);
+    if (obj->mTreeNode != ContainerTree::NullNode)
+    {
+        mTree.update(obj->mTreeNode, obj->getWorldBox());
+        PROFILE_END();
+        return;
+    }
+
     if (obj->mBinRefHead == NULL)
     {
         insertIntoBins(obj);
@@ -1117,6 +1261,91 @@ void Container::checkBins(SceneObject* obj)
 }
 
 
+void Container::setDatabase(Database database)
+{
+    if (database == mDatabase)
+        return;
+
+    for (Link* itr = mStart.next; itr != &mEnd; itr = itr->next)
+        removeFromBins(static_cast<SceneObject*>(itr));
+
+    mDatabase = database;
+
+    for (Link* itr = mStart.next; itr != &mEnd; itr = itr->next)
+        insertIntoBins(static_cast<SceneObject*>(itr));
+}
+
+
+//----------------------------------------------------------------------------
+// The tree hands back each object once, so these skip the sequence key.
+
+struct TreeQuery
+{
+    const Box3F* box;
+    U32 mask;
+    bool checkHidden;
+    Container::FindCallback callback;
+    void* key;
+    U32* numObjectTests;
+};
+
+void Container::treeFindCallback(SceneObject* obj, void* key)
+{
+    TreeQuery* query = reinterpret_cast<TreeQuery*>(key);
+    (*query->numObjectTests)++;
+
+    if ((obj->getType() & query->mask) != 0 &&
+        obj->isCollisionEnabled() && !(query->checkHidden && obj->isHidden()))
+    {
+        if (obj->getWorldBox().isOverlapped(*query->box))
+            (*query->callback)(obj, query->key);
+    }
+}
+
+struct TreeRayQuery
+{
+    Point3F start;
+    Point3F end;
+    U32 mask;
+    RayInfo* info;
+    F32 currentT;
+    U32* numObjectTests;
+};
+
+F32 Container::treeRayCallback(SceneObject* ptr, void* key)
+{
+    TreeRayQuery* query = reinterpret_cast<TreeRayQuery*>(key);
+    (*query->numObjectTests)++;
+
+    if ((ptr->getType() & query->mask) != 0 &&
+        ptr->isCollisionEnabled() == true &&
+        ptr->getWorldBox().collideLine(query->start, query->end))
+    {
+        Point3F xformedStart, xformedEnd;
+        ptr->mWorldToObj.mulP(query->start, &xformedStart);
+        ptr->mWorldToObj.mulP(query->end, &xformedEnd);
+        xformedStart.convolveInverse(ptr->mObjScale);
+        xformedEnd.convolveInverse(ptr->mObjScale);
+
+        RayInfo ri;
+        if (ptr->castRay(xformedStart, xformedEnd, &ri))
+        {
+            if (ri.t < query->currentT)
+            {
+                *query->info = ri;
+                query->info->point.interpolate(query->start, query->end, query->info->t);
+                query->currentT = ri.t;
+            }
+        }
+    }
+
+    // Nothing past the closest hit matters
+    return query->currentT;
+}
+
+
+//----------------------------------------------------------------------------
+
 void Container::findObjects(const Box3F& box, U32 mask, FindCallback callback, void* key)
 {
     PROFILE_START(ContainerFindObjects);
@@ -1124,31 +1353,40 @@ void Container::findObjects(const Box3F& box, U32 mask, FindCallback callback, v
     getBinRange(box.min.x, box.max.x, minX, maxX);
     getBinRange(box.min.y, box.max.y, minY, maxY);
     smCurrSeqKey++;
-    for (U32 i = minY; i <= maxY; i++)
+    if (mDatabase == TreeDatabase)
     {
-        U32 insertY = i % csmNumBins;
-        U32 base = insertY * csmNumBins;
-        for (U32 j = minX; j <= maxX; j++)
+        TreeQuery query = { &box, mask, true, callback, key, &mNumObjectTests };
+        mTree.findObjects(box, treeFindCallback, &query);
+    }
+    else
+    {
+        for (U32 i = minY; i <= maxY; i++)
         {
-            U32 insertX = j % csmNumBins;
-
-            SceneObjectRef* chain = mBinArray[base + insertX].nextInBin;
-            while (chain)
+            U32 insertY = i % csmNumBins;
+            U32 base = insertY * csmNumBins;
+            for (U32 j = minX; j <= maxX; j++)
             {
-                if (chain->object->getContainerSeqKey() != smCurrSeqKey)
-                {
-                    chain->object->setContainerSeqKey(smCurrSeqKey);
+                U32 insertX = j % csmNumBins;
 
-                    if ((chain->object->getType() & mask) != 0 &&
-                        chain->object->isCollisionEnabled() && !chain->object->isHidden())
+                SceneObjectRef* chain = mBinArray[base + insertX].nextInBin;
+                while (chain)
+                {
+                    if (chain->object->getContainerSeqKey() != smCurrSeqKey)
                     {
-                        if (chain->object->getWorldBox().isOverlapped(box) || chain->object->isGlobalBounds())
+                        chain->object->setContainerSeqKey(smCurrSeqKey);
+                        mNumObjectTests++;
+
+                        if ((chain->object->getType() & mask) != 0 &&
+                            chain->object->isCollisionEnabled() && !chain->object->isHidden())
                         {
-                            (*callback)(chain->object, key);
+                            if (chain->object->getWorldBox().isOverlapped(box) || chain->object->isGlobalBounds())
+                            {
+                                (*callback)(chain->object, key);
+                            }
                         }
                     }
+                    chain = chain->nextInBin;
                 }
-                chain = chain->nextInBin;
             }
         }
     }
@@ -1158,6 +1396,7 @@ void Container::findObjects(const Box3F& box, U32 mask, FindCallback callback, v
         if (chain->object->getContainerSeqKey() != smCurrSeqKey)
         {
             chain->object->setContainerSeqKey(smCurrSeqKey);
+            mNumObjectTests++;
 
             if ((chain->object->getType() & mask) != 0 &&
                 chain->object->isCollisionEnabled() && !chain->object->isHidden())
@@ -1190,31 +1429,40 @@ void Container::polyhedronFindObjects(const Polyhedron& polyhedron, U32 mask, Fi
     getBinRange(box.min.x, box.max.x, minX, maxX);
     getBinRange(box.min.y, box.max.y, minY, maxY);
     smCurrSeqKey++;
-    for (i = minY; i <= maxY; i++)
+    if (mDatabase == TreeDatabase)
+    {
+        TreeQuery query = { &box, mask, false, callback, key, &mNumObjectTests };
+        mTree.findObjects(box, treeFindCallback, &query);
+    }
+    else
     {
-        U32 insertY = i % csmNumBins;
-        U32 base = insertY * csmNumBins;
-        for (U32 j = minX; j <= maxX; j++)
+        for (i = minY; i <= maxY; i++)
         {
-            U32 insertX = j % csmNumBins;
-
-            SceneObjectRef* chain = mBinArray[base + insertX].nextInBin;
-            while (chain)
+            U32 insertY = i % csmNumBins;
+            U32 base = insertY * csmNumBins;
+            for (U32 j = minX; j <= maxX; j++)
             {
-                if (chain->object->getContainerSeqKey() != smCurrSeqKey)
-                {
-                    chain->object->setContainerSeqKey(smCurrSeqKey);
+                U32 insertX = j % csmNumBins;
 
-                    if ((chain->object->getType() & mask) != 0 &&
-                        chain->object->isCollisionEnabled())
+                SceneObjectRef* chain = mBinArray[base + insertX].nextInBin;
+                while (chain)
+                {
+                    if (chain->object->getContainerSeqKey() != smCurrSeqKey)
                     {
-                        if (chain->object->getWorldBox().isOverlapped(box) || chain->object->isGlobalBounds())
+                        chain->object->setContainerSeqKey(smCurrSeqKey);
+                        mNumObjectTests++;
+
+                        if ((chain->object->getType() & mask) != 0 &&
+                            chain->object->isCollisionEnabled())
                         {
-                            (*callback)(chain->object, key);
+                            if (chain->object->getWorldBox().isOverlapped(box) || chain->object->isGlobalBounds())
+                            {
+                                (*callback)(chain->object, key);
+                            }
                         }
                     }
+                    chain = chain->nextInBin;
                 }
-                chain = chain->nextInBin;
             }
         }
     }
@@ -1224,6 +1472,7 @@ void Container::polyhedronFindObjects(const Polyhedron& polyhedron, U32 mask, Fi
         if (chain->object->getContainerSeqKey() != smCurrSeqKey)
         {
             chain->object->setContainerSeqKey(smCurrSeqKey);
+            mNumObjectTests++;
 
             if ((chain->object->getType() & mask) != 0 &&
                 chain->object->isCollisionEnabled())
@@ -1239,6 +1488,21 @@ void Container::polyhedronFindObjects(const Polyhedron& polyhedron, U32 mask, Fi
 }
 
 
+//----------------------------------------------------------------------------
+
+static void transformRayNormal(RayInfo* info)
+{
+    PlaneF fakePlane;
+    fakePlane.x = info->normal.x;
+    fakePlane.y = info->normal.y;
+    fakePlane.z = info->normal.z;
+    fakePlane.d = 0;
+
+    PlaneF result;
+    mTransformPlane(info->object->getTransform(), info->object->getScale(), fakePlane, &result);
+    info->normal = result;
+}
+
 //----------------------------------------------------------------------------
 // DMMNOTE: There are still some optimizations to be done here.  In particular:
 //           - After checking the overflow bin, we can potentially shorten the line
@@ -1265,6 +1529,7 @@ bool Container::castRay(const Point3F& start, const Point3F& end, U32 mask, RayI
         if (ptr->getContainerSeqKey() != smCurrSeqKey)
         {
             ptr->setContainerSeqKey(smCurrSeqKey);
+            mNumObjectTests++;
 
             // In the overflow bin, the world box is always going to intersect the line,
             //  so we can omit that test...
@@ -1292,6 +1557,34 @@ bool Container::castRay(const Point3F& start, const Point3F& end, U32 mask, RayI
         chain = chain->nextInBin;
     }
 
+    if (mDatabase == TreeDatabase)
+    {
+        TreeRayQuery query = { start, end, mask, info, currentT, &mNumObjectTests };
+        mTree.castRay(start, end, treeRayCallback, &query);
+        currentT = query.currentT;
+    }
+    else
+        castRayBins(start, end, mask, info, currentT);
+
+    // Bump the normal into worldspace if appropriate.
+    if (currentT != 2)
+    {
+        transformRayNormal(info);
+
+        PROFILE_END();
+        return true;
+    }
+    else
+    {
+        // Do nothing and exit...
+        PROFILE_END();
+        return false;
+    }
+
+}
+
+void Container::castRayBins(const Point3F& start, const Point3F& end, U32 mask, RayInfo* info, F32& currentT)
+{
     // These are just for rasterizing the line against the grid.  We want the x coord
     //  of the start to be <= the x coord of the end
     Point3F normalStart, normalEnd;
@@ -1357,6 +1650,7 @@ bool Container::castRay(const Point3F& start, const Point3F& end, U32 mask, RayI
                 if (ptr->getContainerSeqKey() != smCurrSeqKey)
                 {
                     ptr->setContainerSeqKey(smCurrSeqKey);
+                    mNumObjectTests++;
 
                     if ((ptr->getType() & mask) != 0 &&
                         ptr->isCollisionEnabled() == true)
@@ -1442,6 +1736,7 @@ bool Container::castRay(const Point3F& start, const Point3F& end, U32 mask, RayI
                         if (ptr->getContainerSeqKey() != smCurrSeqKey)
                         {
                             ptr->setContainerSeqKey(smCurrSeqKey);
+                            mNumObjectTests++;
 
                             if ((ptr->getType() & mask) != 0 &&
                                 ptr->isCollisionEnabled() == true)
@@ -1478,32 +1773,189 @@ bool Container::castRay(const Point3F& start, const Point3F& end, U32 mask, RayI
             currStartX = currEndX;
         }
     }
+}
 
-    // Bump the normal into worldspace if appropriate.
-    if (currentT != 2)
-    {
-        PlaneF fakePlane;
-        fakePlane.x = info->normal.x;
-        fakePlane.y = info->normal.y;
-        fakePlane.z = info->normal.z;
-        fakePlane.d = 0;
+//----------------------------------------------------------------------------
 
-        PlaneF result;
-        mTransformPlane(info->object->getTransform(), info->object->getScale(), fakePlane, &result);
-        info->normal = result;
+static inline bool isCandidate(SceneObject* obj, U32 mask, bool checkHidden)
+{
+    return (obj->getType() & mask) != 0 && obj->isCollisionEnabled() &&
+        !(checkHidden && obj->isHidden());
+}
 
-        PROFILE_END();
-        return true;
+struct CandidateQuery
+{
+    Vector<SceneObject*>* candidates;
+    U32 mask;
+    bool checkHidden;
+    U32 seqKey;
+    U32* numObjectTests;
+};
+
+void Container::treeCandidateCallback(SceneObject* obj, void* key)
+{
+    CandidateQuery* query = reinterpret_cast<CandidateQuery*>(key);
+
+    // The tree hands back each object once per box, but
+    //  the boxes of a batch usually overlap...
+    if (obj->mContainerBatchKey == query->seqKey)
+        return;
+    obj->mContainerBatchKey = query->seqKey;
+    (*query->numObjectTests)++;
+
+    if (isCandidate(obj, query->mask, query->checkHidden))
+        query->candidates->push_back(obj);
+}
+
+void Container::gatherCandidates(const Box3F* boxes, U32 numBoxes, U32 mask, bool checkHidden, Vector<SceneObject*>& candidates)
+{
+    PROFILE_START(ContainerGatherCandidates);
+
+    // Batches use their own key, so a query whose callback issued
+    //  this batch still finds its own key on the objects afterwards.
+    //  Nothing is called back from here, so batches never nest.
+    U32 seqKey = ++smBatchSeqKey;
+
+    if (mDatabase == TreeDatabase)
+    {
+        CandidateQuery query = { &candidates, mask, checkHidden, seqKey, &mNumObjectTests };
+        for (U32 b = 0; b < numBoxes; b++)
+            mTree.findObjects(boxes[b], treeCandidateCallback, &query);
     }
     else
     {
-        // Do nothing and exit...
-        PROFILE_END();
-        return false;
+        bool binVisited[csmNumBins * csmNumBins];
+        dMemset(binVisited, 0, sizeof(binVisited));
+
+        for (U32 b = 0; b < numBoxes; b++)
+        {
+            U32 minX, maxX, minY, maxY;
+            getBinRange(boxes[b].min.x, boxes[b].max.x, minX, maxX);
+            getBinRange(boxes[b].min.y, boxes[b].max.y, minY, maxY);
+
+            for (U32 i = minY; i <= maxY; i++)
+            {
+                U32 base = (i % csmNumBins) * csmNumBins;
+                for (U32 j = minX; j <= maxX; j++)
+                {
+                    U32 bin = base + (j % csmNumBins);
+                    if (binVisited[bin])
+                        continue;
+                    binVisited[bin] = true;
+
+                    for (SceneObjectRef* chain = mBinArray[bin].nextInBin; chain; chain = chain->nextInBin)
+                    {
+                        SceneObject* obj = chain->object;
+                        if (obj->mContainerBatchKey != seqKey)
+                        {
+                            obj->mContainerBatchKey = seqKey;
+                            mNumObjectTests++;
+
+                            if (isCandidate(obj, mask, checkHidden))
+                                candidates.push_back(obj);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    for (SceneObjectRef* chain = mOverflowBin.nextInBin; chain; chain = chain->nextInBin)
+    {
+        SceneObject* obj = chain->object;
+        if (obj->mContainerBatchKey != seqKey)
+        {
+            obj->mContainerBatchKey = seqKey;
+            mNumObjectTests++;
+
+            if (isCandidate(obj, mask, checkHidden))
+                candidates.push_back(obj);
+        }
+    }
+
+    PROFILE_END();
+}
+
+U32 Container::castRays(const Point3F* starts, const Point3F* ends, U32 numRays, U32 mask, RayInfo* infos, bool* hits)
+{
+    PROFILE_START(ContainerCastRays);
+
+    Vector<Box3F> rayBoxes;
+    rayBoxes.setSize(numRays);
+    for (U32 i = 0; i < numRays; i++)
+    {
+        rayBoxes[i].min = starts[i];
+        rayBoxes[i].max = starts[i];
+        rayBoxes[i].min.setMin(ends[i]);
+        rayBoxes[i].max.setMax(ends[i]);
+    }
+
+    Vector<SceneObject*> candidates;
+    gatherCandidates(rayBoxes.address(), numRays, mask, false, candidates);
+
+    U32 numHits = 0;
+    for (U32 i = 0; i < numRays; i++)
+    {
+        F32 currentT = 2.0;
+        for (U32 c = 0; c < candidates.size(); c++)
+        {
+            SceneObject* ptr = candidates[c];
+            if (!ptr->isGlobalBounds() &&
+                (!ptr->getWorldBox().isOverlapped(rayBoxes[i]) || !ptr->getWorldBox().collideLine(starts[i], ends[i])))
+                continue;
+
+            Point3F xformedStart, xformedEnd;
+            ptr->mWorldToObj.mulP(starts[i], &xformedStart);
+            ptr->mWorldToObj.mulP(ends[i], &xformedEnd);
+            xformedStart.convolveInverse(ptr->mObjScale);
+            xformedEnd.convolveInverse(ptr->mObjScale);
+
+            RayInfo ri;
+            if (ptr->castRay(xformedStart, xformedEnd, &ri))
+            {
+                if (ri.t < currentT)
+                {
+                    infos[i] = ri;
+                    infos[i].point.interpolate(starts[i], ends[i], ri.t);
+                    currentT = ri.t;
+                }
+            }
+        }
+
+        hits[i] = currentT != 2;
+        if (hits[i])
+        {
+            transformRayNormal(&infos[i]);
+            numHits++;
+        }
     }
 
+    PROFILE_END();
+    return numHits;
+}
+
+void Container::findObjectsBatch(const Box3F* boxes, U32 numBoxes, U32 mask, Vector<SceneObject*>* results)
+{
+    PROFILE_START(ContainerFindObjectsBatch);
+
+    Vector<SceneObject*> candidates;
+    gatherCandidates(boxes, numBoxes, mask, true, candidates);
+
+    for (U32 c = 0; c < candidates.size(); c++)
+    {
+        SceneObject* obj = candidates[c];
+        for (U32 b = 0; b < numBoxes; b++)
+        {
+            if (obj->getWorldBox().isOverlapped(boxes[b]) || obj->isGlobalBounds())
+                results[b].push_back(obj);
+        }
+    }
+
+    PROFILE_END();
 }
 
+//----------------------------------------------------------------------------
+
 // collide with the objects projected object box
 bool Container::collideBox(const Point3F& start, const Point3F& end, U32 mask, RayInfo* info)
 {
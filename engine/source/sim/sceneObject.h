@@ -30,6 +30,9 @@
 #ifndef _LIGHTMANAGER_H_
 #include "sceneGraph/lightManager.h"
 #endif
+#ifndef _CONTAINERTREE_H_
+#include "sim/containerTree.h"
+#endif
 
 #ifndef _GAME_H_
 #include "game/game.h"
@@ -123,6 +126,19 @@ public:
     static const F32 csmTotalBinSize;
     static const U32 csmRefPoolBlockSize;
     static U32    smCurrSeqKey;
+    static U32    smBatchSeqKey;  ///< Like smCurrSeqKey, for the batch queries
+
+    /// The spatial structures the queries can run on.
+    enum Database
+    {
+        /// The 16x16 grid of bins which wraps every 1024 units, with
+        /// an overflow bin for objects that are too big for it.
+        BinDatabase = 0,
+
+        /// A ContainerTree.  Global bounds objects still go in the
+        /// overflow bin.
+        TreeDatabase,
+    };
 
 private:
     Link mStart, mEnd;
@@ -133,10 +149,32 @@ private:
     SceneObjectRef* mBinArray;
     SceneObjectRef  mOverflowBin;
 
+    Database        mDatabase;
+    ContainerTree   mTree;
+
+    /// The number of objects the queries have looked at, for
+    /// comparing the databases.
+    U32             mNumObjectTests;
+
+    void castRayBins(const Point3F& start, const Point3F& end, U32 mask, RayInfo* info, F32& currentT);
+    static void treeFindCallback(SceneObject*, void* key);
+    static F32  treeRayCallback(SceneObject*, void* key);
+    static void treeCandidateCallback(SceneObject*, void* key);
+
+    /// Collects the objects which may overlap any of the boxes, each once.
+    void gatherCandidates(const Box3F* boxes, U32 numBoxes, U32 mask, bool checkHidden, Vector<SceneObject*>& candidates);
+
 public:
     Container();
     ~Container();
 
+    /// Moves every object over to the database.
+    void setDatabase(Database database);
+    Database getDatabase() const { return mDatabase; }
+
+    U32  getNumObjectTests() const { return mNumObjectTests; }
+    void resetNumObjectTests() { mNumObjectTests = 0; }
+
     /// @name Basic database operations
     /// @{
 
@@ -156,6 +194,25 @@ public:
     bool collideBox(const Point3F& start, const Point3F& end, U32 mask, RayInfo* info);
     /// @}
 
+    /// @name Batch queries
+    ///
+    /// These walk the database once for the whole batch, so a bin or a tree
+    /// node is only visited once no matter how many queries cover it.  They
+    /// mark the objects they have seen with a key of their own and leave the
+    /// sequence key of the single queries alone, so they are safe to issue
+    /// from inside another query's callback.
+    ///
+    /// @{
+
+    /// Casts each ray from starts[i] to ends[i] and stores the closest hit in
+    /// infos[i].  hits[i] is set to whether the ray hit anything, infos[i] is
+    /// left alone when it didn't.  Returns the number of rays that hit.
+    U32  castRays(const Point3F* starts, const Point3F* ends, U32 numRays, U32 mask, RayInfo* infos, bool* hits);
+
+    /// Appends the objects overlapping boxes[i] to results[i].
+    void findObjectsBatch(const Box3F* boxes, U32 numBoxes, U32 mask, Vector<SceneObject*>* results);
+    /// @}
+
     /// @name Poly list
     /// @{
 
@@ -739,6 +796,9 @@ protected:
     SceneObjectRef* mZoneRefHead;
     SceneObjectRef* mBinRefHead;
 
+    /// The leaf of the object when its container is using the tree.
+    S32 mTreeNode;
+
     U32 mBinMinX;
     U32 mBinMaxX;
     U32 mBinMinY;
@@ -758,6 +818,7 @@ protected:
     /// @{
 
     U32  mContainerSeqKey;  ///< Container sequence key
+    U32  mContainerBatchKey;  ///< Sequence key of the batch queries
 
     /// Returns the container sequence key
     U32  getContainerSeqKey() const { return mContainerSeqKey; }
@@ -4,6 +4,7 @@
 //-----------------------------------------------------------------------------
 
 #include "ts/tsShapeInstance.h"
+#include "ts/tsPoseCache.h"
 
 //----------------------------------------------------------------------------------
 // some utility functions
@@ -39,7 +40,66 @@ void TSShapeInstance::clearDirty(U32 dirty)
 // Animate nodes
 //-------------------------------------------------------------------------------------
 
+bool TSShapeInstance::getPoseKey(S32 ss, TSPoseCache::Key& key)
+{
+    // only poses that depend on nothing but the threads can be shared
+    S32 numNodes = mShape->nodes.size();
+    if (inTransition() || mThreadList.size() > TSPoseCache::MaxThreads ||
+        mHandsOffNodes.testAll(numNodes) || mCallbackNodes.testAll(numNodes) ||
+        mDisableBlendNodes.testAll(numNodes) || mMaskRotationNodes.testAll(numNodes) ||
+        mMaskPosXNodes.testAll(numNodes) || mMaskPosYNodes.testAll(numNodes) || mMaskPosZNodes.testAll(numNodes))
+        return false;
+
+    key.subShape = ss;
+    key.numWords = 0;
+    key.words[key.numWords++] = mScaleCurrentlyAnimated;
+    for (S32 i = 0; i < mThreadList.size(); i++)
+    {
+        const TSThread* th = mThreadList[i];
+        U32 seq = U32(th->sequence - mShape->sequences.address());
+        U32 keyPos;
+        dMemcpy(&keyPos, &th->keyPos, sizeof(U32));
+
+        key.words[key.numWords++] = seq | (th->blendDisabled ? BIT(31) : 0);
+        key.words[key.numWords++] = th->keyNum1;
+        key.words[key.numWords++] = th->keyNum2;
+        key.words[key.numWords++] = keyPos;
+    }
+    key.computeHash();
+    return true;
+}
+
 void TSShapeInstance::animateNodes(S32 ss)
+{
+    S32 a = mShape->subShapeFirstNode[ss];
+    S32 numNodes = mShape->subShapeNumNodes[ss];
+
+    TSPoseCache::Key key;
+    if (!TSPoseCache::smEnabled || !numNodes || !getPoseKey(ss, key))
+    {
+        evaluateNodes(ss);
+        return;
+    }
+
+    // identical shapes playing the same keyframes end up in the same pose,
+    // so take it from the shape's cache if another instance got there first
+    if (!mShape->mPoseCache)
+        mShape->mPoseCache = new TSPoseCache;
+
+    const MatrixF* pose = mShape->mPoseCache->find(key);
+    if (pose)
+    {
+        dMemcpy(&mNodeTransforms[a], pose, numNodes * sizeof(MatrixF));
+        TSPoseCache::smHits++;
+        return;
+    }
+
+    evaluateNodes(ss);
+    mShape->mPoseCache->insert(key, &mNodeTransforms[a], numNodes);
+    TSPoseCache::smMisses++;
+}
+
+void TSShapeInstance::evaluateNodes(S32 ss)
 {
     if (!mShape->nodes.size())
         return;
@@ -879,11 +939,13 @@ void TSShapeInstance::animateNodeSubtrees(bool forceFull)
         // force transforms to animate
         setDirty(TransformDirty);
 
+    // evaluate rather than use the pose cache, since transitions read back
+    // the intermediate results in smNodeCurrentRotations etc.
     for (S32 i = 0; i < mShape->subShapeNumNodes.size(); i++)
     {
         if (mDirtyFlags[i] & TransformDirty)
         {
-            animateNodes(i);
+            evaluateNodes(i);
             mDirtyFlags[i] &= ~TransformDirty;
         }
     }
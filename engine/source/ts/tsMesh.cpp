@@ -24,6 +24,10 @@
 #include "game/game.h"
 #include "lightingSystem/sgLightingModel.h"
 
+#ifdef TORQUE_SKIN_SSE
+#include <xmmintrin.h>
+#endif
+
 // Not worth the effort, much less the effort to comment, but if the draw types
 // are consecutive use addition rather than a table to go from index to command value...
 /*
@@ -2341,6 +2345,199 @@ GFXVertexBufferHandle<MeshVertex>& TSSkinMesh::getVertexBuffer()
 Vector<MatrixF> gBoneTransforms;
 Vector<Point3F> gSkinVerts;
 Vector<Point3F> gSkinNorms;
+Vector<F32>     gSkinFrame;
+
+bool TSSkinMesh::smUseSIMD = true;
+
+void TSSkinMesh::initSkin()
+{
+    PROFILE_START(TSSkinMesh_initSkin);
+
+    S32 numVerts = initialVerts.size();
+
+    // we co-opt responsibility for decoding encoded normals from mesh
+    Vector<Point3F> decodedNorms;
+    const Point3F* normals = initialNorms.address();
+    if (encodedNorms.size())
+    {
+        decodedNorms.setSize(numVerts);
+        for (S32 i = 0; i < numVerts; i++)
+            decodedNorms[i] = decodeNormal(encodedNorms[i]);
+        normals = decodedNorms.address();
+    }
+
+    // work out texture space once in the bind pose and skin it along with
+    // the normals, rather than rebuilding it from the skinned verts each frame
+    MeshVertex* tempVerts = new MeshVertex[numVerts];
+    for (S32 i = 0; i < numVerts; i++)
+    {
+        tempVerts[i].point = initialVerts[i];
+        tempVerts[i].normal = normals[i];
+        tempVerts[i].texCoord = i < tverts.size() ? tverts[i] : Point2F(0.0f, 0.0f);
+        tempVerts[i].T.set(0.0f, 0.0f, 0.0f);
+        tempVerts[i].B.set(0.0f, 0.0f, 0.0f);
+    }
+    fillTextureSpaceInfo(tempVerts);
+
+    mBindFrame.setSize(numVerts * 16);
+    F32* bind = mBindFrame.address();
+    for (S32 i = 0; i < numVerts; i++, bind += 16)
+    {
+        const MeshVertex& v = tempVerts[i];
+        bind[0]  = v.point.x;  bind[1]  = v.point.y;  bind[2]  = v.point.z;  bind[3]  = 1.0f;
+        bind[4]  = v.normal.x; bind[5]  = v.normal.y; bind[6]  = v.normal.z; bind[7]  = 0.0f;
+        bind[8]  = v.T.x;      bind[9]  = v.T.y;      bind[10] = v.T.z;      bind[11] = 0.0f;
+        bind[12] = v.B.x;      bind[13] = v.B.y;      bind[14] = v.B.z;      bind[15] = 0.0f;
+    }
+    delete[] tempVerts;
+
+    // regroup the influences (sorted by vertex) by bone, so each bone
+    // transform only has to be loaded once
+    S32 numBones = nodeIndex.size();
+    mBoneStart.setSize(numBones + 1);
+    dMemset(mBoneStart.address(), 0, sizeof(S32) * mBoneStart.size());
+    for (S32 i = 0; i < boneIndex.size(); i++)
+        mBoneStart[boneIndex[i] + 1]++;
+    for (S32 i = 0; i < numBones; i++)
+        mBoneStart[i + 1] += mBoneStart[i];
+
+    Vector<S32> next;
+    next.set(mBoneStart.address(), numBones);
+    mBoneVertex.setSize(vertexIndex.size());
+    mBoneWeight.setSize(vertexIndex.size());
+    for (S32 i = 0; i < vertexIndex.size(); i++)
+    {
+        S32 j = next[boneIndex[i]]++;
+        mBoneVertex[j] = vertexIndex[i];
+        mBoneWeight[j] = weight[i];
+    }
+
+    PROFILE_END();
+}
+
+void TSSkinMesh::skinVertsC(const MatrixF* boneTransforms, F32* out)
+{
+    for (S32 b = 0; b < nodeIndex.size(); b++)
+    {
+        const F32* m = boneTransforms[b];
+        for (S32 i = mBoneStart[b]; i < mBoneStart[b + 1]; i++)
+        {
+            const F32 w = mBoneWeight[i];
+            const F32* src = &mBindFrame[mBoneVertex[i] * 16];
+            F32* dst = out + mBoneVertex[i] * 16;
+
+            // position, normal, tangent, binormal; w is 1 for the position
+            // and 0 for the rest, so one transform covers all four
+            for (U32 k = 0; k < 16; k += 4)
+            {
+                const F32 x = src[k], y = src[k + 1], z = src[k + 2], s = src[k + 3];
+                dst[k]     += (m[0] * x + m[1] * y + m[2]  * z + m[3]  * s) * w;
+                dst[k + 1] += (m[4] * x + m[5] * y + m[6]  * z + m[7]  * s) * w;
+                dst[k + 2] += (m[8] * x + m[9] * y + m[10] * z + m[11] * s) * w;
+            }
+        }
+    }
+}
+
+void TSSkinMesh::normalizeSkinC(F32* frame, U32 offset, F32 minLen2)
+{
+    S32 numVerts = initialVerts.size();
+    for (S32 i = 0; i < numVerts; i++)
+    {
+        F32* v = frame + i * 16 + offset;
+        F32 len2 = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+        if (len2 > minLen2)
+        {
+            F32 scale = 1.0f / mSqrt(len2);
+            v[0] *= scale;
+            v[1] *= scale;
+            v[2] *= scale;
+        }
+    }
+}
+
+#ifdef TORQUE_SKIN_SSE
+
+// The SSE kernels do the same multiplies and adds as the C ones, in the same
+// order, so both produce the same results.
+
+void TSSkinMesh::skinVertsSSE(const MatrixF* boneTransforms, F32* out)
+{
+    for (S32 b = 0; b < nodeIndex.size(); b++)
+    {
+        const F32* m = boneTransforms[b];
+        const __m128 c0 = _mm_setr_ps(m[0], m[4], m[8],  0.0f);
+        const __m128 c1 = _mm_setr_ps(m[1], m[5], m[9],  0.0f);
+        const __m128 c2 = _mm_setr_ps(m[2], m[6], m[10], 0.0f);
+        const __m128 c3 = _mm_setr_ps(m[3], m[7], m[11], 0.0f);
+
+        for (S32 i = mBoneStart[b]; i < mBoneStart[b + 1]; i++)
+        {
+            const __m128 w = _mm_set1_ps(mBoneWeight[i]);
+            const F32* src = &mBindFrame[mBoneVertex[i] * 16];
+            F32* dst = out + mBoneVertex[i] * 16;
+
+            for (U32 k = 0; k < 16; k += 4)
+            {
+                __m128 s = _mm_loadu_ps(src + k);
+                __m128 r = _mm_mul_ps(c0, _mm_shuffle_ps(s, s, _MM_SHUFFLE(0, 0, 0, 0)));
+                r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1))));
+                r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_shuffle_ps(s, s, _MM_SHUFFLE(2, 2, 2, 2))));
+                r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 3, 3))));
+                _mm_storeu_ps(dst + k, _mm_add_ps(_mm_loadu_ps(dst + k), _mm_mul_ps(r, w)));
+            }
+        }
+    }
+}
+
+void TSSkinMesh::normalizeSkinSSE(F32* frame, U32 offset, F32 minLen2)
+{
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minLen = _mm_set1_ps(minLen2);
+
+    // four vertices at a time, transposed so each lane is one vertex
+    S32 numVerts = initialVerts.size();
+    S32 i = 0;
+    for (; i + 4 <= numVerts; i += 4)
+    {
+        F32* v0 = frame + i * 16 + offset;
+        F32* v1 = v0 + 16;
+        F32* v2 = v0 + 32;
+        F32* v3 = v0 + 48;
+        __m128 r0 = _mm_loadu_ps(v0);
+        __m128 r1 = _mm_loadu_ps(v1);
+        __m128 r2 = _mm_loadu_ps(v2);
+        __m128 r3 = _mm_loadu_ps(v3);
+        __m128 x = r0, y = r1, z = r2, s = r3;
+        _MM_TRANSPOSE4_PS(x, y, z, s);
+
+        __m128 len2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+        __m128 mask = _mm_cmpgt_ps(len2, minLen);
+        __m128 scale = _mm_div_ps(one, _mm_sqrt_ps(len2));
+        scale = _mm_or_ps(_mm_and_ps(mask, scale), _mm_andnot_ps(mask, one));
+
+        // the w lanes are zero, so scaling them is harmless
+        _mm_storeu_ps(v0, _mm_mul_ps(r0, _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(0, 0, 0, 0))));
+        _mm_storeu_ps(v1, _mm_mul_ps(r1, _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(1, 1, 1, 1))));
+        _mm_storeu_ps(v2, _mm_mul_ps(r2, _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(2, 2, 2, 2))));
+        _mm_storeu_ps(v3, _mm_mul_ps(r3, _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(3, 3, 3, 3))));
+    }
+
+    for (; i < numVerts; i++)
+    {
+        F32* v = frame + i * 16 + offset;
+        F32 len2 = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+        if (len2 > minLen2)
+        {
+            F32 scale = 1.0f / mSqrt(len2);
+            v[0] *= scale;
+            v[1] *= scale;
+            v[2] *= scale;
+        }
+    }
+}
+
+#endif
 
 void TSSkinMesh::updateSkin()
 {
@@ -2351,33 +2548,23 @@ void TSSkinMesh::updateSkin()
 
     PROFILE_START(UpdateSkin);
 
+    if (mBoneStart.empty())
+        initSkin();
+
     // set arrays
+    S32 numVerts = initialVerts.size();
     gBoneTransforms.setSize(nodeIndex.size());
+    gSkinFrame.setSize(numVerts * 16);
 #if defined(TORQUE_MAX_LIB)
-    verts.setSize(initialVerts.size());
-    norms.setSize(initialVerts.size());
+    verts.setSize(numVerts);
+    norms.setSize(numVerts);
 #else
-    if (encodedNorms.size())
-    {
-        // we co-opt responsibility for updating encoded normals from mesh
-        gNormalStore.setSize(vertsPerFrame);
-        for (S32 i = 0; i < vertsPerFrame; i++)
-            gNormalStore[i] = decodeNormal(encodedNorms[i]);
-        initialNorms.set(gNormalStore.address(), vertsPerFrame);
-    }
-    gSkinVerts.setSize(initialVerts.size());
-    gSkinNorms.setSize(initialNorms.size());
+    gSkinVerts.setSize(numVerts);
+    gSkinNorms.setSize(numVerts);
     verts.set(gSkinVerts.address(), gSkinVerts.size());
     norms.set(gSkinNorms.address(), gSkinNorms.size());
 #endif
 
-    //if (!initialTangents.size())
-    //{
-    //    dMemcpy(verts.address(), initialVerts.address(), sizeof(Point3F) * verts.size());
-    //    dMemcpy(norms.address(), initialNorms.address(), sizeof(Point3F) * norms.size());
-    //    createTangents();
-    //}
-
     // set up bone transforms
     S32 i;
     for (i = 0; i < nodeIndex.size(); i++)
@@ -2386,56 +2573,74 @@ void TSSkinMesh::updateSkin()
         gBoneTransforms[i].mul(TSShapeInstance::ObjectInstance::smTransforms[node], initialTransforms[i]);
     }
 
-    // multiply verts and normals by boneTransforms
-    S32 prevIndex = -1;
-    for (i = 0; i < vertexIndex.size(); i++)
-    {
-        Point3F v0, n0, t0;
-        S32 vIndex = vertexIndex[i];
-        MatrixF& deltaTransform = gBoneTransforms[boneIndex[i]];
-        deltaTransform.mulP(initialVerts[vIndex], &v0);
-        deltaTransform.mulV(initialNorms[vIndex], &n0);
-        deltaTransform.mulV(initialTangents[vIndex], &t0);
-        v0 *= weight[i];
-        n0 *= weight[i];
-        t0 *= weight[i];
-        Point3F& v = verts[vIndex];
-        Point3F& n = norms[vIndex];
-        Point3F& t = (Point3F&)tangents[vIndex];
-        // this should be implemented as a series of conditional moves to avoid the branch
-        if (vIndex != prevIndex)
-        {
-            v.x = 0.0f;
-            v.y = 0.0f;
-            v.z = 0.0f;
-            n.x = 0.0f;
-            n.y = 0.0f;
-            n.z = 0.0f;
-            t.x = 0.0f;
-            t.y = 0.0f;
-            t.z = 0.0f;
-        }
-        v += v0;
-        n += n0;
-        t += t0;
-        prevIndex = vIndex;
+    // multiply verts, normals and texture space by boneTransforms, then
+    // renormalize.  gotta check the normal length since shared verts between
+    // meshes may result in an unused vert in the list...
+    F32* frame = gSkinFrame.address();
+    dMemset(frame, 0, sizeof(F32) * gSkinFrame.size());
+    const F32 minTangentLen2 = F32(POINT_EPSILON * POINT_EPSILON);
+#ifdef TORQUE_SKIN_SSE
+    if (smUseSIMD)
+    {
+        skinVertsSSE(gBoneTransforms.address(), frame);
+        normalizeSkinSSE(frame, 4, 0.01f);
+        normalizeSkinSSE(frame, 8, minTangentLen2);
+        normalizeSkinSSE(frame, 12, minTangentLen2);
     }
-
-    // normalize normals...
-    for (i = 0; i < norms.size(); i++)
+    else
+#endif
     {
-        // gotta do a check now since shared verts between meshes
-        // may result in an unused vert in the list...
-        Point3F& n = norms[i];
-        F32 len2 = mDot(n, n);
-        if (len2 > 0.01f)
-            norms[i] *= 1.0f / mSqrt(len2);
+        skinVertsC(gBoneTransforms.address(), frame);
+        normalizeSkinC(frame, 4, 0.01f);
+        normalizeSkinC(frame, 8, minTangentLen2);
+        normalizeSkinC(frame, 12, minTangentLen2);
+    }
 
-        // also normalize tangent matrix
-        ((Point3F&)tangents[i]).normalize();
+    for (i = 0; i < numVerts; i++, frame += 16)
+    {
+        verts[i].set(frame[0], frame[1], frame[2]);
+        norms[i].set(frame[4], frame[5], frame[6]);
     }
 
-    createVBIB();
+    PROFILE_END();
+}
+
+void TSSkinMesh::fillSkinVB(GFXVertexBufferHandle<MeshVertex>& vb)
+{
+    U32 numVerts = initialVerts.size();
+    if (!numVerts || gSkinFrame.size() != numVerts * 16 || !GFXDevice::devicePresent())
+        return;
+
+    PROFILE_START(TSSkinMesh_fillSkinVB);
+
+    // the buffer lives as long as the instance; only a change of detail
+    // level (and so vertex count) makes us reallocate it
+    if (vb.isNull() || vb->mNumVerts != numVerts)
+        vb.set(GFX, numVerts, GFXBufferTypeDynamic);
+
+    if (mPB.isNull())
+        createPB();
+
+    // dynamic locks discard the old contents, so every field gets written.
+    // build each vertex locally, since reading back from the buffer is slow
+    MeshVertex* vbVerts = vb.lock();
+    const F32* frame = gSkinFrame.address();
+    for (U32 i = 0; i < numVerts; i++, frame += 16)
+    {
+        MeshVertex v;
+        v.point.set(frame[0], frame[1], frame[2]);
+        v.normal.set(frame[4], frame[5], frame[6]);
+        v.texCoord = i < tverts.size() ? tverts[i] : Point2F(0.0f, 0.0f);
+        v.texCoord2 = v.texCoord;
+        v.T.set(frame[8], frame[9], frame[10]);
+        v.B.set(frame[12], frame[13], frame[14]);
+        mCross(v.T, v.B, &v.N);
+        if (mDot(v.N, v.normal) < 0.0f)
+            v.N = -v.N;
+
+        vbVerts[i] = v;
+    }
+    vb.unlock();
 
     PROFILE_END();
 }
@@ -2444,6 +2649,8 @@ void TSSkinMesh::render(S32 frame, S32 matFrame, TSMaterialList* materials)
 {
     // update verts and normals...
     updateSkin();
+    if (!smGlowPass && !smRefractPass)
+        fillSkinVB(getVertexBuffer());
 
     // render...
     Parent::render(frame, matFrame, materials);
@@ -3285,6 +3492,16 @@ void TSMesh::createVBIB()
 
     delete[] tempVerts;
 
+    createPB();
+
+    PROFILE_END();
+}
+
+void TSMesh::createPB()
+{
+    if (!GFXDevice::devicePresent())
+        return;
+
     // go through and create PrimitiveInfo array
     Vector <GFXPrimitive> piArray;
     for (S32 i = 0; i < primitives.size(); i++)
@@ -3325,15 +3542,14 @@ void TSMesh::createVBIB()
 
     U16* ibIndices;
     GFXPrimitive* piInput;
-    mPB.set(GFX, indices.size(), piArray.size(), mDynamic ? GFXBufferTypeVolatile : GFXBufferTypeStatic);
+    // indices never change, even for skins, so the buffer is built once
+    mPB.set(GFX, indices.size(), piArray.size(), GFXBufferTypeStatic);
     mPB.lock(&ibIndices, &piInput);
 
     dMemcpy(ibIndices, indices.address(), indices.size() * sizeof(U16));
     dMemcpy(piInput, piArray.address(), piArray.size() * sizeof(GFXPrimitive));
 
     mPB.unlock();
-
-    PROFILE_END();
 }
 
 
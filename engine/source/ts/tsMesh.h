@@ -27,6 +27,10 @@
 
 typedef GFXVertexPNTTBN MeshVertex;
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define TORQUE_SKIN_SSE
+#endif
+
 // when working with 3dsmax, we want some things to be vectors that otherwise
 // are pointers to non-resizeable blocks of memory
 #if defined(TORQUE_MAX_LIB)
@@ -246,6 +250,7 @@ public:
     virtual GFXVertexBufferHandle<MeshVertex>& getVertexBuffer() { return mVB; };
 
     void createVBIB();
+    void createPB();
     void createTextureSpaceMatrix(MeshVertex* v0, MeshVertex* v1, MeshVertex* v2);
     void fillTextureSpaceInfo(MeshVertex* vertArray);
 
@@ -335,9 +340,35 @@ public:
     Vector<Point3F> initialVerts;
     Vector<Point3F> initialNorms;
 
+    /// @name Skinning batches
+    /// Built from the vectors above by initSkin() the first time the mesh is
+    /// skinned; not persisted.
+    /// @{
+    Vector<S32> mBoneStart;  ///< first entry in mBoneVertex for each bone, plus one past the last
+    Vector<S32> mBoneVertex; ///< influences grouped by bone: vertex...
+    Vector<F32> mBoneWeight; ///< ...and weight
+    Vector<F32> mBindFrame;  ///< bind pose, 16 floats per vertex: position, normal, tangent, binormal
+    /// @}
+
+    void initSkin();
+    void skinVertsC(const MatrixF* boneTransforms, F32* out);
+    void normalizeSkinC(F32* frame, U32 offset, F32 minLen2);
+#ifdef TORQUE_SKIN_SSE
+    void skinVertsSSE(const MatrixF* boneTransforms, F32* out);
+    void normalizeSkinSSE(F32* frame, U32 offset, F32 minLen2);
+#endif
+
     /// set verts and normals...
     void updateSkin();
 
+    /// Copy the last updateSkin() result into vb, creating it (dynamic, one
+    /// vertex per mesh vertex) the first time round.
+    void fillSkinVB(GFXVertexBufferHandle<MeshVertex>& vb);
+
+    /// Lets the SIMD kernels be switched off at runtime, for comparing
+    /// against the scalar path.
+    static bool smUseSIMD;
+
     // overrides from TSMesh
     GFXVertexBufferHandle<MeshVertex>& getVertexBuffer();
 
@@ -0,0 +1,61 @@
+//-----------------------------------------------------------------------------
+// Torque Shader Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#include "ts/tsPoseCache.h"
+
+bool TSPoseCache::smEnabled = true;
+S32  TSPoseCache::smHits = 0;
+S32  TSPoseCache::smMisses = 0;
+
+//-------------------------------------------------------------------------------------
+
+void TSPoseCache::Key::computeHash()
+{
+    // FNV-1a over the key words
+    hash = 2166136261u ^ U32(subShape);
+    for (U32 i = 0; i < numWords; i++)
+        hash = (hash ^ words[i]) * 16777619u;
+}
+
+bool TSPoseCache::Key::operator==(const Key& other) const
+{
+    return hash == other.hash && subShape == other.subShape && numWords == other.numWords &&
+        dMemcmp(words, other.words, numWords * sizeof(U32)) == 0;
+}
+
+//-------------------------------------------------------------------------------------
+
+TSPoseCache::TSPoseCache()
+{
+    for (U32 i = 0; i < NumSlots; i++)
+        mSlots[i].valid = false;
+}
+
+const MatrixF* TSPoseCache::find(const Key& key) const
+{
+    const Entry& entry = mSlots[key.hash % NumSlots];
+    if (!entry.valid || !(entry.key == key))
+        return NULL;
+
+    return entry.transforms.address();
+}
+
+void TSPoseCache::insert(const Key& key, const MatrixF* transforms, U32 count)
+{
+    Entry& entry = mSlots[key.hash % NumSlots];
+    entry.valid = true;
+    entry.key = key;
+    entry.transforms.setSize(count);
+    dMemcpy(entry.transforms.address(), transforms, count * sizeof(MatrixF));
+}
+
+void TSPoseCache::clear()
+{
+    for (U32 i = 0; i < NumSlots; i++)
+    {
+        mSlots[i].valid = false;
+        mSlots[i].transforms.clear();
+    }
+}
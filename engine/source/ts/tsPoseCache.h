@@ -0,0 +1,82 @@
+//-----------------------------------------------------------------------------
+// Torque Shader Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+#ifndef _TSPOSECACHE_H_
+#define _TSPOSECACHE_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _MMATH_H_
+#include "math/mMath.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/tVector.h"
+#endif
+
+/// Node transforms of recently animated poses, shared by every instance of a
+/// shape.
+///
+/// A pose is keyed on the subshape and, for each thread in priority order,
+/// the sequence, keyframe pair, keyframe position and blend state.  Instances
+/// whose node transforms depend on anything else (hands off, callback,
+/// masked or blend disabled nodes, or transitions) don't use the cache.
+///
+/// The cache is direct mapped, so a busy shape just evicts older poses.
+///
+/// @see TSShapeInstance::animateNodes
+class TSPoseCache
+{
+public:
+    enum Constants
+    {
+        NumSlots = 64,
+        MaxThreads = 8,
+        WordsPerThread = 4,
+        MaxKeyWords = MaxThreads * WordsPerThread + 1 ///< plus one for instance-wide state
+    };
+
+    struct Key
+    {
+        U32 hash;
+        S32 subShape;
+        U32 numWords;
+        U32 words[MaxKeyWords];
+
+        /// Call once the words are filled in.
+        void computeHash();
+        bool operator==(const Key& other) const;
+    };
+
+private:
+    struct Entry
+    {
+        bool valid;
+        Key key;
+        Vector<MatrixF> transforms;
+    };
+
+    Entry mSlots[NumSlots];
+
+public:
+    /// @name Stats
+    /// @{
+    static bool smEnabled;
+    static S32 smHits;
+    static S32 smMisses;
+    /// @}
+
+    TSPoseCache();
+
+    /// Node transforms stored under key, or NULL.
+    const MatrixF* find(const Key& key) const;
+
+    /// Store count node transforms under key, replacing whatever shared its slot.
+    void insert(const Key& key, const MatrixF* transforms, U32 count);
+
+    void clear();
+};
+
+#endif // _TSPOSECACHE_H_
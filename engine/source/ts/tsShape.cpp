@@ -8,6 +8,7 @@
 #include "core/stringTable.h"
 #include "console/console.h"
 #include "ts/tsShapeInstance.h"
+#include "ts/tsPoseCache.h"
 #include "collision/convex.h"
 #include <string>
 #include "collada/colladaShapeLoader.h"
@@ -41,6 +42,7 @@ TSShape::TSShape()
 
     mVertexBuffer = (U32)-1;
     mCallbackKey = (U32)-1;
+    mPoseCache = NULL;
 
     VECTOR_SET_ASSOCIATION(sequences);
     VECTOR_SET_ASSOCIATION(billboardDetails);
@@ -115,6 +117,8 @@ TSShape::~TSShape()
 
 void TSShape::clearDynamicData()
 {
+    delete mPoseCache;
+    mPoseCache = NULL;
 }
 
 const char* TSShape::getName(S32 nameIndex) const
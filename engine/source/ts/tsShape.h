@@ -41,6 +41,7 @@
 
 class TSMaterialList;
 class TSLastDetail;
+class TSPoseCache;
 
 
 /// TSShape stores generic data for a 3space model.
@@ -373,6 +374,8 @@ public:
     Vector<S32> mPreviousMerge;
     S32 mMergeBufferSize;
 
+    TSPoseCache* mPoseCache;   ///< Created on first use by TSShapeInstance::animateNodes.
+
     // shape class has few methods --
     // just constructor/destructor, io, and lookup methods
 
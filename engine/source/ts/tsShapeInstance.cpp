@@ -15,6 +15,8 @@
 #include "materials/sceneData.h"
 #include "materials/matInstance.h"
 #include "sceneGraph/sceneGraph.h"
+#include "core/resManager.h"
+#include "core/crc.h"
 
 TSShapeInstance::RenderData   TSShapeInstance::smRenderData;
 MatrixF* TSShapeInstance::ObjectInstance::smTransforms = NULL;
@@ -139,6 +141,10 @@ void TSShapeInstance::init()
     Con::addVariable("$pref::TS::skipRenderDLs", TypeS32, &smNumSkipRenderDetails);
     Con::addVariable("$pref::TS::skipFirstFog", TypeBool, &smSkipFirstFog);
     Con::addVariable("$pref::TS::screenError", TypeF32, &smScreenError);
+    Con::addVariable("$TS::UseSIMDSkinning", TypeBool, &TSSkinMesh::smUseSIMD);
+    Con::addVariable("$TS::UsePoseCache", TypeBool, &TSPoseCache::smEnabled);
+    Con::addVariable("$TS::PoseCacheHits", TypeS32, &TSPoseCache::smHits);
+    Con::addVariable("$TS::PoseCacheMisses", TypeS32, &TSPoseCache::smMisses);
 }
 
 void TSShapeInstance::destroy()
@@ -2220,4 +2226,86 @@ void TSShapeInstance::prepCollision()
             mShape->meshes[i]->prepOpcodeCollision();
     }
     clearStatics();
-}
\ No newline at end of file
+}
+
+//-------------------------------------------------------------------------------------
+// Skinning benchmark
+//-------------------------------------------------------------------------------------
+
+ConsoleFunction(benchSkinning, const char*, 2, 3, "(string shapeFile, int iterations=100) "
+                "Skin every skin mesh in the highest detail of a shape's default pose iterations times, "
+                "filling a vertex buffer for each when a GFX device (the Null device will do) is present. "
+                "Returns \"nsPerVertex checksum\", or \"\" if the shape could not be loaded.")
+{
+    char fileName[1024];
+    Con::expandScriptFilename(fileName, sizeof(fileName), argv[1]);
+
+    Resource<TSShape> shape = ResourceManager->load(fileName);
+    if (!bool(shape) || !shape->details.size() || shape->details[0].subShapeNum < 0)
+    {
+        Con::errorf("benchSkinning: unable to load shape %s", fileName);
+        return "";
+    }
+
+    U32 iterations = argc > 2 ? dAtoi(argv[2]) : 100;
+    if (iterations == 0)
+        iterations = 1;
+
+    TSShapeInstance* shapeInst = new TSShapeInstance(shape, false);
+    shapeInst->animate();
+    shapeInst->setStatics(0);
+
+    S32 od = shape->details[0].objectDetailNum;
+    Vector<TSSkinMesh*> skins;
+    U32 numVerts = 0;
+    for (S32 i = 0; i < shapeInst->mMeshObjects.size(); i++)
+    {
+        TSMesh* mesh = shapeInst->mMeshObjects[i].getMesh(od);
+        if (mesh && mesh->getMeshType() == TSMesh::SkinMeshType)
+        {
+            skins.push_back((TSSkinMesh*)mesh);
+            numVerts += skins.last()->initialVerts.size();
+        }
+    }
+
+    GFXVertexBufferHandle<MeshVertex>* buffers = new GFXVertexBufferHandle<MeshVertex>[skins.size()];
+    bool fillVB = GFXDevice::devicePresent();
+    U32 checksum = 0;
+
+    U64 start = Platform::getPerformanceCounter();
+    PROFILE_START(TSShapeInstance_benchSkinning);
+
+    for (U32 i = 0; i < iterations; i++)
+    {
+        for (S32 j = 0; j < skins.size(); j++)
+        {
+            TSSkinMesh* skin = skins[j];
+            skin->updateSkin();
+            if (fillVB)
+                skin->fillSkinVB(buffers[j]);
+
+            // skins share their output arrays, so checksum each as we go
+            if (i == iterations - 1)
+            {
+                checksum = calculateCRC(skin->verts.address(), skin->verts.size() * sizeof(Point3F), checksum);
+                checksum = calculateCRC(skin->norms.address(), skin->norms.size() * sizeof(Point3F), checksum);
+            }
+        }
+    }
+
+    PROFILE_END();
+    U64 elapsed = Platform::getPerformanceCounter() - start;
+
+    shapeInst->clearStatics();
+    delete[] buffers;
+    delete shapeInst;
+
+    F64 nsPerVertex = numVerts ? F64(elapsed) * 1000000000.0 / (F64(Platform::getPerformanceFrequency()) * numVerts * iterations) : 0.0;
+
+    Con::printf("Skinning: %d meshes, %d verts x %d iterations, %.1f ns/vertex%s, checksum %08x",
+        skins.size(), numVerts, iterations, nsPerVertex, fillVB ? " (with vertex buffers)" : "", checksum);
+
+    char* ret = Con::getReturnBuffer(64);
+    dSprintf(ret, 64, "%.1f %08x", nsPerVertex, checksum);
+    return ret;
+}
@@ -15,6 +15,9 @@
 #ifndef _TSINTEGERSET_H_
 #include "ts/tsIntegerSet.h"
 #endif
+#ifndef _TSPOSECACHE_H_
+#include "ts/tsPoseCache.h"
+#endif
 #ifndef _CONSOLE_H_
 #include "console/console.h"
 #endif
@@ -578,6 +581,8 @@ public:
     void animate();
     void animate(S32 dl);
     void animateNodes(S32 ss);
+    void evaluateNodes(S32 ss);
+    bool getPoseKey(S32 ss, TSPoseCache::Key& key);
     void animateVisibility(S32 ss);
     void animateFrame(S32 ss);
     void animateMatFrame(S32 ss);
@@ -793,6 +798,8 @@ class TSThread
 
     bool blendDisabled;                ///< Blend with other sequences?
 
+    U32 subShapeMask;                  ///< Subshapes (of the first 32) with nodes the sequence animates
+
     /// if in transition...
     struct TransitionData
     {
@@ -824,6 +831,9 @@ class TSThread
 
     void getGround(F32 p, MatrixF* pMat);
 
+    /// work out subShapeMask for the current sequence
+    void updateSubShapeMask();
+
     /// @name Triggers
     /// Triggers are used to do something once a certain animation point has been reached.
     ///
@@ -154,6 +154,7 @@ void TSThread::setSequence(S32 seq, F32 toPos)
     priority = sequence->priority;
     pos = toPos;
     makePath = sequence->makePath();
+    updateSubShapeMask();
 
     // 1.0f doesn't exist on cyclic sequences
     if (pos > 0.9999f && sequence->isCyclic())
@@ -203,6 +204,7 @@ void TSThread::transitionToSequence(S32 seq, F32 toPos, F32 duration, bool conti
     priority = sequence->priority;
     pos = toPos;
     makePath = sequence->makePath();
+    updateSubShapeMask();
 
     // 1.0f doesn't exist on cyclic sequences
     if (pos > 0.9999f && sequence->isCyclic())
@@ -330,13 +332,10 @@ void TSThread::setTimeScale(F32 ts)
 
 void TSThread::advancePos(F32 delta)
 {
-    if (mFabs(delta) > 0.000001f)
-    {
-        // make dirty what this thread changes
-        U32 dirtyFlags = sequence->dirtyFlags | (transitionData.inTransition ? TSShapeInstance::TransformDirty : 0);
-        for (S32 i = 0; i < mShapeInstance->getShape()->subShapeFirstNode.size(); i++)
-            mShapeInstance->mDirtyFlags[i] |= dirtyFlags;
-    }
+    const TSSequence* oldSequence = sequence;
+    F32 oldPos = pos;
+    U32 oldSubShapeMask = subShapeMask;
+    bool wasInTransition = transitionData.inTransition;
 
     if (transitionData.inTransition)
     {
@@ -398,6 +397,44 @@ void TSThread::advancePos(F32 delta)
 
     // select keyframes
     selectKeyframes(pos, sequence, &keyNum1, &keyNum2, &keyPos);
+
+    // make dirty what this thread changes, unless it didn't actually move
+    // (paused, or clamped at the end of a one-shot sequence).  a change of
+    // sequence has already made everything dirty.
+    if (mFabs(delta) > 0.000001f && (wasInTransition || pos != oldPos) && sequence == oldSequence)
+    {
+        U32 dirtyFlags = oldSequence->dirtyFlags | (wasInTransition ? TSShapeInstance::TransformDirty : 0);
+        U32 otherFlags = wasInTransition ? dirtyFlags : dirtyFlags & ~TSShapeInstance::TransformDirty;
+        for (S32 i = 0; i < mShapeInstance->getShape()->subShapeFirstNode.size(); i++)
+        {
+            // node transforms only need redoing on subshapes the sequence animates
+            bool animated = i >= 32 || (oldSubShapeMask & (1 << i));
+            mShapeInstance->mDirtyFlags[i] |= animated ? dirtyFlags : otherFlags;
+        }
+    }
+}
+
+void TSThread::updateSubShapeMask()
+{
+    const TSShape* shape = mShapeInstance->mShape;
+
+    TSIntegerSet nodeMatters = sequence->rotationMatters;
+    nodeMatters.overlap(sequence->translationMatters);
+    nodeMatters.overlap(sequence->scaleMatters);
+
+    subShapeMask = 0;
+    S32 end = nodeMatters.end();
+    for (S32 i = nodeMatters.start(); i < end; nodeMatters.next(i))
+    {
+        for (S32 ss = 0; ss < shape->subShapeFirstNode.size() && ss < 32; ss++)
+        {
+            if (i >= shape->subShapeFirstNode[ss] && i < shape->subShapeFirstNode[ss] + shape->subShapeNumNodes[ss])
+            {
+                subShapeMask |= 1 << ss;
+                break;
+            }
+        }
+    }
 }
 
 void TSThread::advanceTime(F32 delta)
@@ -0,0 +1,17 @@
+//-----------------------------------------------------------------------------
+// Torque Shader Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+// Integer and float arithmetic on locals and a global.
+
+function ScriptBench::arithmetic(%ops)
+{
+   $ScriptBench::total = 0;
+   for (%i = 0; %i < %ops; %i++)
+   {
+      %x = (%i * 3 + 7) % 11;
+      $ScriptBench::total += %x * 0.5 - 1;
+   }
+   return $ScriptBench::total;
+}
@@ -0,0 +1,24 @@
+//-----------------------------------------------------------------------------
+// Torque Shader Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+// Reads and writes dynamic fields on an object, as trigger and pickup
+// callbacks do with their datablocks and clients.
+
+function ScriptBench::fieldAccess(%ops)
+{
+   %obj = new ScriptObject();
+   %obj.gemCount = 0;
+   %obj.points = 0;
+
+   for (%i = 0; %i < %ops; %i++)
+   {
+      %obj.gemCount = %obj.gemCount + 1;
+      %obj.points += %obj.gemCount;
+   }
+
+   %result = %obj.points;
+   %obj.delete();
+   return %result;
+}
@@ -0,0 +1,32 @@
+//-----------------------------------------------------------------------------
+// Torque Shader Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+// Calls a script method and its parent, as the per-class callbacks do.
+
+function ScriptBenchBase::addPoints(%this, %amount)
+{
+   return %amount + 1;
+}
+
+function ScriptBenchDerived::addPoints(%this, %amount)
+{
+   return Parent::addPoints(%this, %amount) * 2;
+}
+
+function ScriptBench::methodDispatch(%ops)
+{
+   %obj = new ScriptObject()
+   {
+      class = ScriptBenchDerived;
+      superClass = ScriptBenchBase;
+   };
+
+   %total = 0;
+   for (%i = 0; %i < %ops; %i++)
+      %total = %obj.addPoints(%i);
+
+   %obj.delete();
+   return %total;
+}
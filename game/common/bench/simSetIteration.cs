@@ -0,0 +1,27 @@
+//-----------------------------------------------------------------------------
+// Torque Shader Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+// Walks a SimSet, as scoring and gem bookkeeping walk ClientGroup and the
+// mission group.  Each object visited counts as one operation.
+
+function ScriptBench::simSetIteration(%ops)
+{
+   %set = new SimSet();
+   for (%i = 0; %i < 64; %i++)
+      %set.add(new ScriptObject() { value = %i; });
+
+   %total = 0;
+   for (%visited = 0; %visited < %ops; %visited += %count)
+   {
+      %count = %set.getCount();
+      for (%i = 0; %i < %count; %i++)
+         %total += %set.getObject(%i).value;
+   }
+
+   while (%set.getCount())
+      %set.getObject(0).delete();
+   %set.delete();
+   return %total;
+}
@@ -0,0 +1,16 @@
+//-----------------------------------------------------------------------------
+// Torque Shader Engine
+// Copyright (C) GarageGames.com, Inc.
+//-----------------------------------------------------------------------------
+
+// Builds short strings the way HUD and chat messages do.
+
+function ScriptBench::stringConcat(%ops)
+{
+   for (%i = 0; %i < %ops; %i++)
+   {
+      %str = "Gems: " @ %i @ "/" @ %ops;
+      %str = %str SPC "Time:" SPC %i * 10;
+   }
+   return %str;
+}
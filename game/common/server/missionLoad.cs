@@ -55,6 +55,37 @@ function loadMission( %missionName, %isFirstMission )
 
 //-----------------------------------------------------------------------------
 
+function prefetchMissionResources(%file)
+{
+   // "~/" in the mission refers to the mission's mod, not this one
+   %mod = getSubStr(%file, 0, strpos(%file, "/"));
+
+   %fo = new FileObject();
+   if (%fo.openForRead(%file))
+   {
+      while (!%fo.isEOF())
+      {
+         %line = trim(%fo.readLine());
+         if (strpos(%line, "interiorFile") != 0)
+            continue;
+
+         %start = strpos(%line, "\"") + 1;
+         %end = strpos(%line, "\"", %start);
+         if (%start == 0 || %end == -1)
+            continue;
+
+         %interior = getSubStr(%line, %start, %end - %start);
+         if (getSubStr(%interior, 0, 2) $= "~/")
+            %interior = %mod @ getSubStr(%interior, 1, 1024);
+         prefetchResources(%interior);
+      }
+      %fo.close();
+   }
+   %fo.delete();
+}
+
+//-----------------------------------------------------------------------------
+
 function loadMissionStage2() 
 {
    // Create the mission group off the ServerGroup
@@ -74,6 +105,10 @@ function loadMissionStage2()
    // to caching mission lighting.
    $missionCRC = getFileCRC( %file );
 
+   // Start reading the mission's interiors in the background while the
+   // mission itself is parsed.
+   prefetchMissionResources(%file);
+
    // Exec the mission, objects are added to the ServerGroup
    exec(%file);
    
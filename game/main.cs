@@ -189,6 +189,18 @@ for ($i = 1; $i < $Game::argc ; $i++)
          else
             error("Error: Missing Command Line argument. Usage: -jDebug <journal_name>");
 
+      //-------------------
+      case "-benchScripts":
+         $argUsed[$i]++;
+         $runScriptBench = true;
+         $scriptBenchPattern = "common/bench/*.cs";
+         if ($hasNextArg && getSubStr($nextArg, 0, 1) !$= "-")
+         {
+            $scriptBenchPattern = $nextArg;
+            $argUsed[$i+1]++;
+            $i++;
+         }
+
       //-------------------
       case "-help":
          $displayHelp = true;
@@ -319,6 +331,7 @@ function displayHelp() {
       "  -jSave  <file_name>    Record a journal\n"@
       "  -jPlay  <file_name>    Play back a journal\n"@
       "  -jDebug <file_name>    Play back a journal and issue an int3 at the end\n"@
+      "  -benchScripts [files]  Time the script benchmarks in common/bench and quit\n"@
       "  -help                  Display this help message\n"
    );
 }
@@ -351,6 +364,16 @@ if( !$logModeSpecified )
 // to the scripts and the resource engine.
 setModPaths($userMods);
 
+// Run the script benchmarks before any mod starts up, so they measure the
+// interpreter and nothing else.
+if ($runScriptBench)
+{
+   setModPaths("common");
+   benchScripts($scriptBenchPattern);
+   quit();
+   return;
+}
+
 function initVideo()
 {
    $pref::Video::displayDevice = "D3D";